@@ -68,10 +68,11 @@ Signal_source::Signal Signal_source_component::wait_for_signal()
 }
 
 
-Signal_source_component::Signal_source_component(Rpc_entrypoint *ep)
+Signal_source_component::Signal_source_component(Rpc_entrypoint  *ep,
+                                                 Allocator_guard &md_alloc)
 :
 	Signal_source_rpc_object(*cap_map()->insert(platform_specific()->cap_id_alloc()->alloc())),
-	_entrypoint(ep), _finalizer(*this),
+	_entrypoint(ep), _md_alloc(md_alloc), _finalizer(*this),
 	_finalizer_cap(_entrypoint->manage(&_finalizer))
 {
 	using namespace Fiasco;
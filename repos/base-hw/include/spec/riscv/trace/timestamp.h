@@ -0,0 +1,33 @@
+/*
+ * \brief  Trace timestamp
+ * \author Genode Labs
+ * \date   2016-07-15
+ *
+ * Reading of the cycle counter on RISC-V.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__SPEC__RISCV__TRACE__TIMESTAMP_H_
+#define _INCLUDE__SPEC__RISCV__TRACE__TIMESTAMP_H_
+
+#include <base/fixed_stdint.h>
+
+namespace Genode { namespace Trace {
+
+	typedef uint64_t Timestamp;
+
+	inline Timestamp timestamp()
+	{
+		uint64_t t;
+		asm volatile("rdcycle %0" : "=r"(t));
+		return t;
+	}
+} }
+
+#endif /* _INCLUDE__SPEC__RISCV__TRACE__TIMESTAMP_H_ */
@@ -0,0 +1,54 @@
+/*
+ * \brief  Access to the content of RAM dataspaces by core
+ * \author Genode Labs
+ * \date   2016-07-18
+ *
+ * On base-hw, core does not keep RAM dataspaces mapped. The core-local
+ * address of a dataspace is its physical address. Hence, the page is mapped
+ * temporarily.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _CORE__INCLUDE__CORE_RAM_ACCESS_H_
+#define _CORE__INCLUDE__CORE_RAM_ACCESS_H_
+
+/* core includes */
+#include <dataspace_component.h>
+#include <platform.h>
+#include <map_local.h>
+
+namespace Genode {
+
+	/**
+	 * Read machine word at 'offset' within RAM dataspace 'ds'
+	 *
+	 * \return  false if the dataspace content is not accessible by core
+	 */
+	inline bool read_ram_word(Dataspace_component &ds, addr_t offset,
+	                          addr_t &value)
+	{
+		addr_t const page_offset = offset & (get_page_size() - 1);
+		addr_t const phys        = ds.phys_addr() + offset - page_offset;
+
+		void *virt = nullptr;
+		if (!platform()->region_alloc()->alloc_aligned(get_page_size(), &virt,
+		                                               get_page_size_log2()).ok())
+			return false;
+
+		bool const mapped = map_local(phys, (addr_t)virt, 1);
+		if (mapped)
+			value = *(addr_t const *)((addr_t)virt + page_offset);
+
+		unmap_local((addr_t)virt, 1);
+		platform()->region_alloc()->free(virt, get_page_size());
+		return mapped;
+	}
+}
+
+#endif /* _CORE__INCLUDE__CORE_RAM_ACCESS_H_ */
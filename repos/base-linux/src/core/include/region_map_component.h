@@ -62,6 +62,8 @@ class Genode::Region_map_component : public Rpc_object<Region_map>,
 		Dataspace_capability dataspace() { return Dataspace_capability(); }
 
 		Rm_dataspace_component *dataspace_component() { return 0; }
+
+		bool read_word(addr_t, addr_t &) { return false; }
 };
 
 
@@ -0,0 +1,36 @@
+/*
+ * \brief  Asynchronous sending of RPC requests
+ * \author Genode Labs
+ * \date   2016-06-29
+ *
+ * On Linux, RPC requests are datagrams sent to the socket of the server
+ * entrypoint. A request that does not carry a reply channel is not answered
+ * by the server, which makes it an asynchronous message.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__INTERNAL__IPC_SEND_H_
+#define _INCLUDE__BASE__INTERNAL__IPC_SEND_H_
+
+/* Genode includes */
+#include <base/ipc.h>
+
+namespace Genode {
+
+	static inline bool ipc_send_supported() { return true; }
+
+	/**
+	 * Send request to RPC object without waiting for a reply
+	 *
+	 * The message must not carry capabilities.
+	 */
+	void ipc_send(Native_capability dst, Msgbuf_base &snd_msg);
+}
+
+#endif /* _INCLUDE__BASE__INTERNAL__IPC_SEND_H_ */
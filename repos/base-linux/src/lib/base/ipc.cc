@@ -23,6 +23,7 @@
 #include <base/internal/socket_descriptor_registry.h>
 #include <base/internal/native_thread.h>
 #include <base/internal/ipc_server.h>
+#include <base/internal/ipc_send.h>
 #include <base/internal/server_socket_pair.h>
 #include <base/internal/capability_space_tpl.h>
 
@@ -437,6 +438,28 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 }
 
 
+void Genode::ipc_send(Native_capability dst, Msgbuf_base &snd_msgbuf)
+{
+	Protocol_header &snd_header = snd_msgbuf.header<Protocol_header>();
+	snd_header.protocol_word = dst.local_name();
+	snd_header.num_caps      = 0;
+
+	/*
+	 * In contrast to 'ipc_call', no reply channel is marshalled, which tells
+	 * the server to not respond to the request.
+	 */
+	Message snd_msg(snd_header.msg_start(),
+	                sizeof(Protocol_header) + snd_msgbuf.data_size());
+
+	int const dst_socket = Capability_space::ipc_cap_data(dst).dst.socket;
+
+	int const send_ret = lx_sendmsg(dst_socket, snd_msg.msg(), 0);
+	if (send_ret < 0)
+		raw(Pid(), " lx_sendmsg to sd ", dst_socket,
+		    " failed with ", send_ret, " in ipc_send()");
+}
+
+
 /****************
  ** IPC server **
  ****************/
@@ -490,8 +513,13 @@ Genode::Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 			continue;
 		}
 
-		int           const reply_socket = msg.socket_at_index(0);
-		unsigned long const badge        = header.protocol_word;
+		unsigned long const badge = header.protocol_word;
+
+		/* asynchronous request sent via 'ipc_send', there is no one to reply to */
+		if (msg.num_sockets() == 0)
+			return Rpc_request(Native_capability(), badge);
+
+		int const reply_socket = msg.socket_at_index(0);
 
 		/* start at offset 1 to skip the reply channel */
 		extract_sds_from_message(1, msg, header, request_msg);
@@ -46,6 +46,11 @@ class Genode::Entrypoint : Genode::Noncopyable
 
 			void signal()
 			{
+				if (ep._signal_wakeup_enabled) {
+					ep._dispatch_pending_signals();
+					return;
+				}
+
 				try {
 					Signal sig = ep._sig_rec->pending_signal();
 					ep._dispatch_signal(sig);
@@ -53,6 +58,22 @@ class Genode::Entrypoint : Genode::Noncopyable
 			}
 		};
 
+		/**
+		 * Notification of the entrypoint about pending signals
+		 *
+		 * On platforms that support asynchronous IPC, the signal-handler
+		 * thread wakes up the entrypoint directly instead of going through
+		 * the signal-proxy thread, which would issue a synchronous RPC to the
+		 * entrypoint for each signal.
+		 */
+		struct Signal_wakeup : Signal_receiver::Wakeup
+		{
+			Entrypoint &ep;
+			Signal_wakeup(Entrypoint &ep) : ep(ep) { }
+
+			void wakeup() override { ep._wakeup_for_signals(); }
+		};
+
 		struct Signal_proxy_thread : Thread
 		{
 			enum { STACK_SIZE = 1024*sizeof(long) };
@@ -75,6 +96,16 @@ class Genode::Entrypoint : Genode::Noncopyable
 
 		Volatile_object<Signal_receiver> _sig_rec;
 
+		Signal_wakeup _signal_wakeup { *this };
+		bool          _signal_wakeup_enabled = false;
+
+		/* true while a wakeup message is on its way to the entrypoint */
+		Lock _wakeup_lock;
+		bool _wakeup_pending = false;
+
+		/* used for waking up the suspend-resume mechanism */
+		Semaphore _suspend_requested;
+
 		void (*_suspended_callback) () = nullptr;
 		void (*_resumed_callback)   () = nullptr;
 
@@ -82,15 +113,24 @@ class Genode::Entrypoint : Genode::Noncopyable
 		 * This signal handler is solely used to force an iteration of the
 		 * signal-dispatch loop. It is triggered by 'schedule_suspend' to
 		 * let the signal-dispatching thread execute the actual suspend-
-		 * resume mechanism.
+		 * resume mechanism. With direct signal delivery, the signal-dispatch
+		 * loop does not observe the signal and is woken up explicitly.
 		 */
-		void _handle_suspend() { }
+		void _handle_suspend()
+		{
+			if (_signal_wakeup_enabled)
+				_suspend_requested.up();
+		}
 		Lazy_volatile_object<Genode::Signal_handler<Entrypoint>> _suspend_dispatcher;
 
 		void _dispatch_signal(Signal &sig);
 
 		void _process_incoming_signals();
 
+		void _enable_signal_wakeup();
+		void _wakeup_for_signals();
+		void _dispatch_pending_signals();
+
 		Lazy_volatile_object<Signal_proxy_thread> _signal_proxy_thread;
 
 		friend class Startup;
@@ -103,7 +143,15 @@ class Genode::Entrypoint : Genode::Noncopyable
 
 	public:
 
-		Entrypoint(Env &env, size_t stack_size, char const *name);
+		/**
+		 * Constructor
+		 *
+		 * \param stack_size  stack size of the entrypoint thread
+		 * \param name        name of the entrypoint thread
+		 * \param location    CPU affinity of the entrypoint thread
+		 */
+		Entrypoint(Env &env, size_t stack_size, char const *name,
+		           Affinity::Location location = Affinity::Location());
 
 		/**
 		 * Associate RPC object with the entry point
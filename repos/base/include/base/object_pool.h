@@ -20,6 +20,8 @@
 #include <util/noncopyable.h>
 #include <base/capability.h>
 #include <base/weak_ptr.h>
+#include <base/trace/events.h>
+#include <cpu/atomic.h>
 
 namespace Genode { template <typename> class Object_pool; }
 
@@ -31,6 +33,13 @@ namespace Genode { template <typename> class Object_pool; }
  *
  * The local names of a capabilities are used to differentiate multiple server
  * objects managed by one and the same object pool.
+ *
+ * The entries are distributed among several shards according to their local
+ * names. Each shard is protected by a lock of its own so that concurrent
+ * lookups of different objects, e.g., by the threads of a multi-threaded
+ * server, do not serialize on a single lock. Lookups that find their shard
+ * in use by another thread are counted as contentions and reported via a
+ * 'Trace::Checkpoint' event.
  */
 template <typename OBJ_TYPE>
 class Genode::Object_pool
@@ -93,31 +102,102 @@ class Genode::Object_pool
 
 	private:
 
-		Avl_tree<Entry> _tree;
-		Lock            _lock;
+		enum { SHARDS = 8 };
+
+		struct Shard
+		{
+			Avl_tree<Entry> tree;
+			Lock            lock;
+			int volatile    users = 0;
+
+			Entry *find(unsigned long obj_id)
+			{
+				return tree.first() ? tree.first()->find_by_obj_id(obj_id)
+				                    : nullptr;
+			}
+		};
+
+		Shard _shards[SHARDS];
+
+		int volatile _contentions = 0;
+
+		static void _atomic_add(int volatile &value, int inc, int &old)
+		{
+			do { old = value; } while (!cmpxchg(&value, old, old + inc));
+		}
+
+		/**
+		 * Guard for the exclusive access to a shard
+		 */
+		class Shard_guard
+		{
+			private:
+
+				Shard &_shard;
+
+			public:
+
+				Shard_guard(Object_pool &pool, Shard &shard) : _shard(shard)
+				{
+					int users = 0;
+					_atomic_add(_shard.users, 1, users);
+
+					if (users > 0) {
+						int contentions = 0;
+						_atomic_add(pool._contentions, 1, contentions);
+						Trace::Checkpoint("object pool contention",
+						                  contentions + 1, &pool);
+					}
+
+					_shard.lock.lock();
+				}
+
+				~Shard_guard()
+				{
+					_shard.lock.unlock();
+
+					int users = 0;
+					_atomic_add(_shard.users, -1, users);
+				}
+		};
+
+		Shard &_shard(unsigned long obj_id) { return _shards[obj_id % SHARDS]; }
+
+		Shard &_shard(OBJ_TYPE *obj) { return _shard(obj->_obj_id()); }
 
 	protected:
 
 		bool empty()
 		{
-			Lock::Guard lock_guard(_lock);
-			return _tree.first() == nullptr;
+			for (unsigned i = 0; i < SHARDS; i++) {
+				Shard_guard guard(*this, _shards[i]);
+				if (_shards[i].tree.first())
+					return false;
+			}
+			return true;
 		}
 
 	public:
 
 		void insert(OBJ_TYPE *obj)
 		{
-			Lock::Guard lock_guard(_lock);
-			_tree.insert(obj);
+			Shard &shard = _shard(obj);
+			Shard_guard guard(*this, shard);
+			shard.tree.insert(obj);
 		}
 
 		void remove(OBJ_TYPE *obj)
 		{
-			Lock::Guard lock_guard(_lock);
-			_tree.remove(obj);
+			Shard &shard = _shard(obj);
+			Shard_guard guard(*this, shard);
+			shard.tree.remove(obj);
 		}
 
+		/**
+		 * Return number of lookups that found their shard in use
+		 */
+		unsigned long contentions() const { return _contentions; }
+
 		template <typename FUNC>
 		auto apply(unsigned long capid, FUNC func)
 		-> typename Trait::Functor<decltype(&FUNC::operator())>::Return_type
@@ -130,10 +210,10 @@ class Genode::Object_pool
 			Weak_ptr ptr;
 
 			{
-				Lock::Guard lock_guard(_lock);
+				Shard &shard = _shard(capid);
+				Shard_guard guard(*this, shard);
 
-				Entry * entry = _tree.first() ?
-					_tree.first()->find_by_obj_id(capid) : nullptr;
+				Entry * entry = shard.find(capid);
 
 				if (entry) ptr = entry->_lock.weak_ptr();
 			}
@@ -159,24 +239,29 @@ class Genode::Object_pool
 			using Weak_ptr   = Weak_ptr<typename Entry::Entry_lock>;
 			using Locked_ptr = Locked_ptr<typename Entry::Entry_lock>;
 
-			for (;;) {
-				OBJ_TYPE * obj;
+			for (unsigned i = 0; i < SHARDS; i++) {
 
-				{
-					Lock::Guard lock_guard(_lock);
+				Shard &shard = _shards[i];
 
-					if (!((obj = (OBJ_TYPE*) _tree.first()))) return;
+				for (;;) {
+					OBJ_TYPE * obj;
 
-					Weak_ptr ptr = obj->_lock.weak_ptr();
 					{
-						Locked_ptr lock_ptr(ptr);
-						if (!lock_ptr.valid()) return;
+						Shard_guard guard(*this, shard);
 
-						_tree.remove(obj);
+						if (!((obj = (OBJ_TYPE*) shard.tree.first()))) break;
+
+						Weak_ptr ptr = obj->_lock.weak_ptr();
+						{
+							Locked_ptr lock_ptr(ptr);
+							if (!lock_ptr.valid()) return;
+
+							shard.tree.remove(obj);
+						}
 					}
-				}
 
-				func(obj);
+					func(obj);
+				}
 			}
 		}
 };
@@ -16,6 +16,7 @@
 
 #include <base/ipc.h>
 #include <base/trace/events.h>
+#include <base/trace/rpc_stats.h>
 
 namespace Genode {
 
@@ -136,10 +137,18 @@ namespace Genode {
 			Trace::Rpc_call trace_event(IF::name(), call_buf);
 		}
 
+		bool            const stats = Trace::Rpc_stats::enabled();
+		Trace::Timestamp const start = stats ? Trace::timestamp() : 0;
+
 		/* perform RPC, unmarshal return value */
 		Rpc_exception_code const exception_code =
 			ipc_call(*this, call_buf, reply_buf, RECEIVE_CAPS);
 
+		if (stats)
+			Trace::Rpc_stats::record(Trace::Rpc_stats::Slot<RPC_INTERFACE, IF,
+			                         Trace::Rpc_stats::CLIENT>::function,
+			                         Trace::timestamp() - start);
+
 		if (exception_code.value == Rpc_exception_code::INVALID_OBJECT)
 			throw Ipc_error();
 
@@ -21,6 +21,7 @@
 #include <base/lock.h>
 #include <base/printf.h>
 #include <base/trace/events.h>
+#include <base/trace/rpc_stats.h>
 #include <cap_session/cap_session.h>
 
 namespace Genode {
@@ -136,11 +137,20 @@ class Genode::Rpc_dispatcher : public RPC_INTERFACE
 				 */
 				typedef typename This_rpc_function::Exceptions Exceptions;
 
+				bool            const stats = Trace::Rpc_stats::enabled();
+				Trace::Timestamp const start = stats ? Trace::timestamp() : 0;
+
 				typename This_rpc_function::Ret_type ret { };
 				Rpc_exception_code
 					exc(_do_serve(args, ret,
 					              Overload_selector<This_rpc_function, Exceptions>()));
 
+				if (stats)
+					Trace::Rpc_stats::record(Trace::Rpc_stats::Slot<RPC_INTERFACE,
+					                         This_rpc_function,
+					                         Trace::Rpc_stats::SERVER>::function,
+					                         Trace::timestamp() - start);
+
 				out.insert(ret);
 
 				{
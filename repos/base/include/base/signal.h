@@ -169,6 +169,19 @@ class Genode::Signal_transmitter
  */
 class Genode::Signal_receiver : Noncopyable
 {
+	public:
+
+		/**
+		 * Interface for notifying the thread that picks up the signals
+		 *
+		 * \noapi
+		 *
+		 * The 'wakeup' method is called whenever a context of the receiver
+		 * becomes pending. It is executed by the thread that submits the
+		 * signal locally and must not block.
+		 */
+		struct Wakeup { virtual void wakeup() = 0; };
+
 	private:
 
 		/**
@@ -189,6 +202,8 @@ class Genode::Signal_receiver : Noncopyable
 		Lock                                _contexts_lock;
 		List<List_element<Signal_context> > _contexts;
 
+		Wakeup *_wakeup = nullptr;
+
 		/**
 		 * Helper to dissolve given context
 		 *
@@ -272,6 +287,28 @@ class Genode::Signal_receiver : Noncopyable
 		 */
 		Signal pending_signal();
 
+		/**
+		 * Retrieve pending signal without blocking
+		 *
+		 * \noapi
+		 *
+		 * \throw   'Signal_not_pending' no pending signal found
+		 * \return  received signal
+		 *
+		 * In contrast to 'pending_signal', this method consumes the
+		 * availability count of the receiver like 'wait_for_signal' does.
+		 * It must only be called by the single thread that picks up the
+		 * signals of the receiver.
+		 */
+		Signal fetch_signal();
+
+		/**
+		 * Register wakeup notification for pending signals
+		 *
+		 * \noapi
+		 */
+		void wakeup(Wakeup *wakeup) { _wakeup = wakeup; }
+
 		/**
 		 * Locally submit signal to the receiver
 		 *
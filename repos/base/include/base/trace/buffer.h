@@ -2,10 +2,18 @@
  * \brief  Event tracing infrastructure
  * \author Norman Feske
  * \date   2013-08-09
+ *
+ * The trace buffer is a ring of variable-sized entries written by a single
+ * thread and read concurrently by a TRACE client. Each entry carries a
+ * timestamp and a sequence number. Before the writer overwrites entries,
+ * it marks them as lost by advancing the 'lost' sequence number. A reader
+ * keeps its position in a 'Cursor' and re-validates each entry after
+ * copying it. Thereby, the reader never returns an entry that was
+ * overwritten while being read and learns how many entries it missed.
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2016 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -15,8 +23,9 @@
 #define _INCLUDE__BASE__TRACE__BUFFER_H_
 
 #include <base/stdint.h>
-#include <base/thread.h>
-#include <cpu_session/cpu_session.h>
+#include <cpu/memory_barrier.h>
+#include <trace/timestamp.h>
+#include <util/string.h>
 
 namespace Genode { namespace Trace { class Buffer; } }
 
@@ -26,21 +35,73 @@ namespace Genode { namespace Trace { class Buffer; } }
  */
 class Genode::Trace::Buffer
 {
+	public:
+
+		typedef unsigned long Seq;
+
 	private:
 
+		enum { ALIGN = 8 };
+
 		unsigned volatile _head_offset;  /* in bytes, relative to 'entries' */
 		unsigned volatile _size;         /* in bytes */
 		unsigned volatile _wrapped;      /* count of buffer wraps */
 
+		/* offset of the oldest entry not yet overwritten */
+		unsigned volatile _tail_offset;
+
+		/* sequence number of the next entry */
+		Seq volatile _next_seq;
+
+		/* highest sequence number of the overwritten entries */
+		Seq volatile _lost_seq;
+
 		struct _Entry
 		{
-			size_t len;
-			char   data[0];
+			uint64_t timestamp;
+			Seq      seq;
+			size_t   len;  /* 0 marks the wrap-around of the buffer */
+			char     data[0];
 		};
 
 		_Entry _entries[0];
 
-		_Entry *_head_entry() { return (_Entry *)((addr_t)_entries + _head_offset); }
+		_Entry *_entry(size_t offset) const {
+			return (_Entry *)((addr_t)_entries + offset); }
+
+		_Entry *_head_entry() { return _entry(_head_offset); }
+
+		static size_t _entry_size(size_t len) {
+			return (sizeof(_Entry) + len + ALIGN - 1) & ~(size_t)(ALIGN - 1); }
+
+		bool _header_fits(size_t offset) const {
+			return offset + sizeof(_Entry) <= _size; }
+
+		/**
+		 * Mark entries overlapping the range [from, to) as lost
+		 */
+		void _overwrite(size_t from, size_t to)
+		{
+			while (_lost_seq + 1 < _next_seq) {
+
+				_Entry const * const e = _entry(_tail_offset);
+
+				/* skip wrap-around marker or unused end of buffer */
+				if (!_header_fits(_tail_offset) || e->len == 0) {
+					if (_tail_offset == 0)
+						return;
+					_tail_offset = 0;
+					continue;
+				}
+
+				if (_tail_offset < from || _tail_offset >= to)
+					return;
+
+				_lost_seq = e->seq;
+				memory_barrier();
+				_tail_offset += _entry_size(e->len);
+			}
+		}
 
 		void _buffer_wrapped()
 		{
@@ -62,25 +123,40 @@ class Genode::Trace::Buffer
 		void init(size_t size)
 		{
 			_head_offset = 0;
+			_tail_offset = 0;
+			_next_seq    = 1;
+			_lost_seq    = 0;
 
 			/* compute number of bytes available for tracing data */
 			size_t const header_size = (addr_t)&_entries - (addr_t)this;
 
-			_size = size - header_size;
+			_size = (size - header_size) & ~(size_t)(ALIGN - 1);
 
 			_wrapped = 0;
 		}
 
 		char *reserve(size_t len)
 		{
-			if (_head_offset + sizeof(_Entry) + len <= _size)
-				return _head_entry()->data;
+			size_t const size = _entry_size(len);
+
+			if (_head_offset + size > _size) {
+
+				/*
+				 * The remainder of the buffer stays unused. Discard the
+				 * entries located there and mark the last entry with len 0.
+				 */
+				_overwrite(_head_offset, _size);
 
-			/* mark last entry with len 0 and wrap */
-			if (_head_offset + sizeof(_Entry) <= _size)
-				_head_entry()->len = 0;
+				if (_header_fits(_head_offset)) {
+					_head_entry()->len = 0;
+					_head_entry()->seq = _next_seq;
+				}
 
-			_buffer_wrapped();
+				_buffer_wrapped();
+			}
+
+			_overwrite(_head_offset, _head_offset + size);
+			memory_barrier();
 
 			return _head_entry()->data;
 		}
@@ -91,10 +167,22 @@ class Genode::Trace::Buffer
 			if (len == 0)
 				return;
 
-			_head_entry()->len = len;
+			_Entry * const e = _head_entry();
+
+			/* the entry becomes the oldest one if the buffer is empty */
+			if (_lost_seq + 1 == _next_seq)
+				_tail_offset = _head_offset;
+
+			e->timestamp = Trace::timestamp();
+			e->len       = len;
+			e->seq       = _next_seq;
+
+			/* publish entry */
+			memory_barrier();
+			_next_seq = _next_seq + 1;
 
 			/* advance head offset, wrap when reaching buffer boundary */
-			_head_offset += sizeof(_Entry) + len;
+			_head_offset += _entry_size(len);
 			if (_head_offset == _size)
 				_buffer_wrapped();
 		}
@@ -106,46 +194,160 @@ class Genode::Trace::Buffer
 		 ** Functions called from the TRACE client **
 		 ********************************************/
 
-		class Entry
+		/**
+		 * Position of a reader within the buffer
+		 */
+		struct Cursor
 		{
-			private:
-
-				_Entry const *_entry;
+			enum { INVALID_OFFSET = ~0UL };
 
-				friend class Buffer;
-
-				Entry(_Entry const *entry) : _entry(entry) { }
-
-			public:
-
-				size_t      length() const { return _entry->len; }
-				char const *data()   const { return _entry->data; }
-				bool        last()   const { return _entry == 0; }
-
-				/*
-				 * \deprecated use 'last' instead
-				 */
-				bool is_last() const { return last(); }
+			unsigned long offset = INVALID_OFFSET;
+			Seq           seq    = 1;  /* sequence number of next entry */
+			Seq           lost   = 0;  /* number of entries missed so far */
 		};
 
-		Entry first() const
+		/**
+		 * Meta data of an entry returned by 'read'
+		 */
+		struct Entry_info
 		{
-			return _entries->len ? Entry(_entries) : Entry(0);
-		}
+			uint64_t timestamp;
+			Seq      seq;
+			size_t   length;  /* length of the entry, may exceed the
+			                     length of the copied data */
+		};
 
-		Entry next(Entry entry) const
-		{
-			if (entry.last())
-				return Entry(0);
+	private:
 
-			if (entry.length() == 0)
-				return Entry(0);
+		/**
+		 * Position cursor at the oldest entry not yet overwritten
+		 *
+		 * \return false if the buffer holds no entries
+		 */
+		bool _resync(Cursor &cursor) const
+		{
+			for (;;) {
+				Seq const lost = _lost_seq;
+				memory_barrier();
+				unsigned long offset = _tail_offset;
+				Seq const next = _next_seq;
+				memory_barrier();
+
+				/* entries discarded without being read */
+				if (cursor.seq <= lost) {
+					cursor.lost += lost + 1 - cursor.seq;
+					cursor.seq   = lost + 1;
+				}
+
+				if (lost + 1 >= next) {
+					cursor.offset = Cursor::INVALID_OFFSET;
+					return false;
+				}
+
+				if (!_header_fits(offset) || _entry(offset)->len == 0)
+					offset = 0;
+
+				/* the writer updated the tail meanwhile, retry */
+				if (_entry(offset)->seq != lost + 1 || _lost_seq != lost)
+					continue;
+
+				/* skip entries that the reader consumed already */
+				if (cursor.seq > lost + 1) {
+					cursor.offset = Cursor::INVALID_OFFSET;
+					for (Seq seq = lost + 1; seq < cursor.seq; seq++) {
+						if (!_header_fits(offset) || _entry(offset)->len == 0)
+							offset = 0;
+						offset += _entry_size(_entry(offset)->len);
+						if (offset >= _size)
+							offset = 0;
+					}
+					if (_lost_seq != lost)
+						continue;
+				}
+
+				cursor.offset = offset;
+				return true;
+			}
+		}
 
-			addr_t const offset = (addr_t)entry._entry - (addr_t)_entries;
-			if (offset + entry.length() + sizeof(_Entry) > _size)
-				return Entry(0);
+	public:
 
-			return Entry((_Entry const *)((addr_t)entry.data() + entry.length()));
+		/**
+		 * Read entry at cursor and advance the cursor
+		 *
+		 * \param info  meta data of the returned entry
+		 * \param dst   destination buffer for the entry data, the data is
+		 *              truncated to 'dst_len'
+		 *
+		 * \return  true if an entry was returned, false if no new entry is
+		 *          available
+		 *
+		 * Entries that were overwritten before being read are skipped and
+		 * accounted in 'cursor.lost'.
+		 */
+		bool read(Cursor &cursor, Entry_info &info, char *dst, size_t dst_len) const
+		{
+			for (;;) {
+
+				Seq const next = _next_seq;
+				memory_barrier();
+
+				/* buffer was re-initialized by the writer */
+				if (cursor.seq > next) {
+					cursor.seq    = 1;
+					cursor.offset = Cursor::INVALID_OFFSET;
+				}
+
+				if (cursor.seq >= next && cursor.offset != Cursor::INVALID_OFFSET)
+					return false;
+
+				if (cursor.offset == Cursor::INVALID_OFFSET || cursor.seq <= _lost_seq) {
+					if (!_resync(cursor))
+						return false;
+					continue;
+				}
+
+				if (!_header_fits(cursor.offset)) {
+					cursor.offset = 0;
+					continue;
+				}
+
+				_Entry const * const e = _entry(cursor.offset);
+
+				Seq    const seq       = e->seq;
+				size_t const len       = e->len;
+				uint64_t const timestamp = e->timestamp;
+				memory_barrier();
+
+				if (seq != cursor.seq || cursor.offset + _entry_size(len) > _size) {
+					cursor.offset = Cursor::INVALID_OFFSET;
+					continue;
+				}
+
+				/* wrap-around marker */
+				if (len == 0) {
+					cursor.offset = 0;
+					continue;
+				}
+
+				memcpy(dst, e->data, min(len, dst_len));
+				memory_barrier();
+
+				/* entry got overwritten while copying */
+				if (cursor.seq <= _lost_seq)
+					continue;
+
+				info.timestamp = timestamp;
+				info.seq       = seq;
+				info.length    = len;
+
+				cursor.seq++;
+				cursor.offset += _entry_size(len);
+				if (cursor.offset >= _size)
+					cursor.offset = 0;
+
+				return true;
+			}
 		}
 };
 
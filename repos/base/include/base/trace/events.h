@@ -25,6 +25,7 @@ namespace Genode { namespace Trace {
 	struct Rpc_reply;
 	struct Signal_submit;
 	struct Signal_received;
+	struct Checkpoint;
 } }
 
 
@@ -121,4 +122,25 @@ struct Genode::Trace::Signal_received
 };
 
 
+/**
+ * Event for reporting a named value, e.g., a statistics counter
+ */
+struct Genode::Trace::Checkpoint
+{
+	char const * const name;
+	unsigned long const data;
+	void const * const addr;
+
+	Checkpoint(char const *name, unsigned long data, void const *addr)
+	:
+		name(name), data(data), addr(addr)
+	{
+		Thread::trace(this);
+	}
+
+	size_t generate(Policy_module &policy, char *dst) const {
+		return policy.checkpoint(dst, name, data, addr); }
+};
+
+
 #endif /* _INCLUDE__BASE__TRACE__EVENTS_H_ */
@@ -0,0 +1,148 @@
+/*
+ * \brief  Aggregated RPC statistics
+ * \author Genode Labs
+ * \date   2016-07-20
+ *
+ * When enabled, each RPC performed or served by the component is accounted
+ * to its RPC function. For each function, the number of calls and a
+ * histogram of latencies are recorded. On the client side, the latency is
+ * the duration of the whole call. On the server side, it is the time
+ * spent in the RPC function. Latencies are measured in units of
+ * 'Trace::timestamp' and accounted to bucket n of the histogram if they
+ * lie within [2^n, 2^(n+1)). In contrast to tracing, the statistics do
+ * not depend on a TRACE session and occupy only a few bytes per RPC
+ * function. On platforms without user-accessible timestamps (ARM without
+ * the 'perf_counter' spec), all latencies are accounted to bucket 0 and
+ * only the call counts are meaningful.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__TRACE__RPC_STATS_H_
+#define _INCLUDE__BASE__TRACE__RPC_STATS_H_
+
+#include <cpu/atomic.h>
+#include <trace/timestamp.h>
+#include <util/meta.h>
+#include <util/string.h>
+
+namespace Genode { namespace Trace { class Rpc_stats; } }
+
+
+class Genode::Trace::Rpc_stats
+{
+	public:
+
+		enum Side { CLIENT, SERVER };
+
+		enum { BUCKETS = 32 };
+
+		/**
+		 * Statistics of one RPC function as seen from one side
+		 *
+		 * The objects are statically allocated and constant-initialized.
+		 * They are registered on their first use.
+		 */
+		struct Function
+		{
+			char const *(*interface_info)();
+			char const *(*function_name)();
+			unsigned     opcode;
+			Side         side;
+
+			int      volatile registered;
+			Function         *next;
+
+			unsigned volatile calls;
+			unsigned volatile histogram[BUCKETS];
+
+			/**
+			 * Return name of the RPC interface
+			 */
+			String<128> interface_name() const;
+		};
+
+		/**
+		 * Statistics of the RPC function 'FUNC' of interface 'IF'
+		 */
+		template <typename IF, typename FUNC, Side SIDE>
+		struct Slot
+		{
+			/*
+			 * The compiler-generated function signature contains the
+			 * interface type, which is extracted by 'interface_name'.
+			 */
+			static char const *info() { return __PRETTY_FUNCTION__; }
+
+			static Function function;
+		};
+
+	private:
+
+		static bool volatile _enabled;
+
+		static void _register(Function &);
+
+		static Function const *_first();
+
+		static void _inc(unsigned volatile &counter)
+		{
+			int old;
+			do { old = counter; }
+			while (!cmpxchg((int volatile *)&counter, old, old + 1));
+		}
+
+		static unsigned _bucket(Timestamp latency)
+		{
+			unsigned n = 0;
+			for (; latency > 1 && n < BUCKETS - 1; latency >>= 1)
+				n++;
+			return n;
+		}
+
+	public:
+
+		/**
+		 * Enable or disable the recording of RPC statistics
+		 *
+		 * Statistics are disabled by default.
+		 */
+		static void enable(bool enable) { _enabled = enable; }
+
+		static bool enabled() { return _enabled; }
+
+		static void record(Function &function, Timestamp latency)
+		{
+			if (!function.registered)
+				_register(function);
+
+			_inc(function.calls);
+			_inc(function.histogram[_bucket(latency)]);
+		}
+
+		/**
+		 * Apply functor to the statistics of each RPC function used so far
+		 */
+		template <typename FN>
+		static void for_each(FN const &fn)
+		{
+			for (Function const *f = _first(); f; f = f->next)
+				fn(*f);
+		}
+};
+
+
+template <typename IF, typename FUNC, Genode::Trace::Rpc_stats::Side SIDE>
+Genode::Trace::Rpc_stats::Function Genode::Trace::Rpc_stats::Slot<IF, FUNC, SIDE>::function =
+{
+	&Slot::info, &FUNC::name,
+	Genode::Meta::Index_of<typename IF::Rpc_functions, FUNC>::Value, SIDE,
+	0, nullptr, 0, { }
+};
+
+#endif /* _INCLUDE__BASE__TRACE__RPC_STATS_H_ */
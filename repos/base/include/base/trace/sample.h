@@ -0,0 +1,47 @@
+/*
+ * \brief  Execution sample of a traced thread
+ * \author Genode Labs
+ * \date   2016-07-18
+ *
+ * Core records samples into the sample buffer of each thread for which
+ * sampling is enabled via the TRACE session. The buffer is a
+ * 'Trace::Buffer' where each entry contains one 'Sample'.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__TRACE__SAMPLE_H_
+#define _INCLUDE__BASE__TRACE__SAMPLE_H_
+
+#include <base/fixed_stdint.h>
+#include <base/stdint.h>
+
+namespace Genode { namespace Trace { struct Sample; } }
+
+
+struct Genode::Trace::Sample
+{
+	enum { MAX_DEPTH = 32 };
+
+	uint32_t depth    = 0;  /* number of valid entries of 'ip' */
+	uint32_t reserved = 0;
+
+	/*
+	 * The first entry is the instruction pointer of the thread, the
+	 * following entries are the return addresses found by walking the
+	 * frame-pointer chain, innermost first.
+	 */
+	uint64_t ip[MAX_DEPTH];
+
+	/**
+	 * Size of the sample as stored in the sample buffer
+	 */
+	size_t size() const { return 2*sizeof(uint32_t) + depth*sizeof(uint64_t); }
+};
+
+#endif /* _INCLUDE__BASE__TRACE__SAMPLE_H_ */
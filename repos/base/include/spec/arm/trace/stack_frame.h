@@ -0,0 +1,38 @@
+/*
+ * \brief  Layout of stack frames for walking the frame-pointer chain
+ * \author Genode Labs
+ * \date   2016-07-18
+ *
+ * In ARM mode, GCC pushes the frame pointer 'r11' and the link register and
+ * lets the frame pointer point to the saved link register.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__SPEC__ARM__TRACE__STACK_FRAME_H_
+#define _INCLUDE__SPEC__ARM__TRACE__STACK_FRAME_H_
+
+#include <cpu/cpu_state.h>
+
+namespace Genode { namespace Trace {
+
+	/**
+	 * Return frame pointer of the given CPU state
+	 */
+	inline addr_t frame_pointer(Cpu_state const &state) { return state.r11; }
+
+	enum {
+		/* location of the return address relative to the frame pointer */
+		FRAME_RETURN_ADDRESS_OFFSET = 0,
+
+		/* location of the caller's frame pointer */
+		FRAME_POINTER_OFFSET = -4,
+	};
+} }
+
+#endif /* _INCLUDE__SPEC__ARM__TRACE__STACK_FRAME_H_ */
@@ -22,11 +22,21 @@ namespace Genode { namespace Trace {
 
 	typedef uint32_t Timestamp;
 
+	/*
+	 * Reading the cycle counter in user mode raises an undefined-instruction
+	 * exception unless the kernel grants access to it. This is the case on
+	 * base-hw with the 'perf_counter' spec only. On all other ARM
+	 * platforms, timestamps are not available and read as 0.
+	 */
 	inline Timestamp timestamp()
 	{
+#ifdef GENODE_PERF_COUNTER
 		uint32_t t;
 		asm volatile("mrc p15, 0, %0, c15, c12, 1" : "=r"(t));
 		return t;
+#else
+		return 0;
+#endif
 	}
 } }
 
@@ -85,6 +85,15 @@ struct Genode::Trace::Session_client : Genode::Rpc_client<Genode::Trace::Session
 		void trace(Subject_id s, Policy_id p, size_t buffer_size) override {
 			call<Rpc_trace>(s, p, buffer_size); }
 
+		void sample(Subject_id s, size_t buffer_size, unsigned depth) override {
+			call<Rpc_sample>(s, buffer_size, depth); }
+
+		size_t take_samples() override {
+			return call<Rpc_take_samples>(); }
+
+		Dataspace_capability sample_buffer(Subject_id subject) override {
+			return call<Rpc_sample_buffer>(subject); }
+
 		void rule(Session_label const &label, Thread_name const &thread,
 		          Policy_id policy, size_t buffer_size) override {
 			call<Rpc_rule>(label, thread, policy, buffer_size); }
@@ -56,6 +56,41 @@ struct Genode::Trace::Session : Genode::Session
 	 */
 	virtual void trace(Subject_id, Policy_id, size_t buffer_size) = 0;
 
+	/**
+	 * Start sampling the execution state of a subject
+	 *
+	 * \param buffer_size  size of the sample buffer
+	 * \param depth        maximum number of recorded return addresses,
+	 *                     including the instruction pointer
+	 *
+	 * Samples are recorded by 'take_samples' into a 'Trace::Buffer' that
+	 * is obtained via 'sample_buffer'. Each buffer entry contains a
+	 * 'Trace::Sample'.
+	 *
+	 * \throw Out_of_metadata
+	 * \throw Already_traced
+	 * \throw Source_is_dead
+	 * \throw Traced_by_other_session
+	 */
+	virtual void sample(Subject_id, size_t buffer_size, unsigned depth) = 0;
+
+	/**
+	 * Record one sample of each subject with sampling enabled
+	 *
+	 * The client calls this function periodically, which determines the
+	 * sampling rate.
+	 *
+	 * \return number of recorded samples
+	 */
+	virtual size_t take_samples() = 0;
+
+	/**
+	 * Obtain sample buffer of given subject
+	 *
+	 * \throw Nonexistent_subject
+	 */
+	virtual Dataspace_capability sample_buffer(Subject_id) = 0;
+
 	/**
 	 * Install a matching rule for automatically tracing new threads
 	 */
@@ -122,6 +157,14 @@ struct Genode::Trace::Session : Genode::Session
 	                                  Source_is_dead, Nonexistent_policy,
 	                                  Traced_by_other_session),
 	                 Subject_id, Policy_id, size_t);
+	GENODE_RPC_THROW(Rpc_sample, void, sample,
+	                 GENODE_TYPE_LIST(Out_of_metadata, Already_traced,
+	                                  Source_is_dead, Traced_by_other_session,
+	                                  Nonexistent_subject),
+	                 Subject_id, size_t, unsigned);
+	GENODE_RPC(Rpc_take_samples, size_t, take_samples);
+	GENODE_RPC_THROW(Rpc_sample_buffer, Dataspace_capability, sample_buffer,
+	                 GENODE_TYPE_LIST(Nonexistent_subject), Subject_id);
 	GENODE_RPC_THROW(Rpc_rule, void, rule,
 	                 GENODE_TYPE_LIST(Out_of_metadata),
 	                 Session_label const &, Thread_name const &,
@@ -142,9 +185,10 @@ struct Genode::Trace::Session : Genode::Session
 	                 GENODE_TYPE_LIST(Nonexistent_subject), Subject_id);
 
 	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_alloc_policy, Rpc_policy,
-	                     Rpc_unload_policy, Rpc_trace, Rpc_rule, Rpc_pause,
-	                     Rpc_resume, Rpc_subjects, Rpc_subject_info, Rpc_buffer,
-	                     Rpc_free);
+	                     Rpc_unload_policy, Rpc_trace, Rpc_sample,
+	                     Rpc_take_samples, Rpc_sample_buffer, Rpc_rule,
+	                     Rpc_pause, Rpc_resume, Rpc_subjects, Rpc_subject_info,
+	                     Rpc_buffer, Rpc_free);
 };
 
 #endif /* _INCLUDE__TRACE_SESSION__TRACE_SESSION_H_ */
@@ -0,0 +1 @@
+CC_OPT += -DGENODE_PERF_COUNTER
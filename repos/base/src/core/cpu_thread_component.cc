@@ -11,6 +11,9 @@
  * under the terms of the GNU General Public License version 2.
  */
 
+/* Genode includes */
+#include <trace/stack_frame.h>
+
 /* core includes */
 #include <cpu_thread_component.h>
 
@@ -48,6 +51,7 @@ void Cpu_thread_component::start(addr_t ip, addr_t sp)
 void Cpu_thread_component::pause()
 {
 	_platform_thread.pause();
+	_paused = true;
 }
 
 
@@ -59,6 +63,7 @@ void Cpu_thread_component::single_step(bool enabled)
 
 void Cpu_thread_component::resume()
 {
+	_paused = false;
 	_platform_thread.resume();
 }
 
@@ -81,6 +86,62 @@ void Cpu_thread_component::state(Thread_state const &state)
 }
 
 
+bool Cpu_thread_component::trace_sample(Trace::Sample &sample, unsigned max_depth)
+{
+	max_depth = min(max_depth, (unsigned)Trace::Sample::MAX_DEPTH);
+	if (!max_depth)
+		return false;
+
+	/*
+	 * The execution state is accessible for paused threads only. Keep the
+	 * thread paused while walking its stack. Threads paused by their
+	 * CPU-session client (e.g., a debugger) are left as they are.
+	 */
+	bool const pause = !_paused;
+	if (pause)
+		_platform_thread.pause();
+
+	bool valid = false;
+	try {
+		Thread_state const state = _platform_thread.state();
+
+		sample.depth = 0;
+		sample.ip[sample.depth++] = state.ip;
+
+		/*
+		 * Walk the frame-pointer chain. The walk stops at the first frame
+		 * outside the RAM of the thread's address space, which is the
+		 * case for code compiled without frame pointers.
+		 */
+		Region_map_component &rm = _address_space_region_map;
+
+		addr_t fp = Trace::frame_pointer(state);
+		while (sample.depth < max_depth && fp) {
+
+			addr_t ret = 0, caller_fp = 0;
+			if (!rm.read_word(fp + Trace::FRAME_RETURN_ADDRESS_OFFSET, ret)
+			 || !rm.read_word(fp + Trace::FRAME_POINTER_OFFSET, caller_fp)
+			 || !ret)
+				break;
+
+			sample.ip[sample.depth++] = ret;
+
+			/* stacks grow downwards, stop at loops and garbage */
+			if (caller_fp <= fp)
+				break;
+
+			fp = caller_fp;
+		}
+		valid = true;
+	} catch (Cpu_thread::State_access_failed) { }
+
+	if (pause)
+		_platform_thread.resume();
+
+	return valid;
+}
+
+
 void Cpu_thread_component::exception_sigh(Signal_context_capability sigh)
 {
 	_thread_sigh = sigh;
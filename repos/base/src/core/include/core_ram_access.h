@@ -0,0 +1,41 @@
+/*
+ * \brief  Access to the content of RAM dataspaces by core
+ * \author Genode Labs
+ * \date   2016-07-18
+ *
+ * This generic version applies to kernels where core has all physical RAM
+ * mapped at the core-local address of the dataspace.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _CORE__INCLUDE__CORE_RAM_ACCESS_H_
+#define _CORE__INCLUDE__CORE_RAM_ACCESS_H_
+
+/* core includes */
+#include <dataspace_component.h>
+
+namespace Genode {
+
+	/**
+	 * Read machine word at 'offset' within RAM dataspace 'ds'
+	 *
+	 * \return  false if the dataspace content is not accessible by core
+	 */
+	inline bool read_ram_word(Dataspace_component &ds, addr_t offset,
+	                          addr_t &value)
+	{
+		if (!ds.core_local_addr())
+			return false;
+
+		value = *(addr_t const *)(ds.core_local_addr() + offset);
+		return true;
+	}
+}
+
+#endif /* _CORE__INCLUDE__CORE_RAM_ACCESS_H_ */
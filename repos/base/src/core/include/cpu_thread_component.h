@@ -33,7 +33,8 @@ namespace Genode { class Cpu_thread_component; }
 
 class Genode::Cpu_thread_component : public Rpc_object<Cpu_thread>,
                                      public List<Cpu_thread_component>::Element,
-                                     public Trace::Source::Info_accessor
+                                     public Trace::Source::Info_accessor,
+                                     public Trace::Source::Sampler
 {
 	public:
 
@@ -51,6 +52,9 @@ class Genode::Cpu_thread_component : public Rpc_object<Cpu_thread>,
 		Platform_thread           _platform_thread;
 		bool                const _bound_to_pd;
 
+		/* thread got paused via the CPU-thread interface */
+		bool _paused = false;
+
 		bool _bind_to_pd(Pd_session_component &pd)
 		{
 			if (!pd.bind_thread(_platform_thread))
@@ -93,7 +97,7 @@ class Genode::Cpu_thread_component : public Rpc_object<Cpu_thread>,
 
 		Trace_control_slot _trace_control_slot;
 
-		Trace::Source _trace_source { *this, _trace_control_slot.control() };
+		Trace::Source _trace_source { *this, _trace_control_slot.control(), this };
 
 		Trace::Source_registry &_trace_sources;
 
@@ -181,6 +185,13 @@ class Genode::Cpu_thread_component : public Rpc_object<Cpu_thread>,
 		}
 
 
+		/**************************************
+		 ** Trace::Source::Sampler interface **
+		 **************************************/
+
+		bool trace_sample(Trace::Sample &, unsigned) override;
+
+
 		/************************
 		 ** Accessor functions **
 		 ************************/
@@ -391,6 +391,16 @@ class Genode::Region_map_component : public Rpc_object<Region_map>,
 			return _apply_to_dataspace(addr, f, 0, RECURSION_LIMIT);
 		}
 
+		/**
+		 * Read machine word at the given address
+		 *
+		 * \return false if 'addr' does not refer to memory that is
+		 *         locally accessible by core
+		 *
+		 * The function is used for walking the stacks of sampled threads.
+		 */
+		bool read_word(addr_t addr, addr_t &value);
+
 		/**
 		 * Register thread as user of the region map as its address space
 		 *
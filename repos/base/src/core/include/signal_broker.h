@@ -23,7 +23,7 @@ class Genode::Signal_broker
 {
 	private:
 
-		Allocator                        &_md_alloc;
+		Allocator_guard                  &_md_alloc;
 		Rpc_entrypoint                   &_source_ep;
 		Rpc_entrypoint                   &_context_ep;
 		Signal_source_component           _source;
@@ -35,14 +35,14 @@ class Genode::Signal_broker
 
 		class Invalid_signal_source : public Exception { };
 
-		Signal_broker(Allocator      &md_alloc,
-		              Rpc_entrypoint &source_ep,
-		              Rpc_entrypoint &context_ep)
+		Signal_broker(Allocator_guard &md_alloc,
+		              Rpc_entrypoint  &source_ep,
+		              Rpc_entrypoint  &context_ep)
 		:
 			_md_alloc(md_alloc),
 			_source_ep(source_ep),
 			_context_ep(context_ep),
-			_source(&_context_ep),
+			_source(&_context_ep, _md_alloc),
 			_source_cap(_source_ep.manage(&_source))
 		{ }
 
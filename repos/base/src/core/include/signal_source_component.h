@@ -22,6 +22,7 @@
 #include <base/rpc_server.h>
 #include <util/fifo.h>
 #include <base/signal.h>
+#include <dataspace/capability.h>
 
 namespace Genode {
 
@@ -108,6 +109,7 @@ class Genode::Signal_source_component : public Signal_source_rpc_object
 
 		Signal_queue          _signal_queue;
 		Rpc_entrypoint       *_entrypoint;
+		Allocator_guard      &_md_alloc;  /* session quota of the client */
 		Native_capability     _reply_cap;
 		Finalizer_component   _finalizer;
 		Capability<Finalizer> _finalizer_cap;
@@ -116,8 +118,12 @@ class Genode::Signal_source_component : public Signal_source_rpc_object
 
 		/**
 		 * Constructor
+		 *
+		 * \param md_alloc  allocator guard of the session, which gets
+		 *                  charged for the shared signal buffer
 		 */
-		Signal_source_component(Rpc_entrypoint *rpc_entrypoint);
+		Signal_source_component(Rpc_entrypoint  *rpc_entrypoint,
+		                        Allocator_guard &md_alloc);
 
 		~Signal_source_component();
 
@@ -131,6 +137,16 @@ class Genode::Signal_source_component : public Signal_source_rpc_object
 		 *****************************/
 
 		Signal wait_for_signal() override;
+
+		/*
+		 * The batched signal delivery is not supported by all kernels. Hence,
+		 * the following methods are implemented only where the signal source
+		 * is a 'Batched_signal_source'.
+		 */
+
+		Dataspace_capability buffer();
+
+		Signal wait_for_signal_batch(unsigned max);
 };
 
 
@@ -97,6 +97,9 @@ class Genode::Trace::Session_component
 		Dataspace_capability policy(Policy_id);
 		void unload_policy(Policy_id);
 		void trace(Subject_id, Policy_id, size_t);
+		void sample(Subject_id, size_t, unsigned);
+		size_t take_samples();
+		Dataspace_capability sample_buffer(Subject_id);
 		void rule(Session_label const &, Thread_name const &, Policy_id, size_t);
 		void pause(Subject_id);
 		void resume(Subject_id);
@@ -18,6 +18,7 @@
 #include <util/string.h>
 #include <base/lock.h>
 #include <base/trace/types.h>
+#include <base/trace/sample.h>
 #include <base/weak_ptr.h>
 
 /* base-internal include */
@@ -66,11 +67,28 @@ class Genode::Trace::Source
 			virtual Info trace_source_info() const = 0;
 		};
 
+		/**
+		 * Interface for sampling the execution state of a source
+		 */
+		struct Sampler
+		{
+			/**
+			 * Record instruction pointer and call chain
+			 *
+			 * \param max_depth  maximum number of entries recorded in
+			 *                   'sample', including the instruction pointer
+			 *
+			 * \return false if the execution state is not accessible
+			 */
+			virtual bool trace_sample(Sample &sample, unsigned max_depth) = 0;
+		};
+
 	private:
 
 		unsigned      const  _unique_id;
 		Info_accessor const &_info;
 		Control             &_control;
+		Sampler             *_sampler;
 		Dataspace_capability _policy;
 		Dataspace_capability _buffer;
 		Source_owner  const *_owner = nullptr;
@@ -79,9 +97,17 @@ class Genode::Trace::Source
 
 	public:
 
-		Source(Info_accessor const &info, Control &control)
+		/**
+		 * Constructor
+		 *
+		 * \param sampler  sampler of the execution state, or nullptr if
+		 *                 the source cannot be sampled
+		 */
+		Source(Info_accessor const &info, Control &control,
+		       Sampler *sampler = nullptr)
 		:
-			_unique_id(_alloc_unique_id()), _info(info), _control(control)
+			_unique_id(_alloc_unique_id()), _info(info), _control(control),
+			_sampler(sampler)
 		{ }
 
 		~Source()
@@ -123,6 +149,11 @@ class Genode::Trace::Source
 				_owner = 0;
 		}
 
+		bool sample(Sample &sample, unsigned max_depth)
+		{
+			return _sampler && _sampler->trace_sample(sample, max_depth);
+		}
+
 		bool error()   const { return _control.has_error(); }
 		bool enabled() const { return _control.enabled(); }
 
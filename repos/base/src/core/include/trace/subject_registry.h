@@ -24,6 +24,7 @@
 #include <util/string.h>
 #include <base/lock.h>
 #include <base/trace/types.h>
+#include <base/trace/buffer.h>
 #include <base/env.h>
 #include <base/weak_ptr.h>
 #include <dataspace/client.h>
@@ -139,6 +140,20 @@ class Genode::Trace::Subject
 		Ram_dataspace       _policy;
 		Policy_id           _policy_id;
 
+		/* buffer of execution samples, written by core */
+		Ram_dataspace       _samples;
+		Buffer             *_sample_buffer = nullptr;
+		unsigned            _sample_depth  = 0;
+
+		size_t _release_samples()
+		{
+			if (_sample_buffer)
+				env()->rm_session()->detach(_sample_buffer);
+
+			_sample_buffer = nullptr;
+			return _samples.flush();
+		}
+
 		Subject_info::State _state()
 		{
 			Locked_ptr<Source> source(_source);
@@ -168,6 +183,8 @@ class Genode::Trace::Subject
 			_label(label), _name(name)
 		{ }
 
+		~Subject() { _release_samples(); }
+
 		/**
 		 * Return registry-local ID
 		 */
@@ -209,6 +226,58 @@ class Genode::Trace::Subject
 			source->trace(_policy.dataspace(), _buffer.dataspace());
 		}
 
+		/**
+		 * Start sampling the execution state
+		 *
+		 * \param size   sample buffer size
+		 * \param depth  maximum number of recorded return addresses
+		 *               plus one for the instruction pointer
+		 *
+		 * \throw   Already_traced
+		 * \throw   Source_is_dead
+		 * \throw   Traced_by_other_session
+		 */
+		void sample(Ram_session &ram, size_t size, unsigned depth)
+		{
+			Locked_ptr<Source> source(_source);
+
+			if (!source.valid())
+				throw Source_is_dead();
+
+			if (!source->try_acquire(this))
+				throw Traced_by_other_session();
+
+			if (!_samples.setup(ram, size))
+				throw Already_traced();
+
+			_sample_buffer = env()->rm_session()->attach(_samples.dataspace());
+			_sample_buffer->init(size);
+			_sample_depth = depth;
+		}
+
+		/**
+		 * Record sample of the execution state into the sample buffer
+		 *
+		 * \return true if a sample was recorded
+		 */
+		bool take_sample()
+		{
+			if (!_sample_buffer)
+				return false;
+
+			Locked_ptr<Source> source(_source);
+
+			Sample sample;
+			if (!source.valid() || !source->sample(sample, _sample_depth))
+				return false;
+
+			memcpy(_sample_buffer->reserve(sample.size()), &sample, sample.size());
+			_sample_buffer->commit(sample.size());
+			return true;
+		}
+
+		Dataspace_capability sample_buffer() const { return _samples.dataspace(); }
+
 		void pause()
 		{
 			/* inform trace source about the new buffer */
@@ -264,7 +333,7 @@ class Genode::Trace::Subject
 			if (!source.valid())
 				return 0;
 
-			return _buffer.flush() + _policy.flush();
+			return _buffer.flush() + _policy.flush() + _release_samples();
 		}
 };
 
@@ -434,6 +503,22 @@ class Genode::Trace::Subject_registry
 
 			return _unsynchronized_lookup_by_id(id);
 		}
+
+		/**
+		 * Record a sample of each subject with sampling enabled
+		 *
+		 * \return number of recorded samples
+		 */
+		size_t take_samples()
+		{
+			Lock guard(_lock);
+
+			size_t cnt = 0;
+			for (Subject *s = _entries.first(); s; s = s->next())
+				if (s->take_sample())
+					cnt++;
+			return cnt;
+		}
 };
 
 #endif /* _CORE__INCLUDE__TRACE__SUBJECT_REGISTRY_H_ */
@@ -24,6 +24,7 @@
 #include <cpu_session_component.h>
 #include <region_map_component.h>
 #include <dataspace_component.h>
+#include <core_ram_access.h>
 
 static const bool verbose             = false;
 static const bool verbose_page_faults = false;
@@ -628,6 +629,32 @@ Region_map::State Region_map_component::state()
 	return faulter->fault_state();
 }
 
+
+bool Region_map_component::read_word(addr_t addr, addr_t &value)
+{
+	if (addr & (sizeof(addr_t) - 1))
+		return false;
+
+	auto lambda = [&] (Region_map_component *,
+	                   Rm_region            *region,
+	                   addr_t                ds_offset,
+	                   addr_t) -> bool
+	{
+		Dataspace_component *dsc = region ? region->dataspace() : nullptr;
+
+		/* never touch device memory */
+		if (!dsc || dsc->io_mem())
+			return false;
+
+		if (ds_offset + sizeof(addr_t) > dsc->size())
+			return false;
+
+		return read_ram_word(*dsc, ds_offset, value);
+	};
+	return apply_to_dataspace(addr, lambda);
+}
+
+
 static Dataspace_capability _type_deduction_helper(Dataspace_capability cap) {
 	return cap; }
 
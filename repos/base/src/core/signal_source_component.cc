@@ -13,6 +13,7 @@
 
 /* Genode includes */
 #include <base/ipc.h>
+#include <base/env.h>
 #include <base/printf.h>
 
 /* core includes */
@@ -48,6 +49,10 @@ void Signal_source_component::submit(Signal_context_component *context,
 	 */
 	if (_reply_cap.valid()) {
 
+		/* the signal is delivered as return value of the blocking call */
+		if (_buffer)
+			_buffer->num = 0;
+
 		_entrypoint->reply_signal_info(_reply_cap, context->imprint(), context->cnt());
 
 		/*
@@ -87,9 +92,62 @@ Signal_source::Signal Signal_source_component::wait_for_signal()
 }
 
 
-Signal_source_component::Signal_source_component(Rpc_entrypoint *ep)
+Dataspace_capability Signal_source_component::buffer()
+{
+	if (_buffer)
+		return _buffer_ds;
+
+	/* account the buffer to the session quota of the client */
+	if (!_md_alloc.withdraw(Buffer::SIZE)) {
+		PWRN("session quota exhausted, no signal buffer");
+		return Dataspace_capability();
+	}
+
+	try {
+		_buffer_ds = env()->ram_session()->alloc(Buffer::SIZE);
+		_buffer    = env()->rm_session()->attach(_buffer_ds);
+		_buffer->num = 0;
+	} catch (...) {
+		PERR("could not allocate signal buffer");
+		if (_buffer_ds.valid())
+			env()->ram_session()->free(_buffer_ds);
+		_buffer_ds = Ram_dataspace_capability();
+		_buffer    = nullptr;
+
+		/* revert withdrawal of quota */
+		_md_alloc.upgrade(Buffer::SIZE);
+	}
+	return _buffer_ds;
+}
+
+
+Signal_source::Signal Signal_source_component::wait_for_signal_batch(unsigned max)
+{
+	Signal const result = wait_for_signal();
+
+	if (!_buffer)
+		return result;
+
+	/* pass further pending signals via the shared buffer */
+	unsigned const capacity = min(max, (unsigned)Buffer::CAPACITY);
+
+	unsigned num = 0;
+	for (; num < capacity && !_signal_queue.empty(); num++) {
+
+		Signal_context_component *context = _signal_queue.dequeue();
+		_buffer->signals[num] = Signal(context->imprint(), context->cnt());
+		context->reset_signal_cnt();
+	}
+	_buffer->num = num;
+
+	return result;
+}
+
+
+Signal_source_component::Signal_source_component(Rpc_entrypoint  *ep,
+                                                 Allocator_guard &md_alloc)
 :
-	_entrypoint(ep), _finalizer(*this),
+	_entrypoint(ep), _md_alloc(md_alloc), _finalizer(*this),
 	_finalizer_cap(_entrypoint->manage(&_finalizer))
 { }
 
@@ -98,6 +156,12 @@ Signal_source_component::~Signal_source_component()
 {
 	_finalizer_cap.call<Finalizer::Rpc_exit>();
 	_entrypoint->dissolve(&_finalizer);
+
+	if (_buffer) {
+		env()->rm_session()->detach(_buffer);
+		env()->ram_session()->free(_buffer_ds);
+		_md_alloc.upgrade(Buffer::SIZE);
+	}
 }
 
 
@@ -106,6 +170,9 @@ void Signal_source_component::Finalizer_component::exit()
 	if (!source._reply_cap.valid())
 		return;
 
+	if (source._buffer)
+		source._buffer->num = 0;
+
 	source._entrypoint->reply_signal_info(source._reply_cap, 0, 0);
 	source._reply_cap = Untyped_capability();
 }
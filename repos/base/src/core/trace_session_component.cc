@@ -108,6 +108,41 @@ void Session_component::trace(Subject_id subject_id, Policy_id policy_id,
 }
 
 
+void Session_component::sample(Subject_id subject_id, size_t buffer_size,
+                               unsigned depth)
+{
+	Trace::Subject *subject = _subjects.lookup_by_id(subject_id);
+
+	/* account RAM needed for the sample buffer to the trace session */
+	if (!_md_alloc.withdraw(buffer_size))
+		throw Out_of_metadata();
+
+	try {
+		subject->sample(_ram, buffer_size, depth);
+	}
+	catch (Already_traced)          { _md_alloc.upgrade(buffer_size); throw; }
+	catch (Source_is_dead)          { _md_alloc.upgrade(buffer_size); throw; }
+	catch (Traced_by_other_session) { _md_alloc.upgrade(buffer_size); throw; }
+	catch (...) {
+		/* revert withdrawal or quota */
+		_md_alloc.upgrade(buffer_size);
+		throw Out_of_metadata();
+	}
+}
+
+
+size_t Session_component::take_samples()
+{
+	return _subjects.take_samples();
+}
+
+
+Dataspace_capability Session_component::sample_buffer(Subject_id subject_id)
+{
+	return _subjects.lookup_by_id(subject_id)->sample_buffer();
+}
+
+
 void Session_component::rule(Session_label const &, Thread_name const &,
                              Policy_id, size_t)
 {
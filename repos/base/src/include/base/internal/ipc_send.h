@@ -0,0 +1,37 @@
+/*
+ * \brief  Asynchronous sending of RPC requests
+ * \author Genode Labs
+ * \date   2016-06-29
+ *
+ * By default, the kernel interface is expected to provide synchronous IPC
+ * only. Platforms that support sending a request without waiting for the
+ * reply provide a custom version of this header.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__INTERNAL__IPC_SEND_H_
+#define _INCLUDE__BASE__INTERNAL__IPC_SEND_H_
+
+/* Genode includes */
+#include <base/ipc.h>
+
+namespace Genode {
+
+	/**
+	 * Return true if 'ipc_send' is supported by the platform
+	 */
+	static inline bool ipc_send_supported() { return false; }
+
+	/**
+	 * Send request to RPC object without waiting for a reply
+	 */
+	static inline void ipc_send(Native_capability, Msgbuf_base &) { }
+}
+
+#endif /* _INCLUDE__BASE__INTERNAL__IPC_SEND_H_ */
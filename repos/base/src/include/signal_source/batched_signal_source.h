@@ -0,0 +1,74 @@
+/*
+ * \brief  Signal-source interface with batched signal delivery
+ * \author Genode Labs
+ * \date   2016-06-30
+ *
+ * With the plain signal-source interface, each blocking RPC into core
+ * delivers a single signal. A component that receives signals from many
+ * contexts at a high rate thereby performs one round trip to core per
+ * context. The batched variant returns all currently pending signals at
+ * once. Besides the signal returned by the RPC, the signals are passed via
+ * a buffer shared between core and the component.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__SIGNAL_SOURCE__BATCHED_SIGNAL_SOURCE_H_
+#define _INCLUDE__SIGNAL_SOURCE__BATCHED_SIGNAL_SOURCE_H_
+
+#include <base/rpc.h>
+#include <dataspace/capability.h>
+#include <signal_source/signal_source.h>
+
+namespace Genode { struct Batched_signal_source; }
+
+
+struct Genode::Batched_signal_source : Signal_source
+{
+	/**
+	 * Layout of the buffer shared between core and the component
+	 */
+	struct Buffer
+	{
+		enum { SIZE = 4096 };
+
+		enum { CAPACITY = (SIZE - sizeof(unsigned long))/sizeof(Signal) };
+
+		/* number of valid entries of 'signals' */
+		unsigned long num;
+
+		Signal signals[CAPACITY];
+	};
+
+	/**
+	 * Return dataspace of the shared buffer
+	 */
+	virtual Dataspace_capability buffer() = 0;
+
+	/**
+	 * Wait for signal, store further pending signals in the shared buffer
+	 *
+	 * \param max  maximum number of signals to store in the buffer
+	 *
+	 * The shared buffer is valid until the next call of the method.
+	 */
+	virtual Signal wait_for_signal_batch(unsigned max) = 0;
+
+
+	/*********************
+	 ** RPC declaration **
+	 *********************/
+
+	GENODE_RPC(Rpc_buffer, Dataspace_capability, buffer);
+	GENODE_RPC(Rpc_wait_for_signal_batch, Signal, wait_for_signal_batch, unsigned);
+
+	GENODE_RPC_INTERFACE_INHERIT(Signal_source, Rpc_buffer,
+	                             Rpc_wait_for_signal_batch);
+};
+
+#endif /* _INCLUDE__SIGNAL_SOURCE__BATCHED_SIGNAL_SOURCE_H_ */
@@ -15,17 +15,64 @@
 #define _INCLUDE__SIGNAL_SOURCE__CLIENT_H_
 
 #include <base/rpc_client.h>
+#include <base/env.h>
 #include <pd_session/pd_session.h>
-#include <signal_source/signal_source.h>
+#include <signal_source/batched_signal_source.h>
 
 namespace Genode { class Signal_source_client; }
 
-struct Genode::Signal_source_client : Rpc_client<Signal_source>
+
+class Genode::Signal_source_client : public Rpc_client<Batched_signal_source>
 {
-	Signal_source_client(Capability<Signal_source> signal_source)
-	: Rpc_client<Signal_source>(signal_source) { }
+	private:
+
+		/* shared buffer, or nullptr if core could not provide one */
+		Buffer *_buffer;
+
+		static Buffer *_attach(Dataspace_capability ds)
+		{
+			try { return env()->rm_session()->attach(ds); }
+			catch (...) { return nullptr; }
+		}
+
+	public:
+
+		Signal_source_client(Capability<Signal_source> signal_source)
+		:
+			Rpc_client<Batched_signal_source>(
+				static_cap_cast<Batched_signal_source>(signal_source)),
+			_buffer(_attach(call<Rpc_buffer>()))
+		{ }
+
+		~Signal_source_client()
+		{
+			if (_buffer)
+				env()->rm_session()->detach(_buffer);
+		}
+
+		Dataspace_capability buffer() override { return call<Rpc_buffer>(); }
+
+		Signal wait_for_signal() override { return call<Rpc_wait_for_signal>(); }
+
+		Signal wait_for_signal_batch(unsigned max) override {
+			return call<Rpc_wait_for_signal_batch>(max); }
+
+		unsigned wait_for_signals(Signal *dst, unsigned max) override
+		{
+			if (!_buffer)
+				return Signal_source::wait_for_signals(dst, max);
+
+			if (max == 0)
+				return 0;
+
+			dst[0] = wait_for_signal_batch(max - 1);
+
+			unsigned const num = min(_buffer->num, (unsigned long)max - 1);
+			for (unsigned i = 0; i < num; i++)
+				dst[1 + i] = _buffer->signals[i];
 
-	Signal wait_for_signal() override { return call<Rpc_wait_for_signal>(); }
+			return 1 + num;
+		}
 };
 
 #endif /* _INCLUDE__SIGNAL_SOURCE__CLIENT_H_ */
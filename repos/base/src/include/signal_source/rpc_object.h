@@ -19,10 +19,23 @@
 #define _INCLUDE__SIGNAL_SOURCE__RPC_OBJECT_H_
 
 #include <base/rpc_server.h>
-#include <signal_source/signal_source.h>
+#include <ram_session/ram_session.h>
+#include <signal_source/batched_signal_source.h>
 
 namespace Genode { struct Signal_source_rpc_object; }
 
-struct Genode::Signal_source_rpc_object : Rpc_object<Signal_source> { };
+
+struct Genode::Signal_source_rpc_object : Rpc_object<Batched_signal_source,
+                                                     Signal_source_rpc_object>
+{
+	protected:
+
+		/*
+		 * Buffer shared with the client, allocated by core on the first
+		 * request of the client
+		 */
+		Ram_dataspace_capability _buffer_ds;
+		Buffer                  *_buffer = nullptr;
+};
 
 #endif /* _INCLUDE__SIGNAL_SOURCE__RPC_OBJECT_H_ */
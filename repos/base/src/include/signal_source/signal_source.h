@@ -56,6 +56,25 @@ struct Genode::Signal_source
 	 */
 	virtual Signal wait_for_signal() = 0;
 
+	/**
+	 * Wait for signal and obtain all other pending signals along with it
+	 *
+	 * \param dst  array to be filled with up to 'max' signals
+	 * \return     number of signals stored at 'dst'
+	 *
+	 * This method is not part of the RPC interface. Signal sources that
+	 * are able to deliver signals in batches override it. By default, a
+	 * single signal is obtained via 'wait_for_signal'.
+	 */
+	virtual unsigned wait_for_signals(Signal *dst, unsigned max)
+	{
+		if (max == 0)
+			return 0;
+
+		dst[0] = wait_for_signal();
+		return 1;
+	}
+
 
 	/*********************
 	 ** RPC declaration **
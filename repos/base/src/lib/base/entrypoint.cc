@@ -20,6 +20,7 @@
 
 /* base-internal includes */
 #include <base/internal/globals.h>
+#include <base/internal/ipc_send.h>
 
 using namespace Genode;
 
@@ -54,11 +55,69 @@ void Entrypoint::_dispatch_signal(Signal &sig)
 }
 
 
+void Entrypoint::_enable_signal_wakeup()
+{
+	if (!ipc_send_supported())
+		return;
+
+	_signal_wakeup_enabled = true;
+	_wakeup_pending        = false;
+	_sig_rec->wakeup(&_signal_wakeup);
+}
+
+
+void Entrypoint::_wakeup_for_signals()
+{
+	/* one wakeup in flight suffices to let the entrypoint see all signals */
+	{
+		Lock::Guard guard(_wakeup_lock);
+
+		if (_wakeup_pending)
+			return;
+
+		_wakeup_pending = true;
+	}
+
+	Msgbuf<16> snd_buf;
+	snd_buf.insert(Rpc_opcode(static_cast<int>(
+		Meta::Index_of<Signal_proxy::Rpc_functions,
+		               Signal_proxy::Rpc_signal>::Value)));
+
+	ipc_send(_signal_proxy_cap, snd_buf);
+}
+
+
+void Entrypoint::_dispatch_pending_signals()
+{
+	/*
+	 * Signals that arrive from now on must trigger another wakeup because
+	 * we may have passed their context already.
+	 */
+	{
+		Lock::Guard guard(_wakeup_lock);
+		_wakeup_pending = false;
+	}
+
+	for (;;) {
+		try {
+			Signal sig = _sig_rec->fetch_signal();
+			_dispatch_signal(sig);
+		} catch (Signal_receiver::Signal_not_pending) { return; }
+	}
+}
+
+
 void Entrypoint::_process_incoming_signals()
 {
 	for (;;) {
 
 		do {
+			/* signals are dispatched by the entrypoint without our help */
+			if (_signal_wakeup_enabled) {
+				_suspend_requested.down();
+				continue;
+			}
+
 			_sig_rec->block_for_signal();
 
 			/*
@@ -88,6 +147,7 @@ void Entrypoint::_process_incoming_signals()
 		_rpc_ep.construct(&_env.pd(), Component::stack_size(), initial_ep_name());
 		_signal_proxy_cap = manage(_signal_proxy);
 		_sig_rec.construct();
+		_enable_signal_wakeup();
 
 		/*
 		 * Before calling the resumed callback, we reset the callback pointer
@@ -164,6 +224,7 @@ Entrypoint::Entrypoint(Env &env)
 {
 	/* initialize signalling after initializing but before calling the entrypoint */
 	init_signal_thread(_env);
+	_enable_signal_wakeup();
 
 	/*
 	 * Invoke Component::construct function in the context of the entrypoint.
@@ -183,17 +244,22 @@ Entrypoint::Entrypoint(Env &env)
 
 	/*
 	 * The calling initial thread becomes the signal proxy thread for this
-	 * entrypoint
+	 * entrypoint. With direct signal delivery, it merely executes the
+	 * suspend-resume mechanism.
 	 */
 	_process_incoming_signals();
 }
 
 
-Entrypoint::Entrypoint(Env &env, size_t stack_size, char const *name)
+Entrypoint::Entrypoint(Env &env, size_t stack_size, char const *name,
+                       Affinity::Location location)
 :
 	_env(env),
-	_rpc_ep(&env.pd(), stack_size, name)
+	_rpc_ep(&env.pd(), stack_size, name, true, location)
 {
-	_signal_proxy_thread.construct(env, *this);
+	_enable_signal_wakeup();
+
+	if (!_signal_wakeup_enabled)
+		_signal_proxy_thread.construct(env, *this);
 }
 
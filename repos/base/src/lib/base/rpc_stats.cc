@@ -0,0 +1,79 @@
+/*
+ * \brief  Aggregated RPC statistics
+ * \author Genode Labs
+ * \date   2016-07-20
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/lock.h>
+#include <base/trace/rpc_stats.h>
+#include <cpu/memory_barrier.h>
+
+using namespace Genode;
+
+
+bool volatile Trace::Rpc_stats::_enabled = false;
+
+static Trace::Rpc_stats::Function * volatile _head = nullptr;
+
+
+static Lock &_register_lock()
+{
+	static Lock lock;
+	return lock;
+}
+
+
+void Trace::Rpc_stats::_register(Function &function)
+{
+	Lock::Guard guard(_register_lock());
+
+	if (function.registered)
+		return;
+
+	/*
+	 * Readers traverse the list without holding the lock. Hence, the
+	 * function must be completely linked before it becomes the list head.
+	 */
+	function.next = _head;
+	memory_barrier();
+	_head = &function;
+
+	function.registered = 1;
+}
+
+
+Trace::Rpc_stats::Function const *Trace::Rpc_stats::_first() { return _head; }
+
+
+String<128> Trace::Rpc_stats::Function::interface_name() const
+{
+	/*
+	 * The info string looks like "... [with IF = Genode::Ram_session;
+	 * FUNC = ...]" for GCC.
+	 */
+	char const *info = interface_info();
+	char const *pattern = "IF = ";
+	size_t const pattern_len = strlen(pattern);
+
+	for (; *info; info++) {
+		if (strcmp(info, pattern, pattern_len))
+			continue;
+
+		info += pattern_len;
+
+		size_t len = 0;
+		while (info[len] && info[len] != ';' && info[len] != ']' && info[len] != ',')
+			len++;
+
+		return String<128>(info, len);
+	}
+	return String<128>("unknown");
+}
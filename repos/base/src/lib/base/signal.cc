@@ -271,38 +271,54 @@ void Signal_receiver::local_submit(Signal::Data ns)
 	if (!context->_pending) {
 		context->_pending = true;
 		_signal_available.up();
+
+		if (_wakeup)
+			_wakeup->wakeup();
 	}
 }
 
 
 void Signal_receiver::dispatch_signals(Signal_source *signal_source)
 {
+	/*
+	 * Signals of all contexts that are pending at the signal source are
+	 * obtained at once to save round trips to core.
+	 */
+	enum { MAX_SIGNALS = 64 };
+	Signal_source::Signal source_signals[MAX_SIGNALS];
+
 	for (;;) {
-		Signal_source::Signal source_signal = signal_source->wait_for_signal();
+		unsigned const num = signal_source->wait_for_signals(source_signals,
+		                                                     MAX_SIGNALS);
 
-		/* look up context as pointed to by the signal imprint */
-		Signal_context *context = (Signal_context *)(source_signal.imprint());
+		for (unsigned i = 0; i < num; i++) {
 
-		if (!context) {
-			PERR("received null signal imprint, stop signal handling");
-			sleep_forever();
-		}
+			Signal_source::Signal &source_signal = source_signals[i];
 
-		if (!signal_context_registry()->test_and_lock(context)) {
-			PWRN("encountered dead signal context");
-			continue;
-		}
+			/* look up context as pointed to by the signal imprint */
+			Signal_context *context = (Signal_context *)(source_signal.imprint());
 
-		if (context->_receiver) {
-			/* construct and locally submit signal object */
-			Signal::Data signal(context, source_signal.num());
-			context->_receiver->local_submit(signal);
-		} else {
-			PWRN("signal context with no receiver");
-		}
+			if (!context) {
+				PERR("received null signal imprint, stop signal handling");
+				sleep_forever();
+			}
+
+			if (!signal_context_registry()->test_and_lock(context)) {
+				PWRN("encountered dead signal context");
+				continue;
+			}
 
-		/* free context lock that was taken by 'test_and_lock' */
-		context->_lock.unlock();
+			if (context->_receiver) {
+				/* construct and locally submit signal object */
+				Signal::Data signal(context, source_signal.num());
+				context->_receiver->local_submit(signal);
+			} else {
+				PWRN("signal context with no receiver");
+			}
+
+			/* free context lock that was taken by 'test_and_lock' */
+			context->_lock.unlock();
+		}
 	}
 }
 
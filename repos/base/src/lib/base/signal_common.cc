@@ -130,6 +130,21 @@ Signal Signal_receiver::wait_for_signal()
 }
 
 
+Signal Signal_receiver::fetch_signal()
+{
+	while (_signal_available.cnt() > 0) {
+
+		/* cannot block because the caller is the only consumer */
+		_signal_available.down();
+
+		try {
+			return pending_signal();
+		} catch (Signal_not_pending) { }
+	}
+	throw Signal_not_pending();
+}
+
+
 Signal Signal_receiver::pending_signal()
 {
 	Lock::Guard list_lock_guard(_contexts_lock);
@@ -3,7 +3,7 @@ SHARED_LIB = yes
 LIB_DIR     = $(REP_DIR)/src/lib/lxip
 LIB_INC_DIR = $(LIB_DIR)/include
 
-LIBS += lxip_include
+LIBS += lxip_include libc-setjmp
 
 LX_CONTRIB_DIR := $(call select_from_ports,dde_linux)/src/lib/lxip
 NET_DIR        := $(LX_CONTRIB_DIR)/net
@@ -29,7 +29,7 @@ CC_CXX_OPT = -fpermissive
 SRC_CC = dummies.cc lxcc_emul.cc nic_handler.cc socket_handler.cc \
          timer_handler.cc
 
-SRC_CC += malloc.cc printf.cc
+SRC_CC += malloc.cc printf.cc scheduler.cc
 
 SRC_C += driver.c dummies_c.c lxc_emul.c
 
@@ -23,6 +23,13 @@ namespace Lx {
 	void event_init(Genode::Signal_receiver &);
 
 	void timer_update_jiffies();
+
+	/**
+	 * Block the current socket-call task until the next signal
+	 *
+	 * \return  false if not called by a socket-call task
+	 */
+	bool task_block();
 }
 
 extern "C" int lxip_init(char const *address_config);
@@ -272,29 +272,35 @@ void Lx::event_init(Genode::Signal_receiver &sig_rec)
 }
 
 
-struct Timeout : Genode::Signal_dispatcher<Timeout>
-{
-	void handle(unsigned) { update_jiffies(); }
-
-	Timeout(Timer::Session_client &timer, signed long msec)
-	: Signal_dispatcher<Timeout>(*_sig_rec, *this, &Timeout::handle)
-	{
-		if (msec > 0) {
-			timer.sigh(*this);
-			timer.trigger_once(msec*1000);
-		}
-	}
-};
+/*
+ * The timeout is implemented as Linux timer. Its only purpose is the
+ * signal of the timer, which ends the wait.
+ */
+static void _timeout(unsigned long) { }
 
 
+/**
+ * Wait for the next signal or until 'timeout' jiffies elapsed
+ *
+ * Socket calls are executed by Lx tasks. A waiting task blocks and is
+ * unblocked by the socketcall thread after the next signal. Outside of a
+ * task, e.g., during initialization, the next signal is dispatched in place.
+ */
 static void __wait_event(signed long timeout)
 {
-	static Timer::Connection timer;
-	Timeout to(timer, timeout);
+	struct timer_list timer;
+	if (timeout > 0) {
+		setup_timer(&timer, _timeout, 0);
+		mod_timer(&timer, jiffies + timeout);
+	}
+
+	if (!Lx::task_block()) {
+		Genode::Signal s = _sig_rec->wait_for_signal();
+		static_cast<Genode::Signal_dispatcher_base *>(s.context())->dispatch(s.num());
+	}
 
-	/* dispatch signal */
-	Genode::Signal s = _sig_rec->wait_for_signal();
-	static_cast<Genode::Signal_dispatcher_base *>(s.context())->dispatch(s.num());
+	if (timeout > 0)
+		del_timer(&timer);
 }
 
 
@@ -15,8 +15,12 @@
 #include <base/env.h>
 #include <base/signal.h>
 #include <base/printf.h>
+#include <base/semaphore.h>
 #include <base/thread.h>
 
+/* Linux kit includes */
+#include <lx_kit/scheduler.h>
+
 /* local includes */
 #include <lxip/lxip.h>
 #include <lx.h>
@@ -100,17 +104,32 @@ namespace Net
 			};
 
 			struct Linux::sockaddr_storage addr;
-			Lxip::uint32_t                 addr_len;
-		};
+			Lxip::uint32_t                 addr_len = 0;
 
-		union Result
-		{
-			int           err;
-			Lxip::ssize_t len;
+			/* results */
+			union
+			{
+				int           err;
+				Lxip::ssize_t len;
+			} result;
+			Lxip::Handle new_handle;
+
+			/* woken up when the call is completed */
+			Genode::Semaphore done;
 		};
 };
 
 
+bool Lx::task_block()
+{
+	if (!Lx::scheduler().active())
+		return false;
+
+	Lx::scheduler().current()->block_and_schedule();
+	return true;
+}
+
+
 class Net::Socketcall : public Genode::Signal_dispatcher_base,
                         public Genode::Signal_context_capability,
                         public Lxip::Socketcall,
@@ -118,29 +137,158 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 {
 	private:
 
-		Call         _call;
-		Result       _result;
-		Lxip::Handle _handle;
+		/*
+		 * Calls are submitted by the application threads via a ring of
+		 * outstanding calls. Each caller blocks on its own call object
+		 * only. Hence, calls of different threads do not wait for each
+		 * other unless 'MAX_CALLS' calls are outstanding.
+		 */
+		enum { MAX_CALLS = 64 };
+
+		Call             *_calls[MAX_CALLS];
+		unsigned          _head  = 0;  /* next call to execute */
+		unsigned          _count = 0;  /* number of queued calls */
+		Genode::Lock      _calls_lock;
+		Genode::Semaphore _free_slots { MAX_CALLS };
+
+		/**
+		 * Lx task executing one call at a time
+		 *
+		 * Each outstanding call is executed by a task of its own. A call
+		 * that waits within the IP stack, e.g., in accept or a blocking
+		 * recv, blocks only its task. Tasks are kept for subsequent calls.
+		 */
+		struct Call_task : Lx::Task
+		{
+			Socketcall &socketcall;
+			Call       *call     = nullptr;
+			bool        finished = false;
+
+			static void _run(void *arg)
+			{
+				Call_task &task = *static_cast<Call_task *>(arg);
+
+				while (true) {
+					if (task.call && !task.finished) {
+						task.socketcall._execute(*task.call);
+						task.finished = true;
+					}
+					task.block_and_schedule();
+				}
+			}
+
+			Call_task(Socketcall &socketcall)
+			:
+				Lx::Task(_run, this, "socketcall", PRIORITY_0, Lx::scheduler()),
+				socketcall(socketcall)
+			{ }
+		};
+
+		Call_task *_tasks[MAX_CALLS];
+		unsigned   _num_tasks = 0;
 
 		Genode::Signal_receiver    &_sig_rec;
 		Genode::Signal_transmitter  _signal;
-		Genode::Semaphore           _block;
 
-		void _submit_and_block()
+		void _submit_and_block(Call &call)
 		{
-			_signal.submit(); /* global submit */
-			_block.down();
+			_free_slots.down();
+
+			bool first = false;
+			{
+				Genode::Lock::Guard guard(_calls_lock);
+
+				_calls[(_head + _count) % MAX_CALLS] = &call;
+				first = (_count++ == 0);
+			}
+
+			/* the socketcall thread picks up all queued calls per signal */
+			if (first)
+				_signal.submit(); /* global submit */
+
+			call.done.down();
 		}
 
-		void _unblock() { _block.up(); }
+		/**
+		 * Dequeue next call
+		 *
+		 * \return  call, or 0 if no call is queued
+		 */
+		Call *_dequeue()
+		{
+			Genode::Lock::Guard guard(_calls_lock);
 
-		struct Linux::socket * call_socket()
+			if (_count == 0)
+				return 0;
+
+			Call *call = _calls[_head];
+			_head = (_head + 1) % MAX_CALLS;
+			_count--;
+
+			return call;
+		}
+
+		/**
+		 * Return task without call, create one if needed
+		 *
+		 * Because the number of outstanding calls is limited by
+		 * '_free_slots', at most 'MAX_CALLS' tasks are created.
+		 */
+		Call_task &_idle_task()
 		{
-			return static_cast<struct Linux::socket *>(_call.handle.socket);
+			for (unsigned i = 0; i < _num_tasks; i++)
+				if (!_tasks[i]->call)
+					return *_tasks[i];
+
+			Call_task *task = new (Genode::env()->heap()) Call_task(*this);
+			_tasks[_num_tasks++] = task;
+			return *task;
 		}
 
+		/**
+		 * Execute calls until all tasks are blocked
+		 *
+		 * Called after each signal. Tasks waiting within the IP stack are
+		 * unblocked to re-evaluate the condition they wait for, e.g., the
+		 * arrival of data or an expired timeout.
+		 */
+		void _schedule()
+		{
+			while (Call *call = _dequeue()) {
+				Call_task &task = _idle_task();
+				task.call     = call;
+				task.finished = false;
+			}
+
+			if (!_num_tasks)
+				return;
+
+			for (unsigned i = 0; i < _num_tasks; i++)
+				_tasks[i]->unblock();
 
-		Lxip::uint32_t _family_handler(Lxip::uint16_t family, void *addr)
+			Lx::scheduler().schedule();
+
+			for (unsigned i = 0; i < _num_tasks; i++) {
+				Call_task &task = *_tasks[i];
+				if (!task.call || !task.finished)
+					continue;
+
+				Call &call = *task.call;
+				task.call = nullptr;
+
+				call.done.up();
+				_free_slots.up();
+			}
+		}
+
+		static struct Linux::socket * _socket(Call &call)
+		{
+			return static_cast<struct Linux::socket *>(call.handle.socket);
+		}
+
+
+		Lxip::uint32_t _family_handler(Call &call, Lxip::uint16_t family,
+		                               void *addr)
 		{
 			using namespace Linux;
 
@@ -152,7 +300,7 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 				case AF_INET:
 
 					struct sockaddr_in *in  = (struct sockaddr_in *)addr;
-					struct sockaddr_in *out = (struct sockaddr_in *)&_call.addr;
+					struct sockaddr_in *out = (struct sockaddr_in *)&call.addr;
 
 					out->sin_family       = family;
 					out->sin_port         = in->sin_port;
@@ -168,14 +316,14 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 		 ** Glue interface to Linux TCP/IP stack **
 		 ******************************************/
 
-		void _do_accept()
+		void _do_accept(Call &call)
 		{
 			using namespace Linux;
 
-			struct socket *sock     = call_socket();
+			struct socket *sock     = _socket(call);
 			struct socket *new_sock = sock_alloc();
 
-			_handle.socket = 0;
+			call.new_handle.socket = 0;
 
 			if (!new_sock)
 				return;
@@ -188,33 +336,33 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 				return;
 			}
 
-			_handle.socket = static_cast<void *>(new_sock);
+			call.new_handle.socket = static_cast<void *>(new_sock);
 
-			if (!_call.accept.addr)
+			if (!call.accept.addr)
 				return;
 
 			int len;
-			if ((new_sock->ops->getname(new_sock, (struct sockaddr *)&_call.addr,
+			if ((new_sock->ops->getname(new_sock, (struct sockaddr *)&call.addr,
 			    &len, 2)) < 0)
 				return;
 
-			*_call.accept.len = min(*_call.accept.len, len);
-			Genode::memcpy(_call.accept.addr, &_call.addr, *_call.accept.len);
+			*call.accept.len = min(*call.accept.len, len);
+			Genode::memcpy(call.accept.addr, &call.addr, *call.accept.len);
 		}
 
-		void _do_bind()
+		void _do_bind(Call &call)
 		{
-			struct Linux::socket *sock = call_socket();
+			struct Linux::socket *sock = _socket(call);
 
-			_result.err = sock->ops->bind(sock, (struct Linux::sockaddr *) &_call.addr,
-			                              _call.addr_len);
+			call.result.err = sock->ops->bind(sock, (struct Linux::sockaddr *) &call.addr,
+			                                  call.addr_len);
 		}
 
-		void _do_close()
+		void _do_close(Call &call)
 		{
 			using namespace Linux;
 
-			struct socket *s = call_socket();
+			struct socket *s = _socket(call);
 			if (s->ops)
 				s->ops->release(s);
 
@@ -222,52 +370,52 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 			kfree(s);
 		}
 
-		void _do_connect()
+		void _do_connect(Call &call)
 		{
-			Linux::socket *sock = call_socket();
+			Linux::socket *sock = _socket(call);
 
 			//XXX: have a look at the file flags
-			_result.err = sock->ops->connect(sock, (struct Linux::sockaddr *) &_call.addr,
-			                                 _call.addr_len, 0);
+			call.result.err = sock->ops->connect(sock, (struct Linux::sockaddr *) &call.addr,
+			                                     call.addr_len, 0);
 		}
 
-		void _do_getname(int peer)
+		void _do_getname(Call &call, int peer)
 		{
 			int len = sizeof(Linux::sockaddr_storage);
-			_result.err = call_socket()->ops->getname(call_socket(),
-			                                          (struct Linux::sockaddr *)&_call.addr,
-			                                          &len, peer);
+			call.result.err = _socket(call)->ops->getname(_socket(call),
+			                                              (struct Linux::sockaddr *)&call.addr,
+			                                              &len, peer);
 
-			*_call.accept.len = Linux::min(*_call.accept.len, len);
-			Genode::memcpy(_call.accept.addr, &_call.addr, *_call.accept.len);
+			*call.accept.len = Linux::min(*call.accept.len, len);
+			Genode::memcpy(call.accept.addr, &call.addr, *call.accept.len);
 		}
 
 
-		void _do_getopt()
+		void _do_getopt(Call &call)
 		{
-			_result.err = Linux::sock_getsockopt(call_socket(), _call.sockopt.level,
-			                                     _call.sockopt.optname,
-			                                     (char *)_call.sockopt.optval,
-			                                     _call.sockopt.optlen_ptr);
+			call.result.err = Linux::sock_getsockopt(_socket(call), call.sockopt.level,
+			                                         call.sockopt.optname,
+			                                         (char *)call.sockopt.optval,
+			                                         call.sockopt.optlen_ptr);
 		}
 
-		void _do_ioctl()
+		void _do_ioctl(Call &call)
 		{
-			_result.err = call_socket()->ops->ioctl(call_socket(),
-			                                        _call.ioctl.request,
-			                                        _call.ioctl.arg);
+			call.result.err = _socket(call)->ops->ioctl(_socket(call),
+			                                            call.ioctl.request,
+			                                            call.ioctl.arg);
 		}
 
-		void _do_listen()
+		void _do_listen(Call &call)
 		{
-			_result.err = call_socket()->ops->listen(call_socket(),
-			                                         _call.listen.backlog);
+			call.result.err = _socket(call)->ops->listen(_socket(call),
+			                                             call.listen.backlog);
 		}
 
-		void _do_poll()
+		void _do_poll(Call &call)
 		{
 			using namespace Linux;
-			struct socket *sock = call_socket();
+			struct socket *sock = _socket(call);
 			enum {
 				POLLIN_SET  = (POLLRDNORM | POLLRDBAND | POLLIN | POLLHUP | POLLERR),
 				POLLOUT_SET = (POLLWRBAND | POLLWRNORM | POLLOUT | POLLERR),
@@ -283,20 +431,20 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 			/*
 			 * Set socket wait queue to one so we can block poll in 'tcp_poll -> poll_wait'
 			 */
-			set_sock_wait(sock, _call.poll.block ? 1 : 0);
+			set_sock_wait(sock, call.poll.block ? 1 : 0);
 			int mask = sock->ops->poll(&f, sock, 0);
 			set_sock_wait(sock, 0);
 
-			_result.err = 0;
+			call.result.err = 0;
 			if (mask & POLLIN_SET)
-				_result.err |= Lxip::POLLIN;
+				call.result.err |= Lxip::POLLIN;
 			if (mask & POLLOUT_SET)
-				_result.err |= Lxip::POLLOUT;
+				call.result.err |= Lxip::POLLOUT;
 			if (mask & POLLEX_SET)
-				_result.err |= Lxip::POLLEX;
+				call.result.err |= Lxip::POLLEX;
 		}
 
-		void _do_recv()
+		void _do_recv(Call &call)
 		{
 			using namespace Linux;
 			struct msghdr msg;
@@ -306,86 +454,115 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 			msg.msg_controllen   = 0;
 			msg.msg_iter.iov     = &iov;
 			msg.msg_iter.nr_segs = 1;
-			msg.msg_iter.count   = _call.msg.len;
+			msg.msg_iter.count   = call.msg.len;
 
-			iov.iov_len        = _call.msg.len;
-			iov.iov_base       = _call.msg.buf;
-			msg.msg_name       = _call.addr_len ? &_call.addr : 0;
-			msg.msg_namelen    = _call.addr_len;
+			iov.iov_len        = call.msg.len;
+			iov.iov_base       = call.msg.buf;
+			msg.msg_name       = call.addr_len ? &call.addr : 0;
+			msg.msg_namelen    = call.addr_len;
 			msg.msg_flags      = 0;
 
-			if (_call.handle.non_block)
+			if (call.handle.non_block)
 				msg.msg_flags |= MSG_DONTWAIT;
 
 			//XXX: check for non-blocking flag
-			_result.len = call_socket()->ops->recvmsg(call_socket(), &msg,
-			                                          _call.msg.len,
-			                                          _call.msg.flags);
+			call.result.len = _socket(call)->ops->recvmsg(_socket(call), &msg,
+			                                              call.msg.len,
+			                                              call.msg.flags);
 
-			if (_call.msg.addr) {
-				*_call.msg.addr_len = min(*_call.msg.addr_len, msg.msg_namelen);
-				Genode::memcpy(_call.msg.addr, &_call.addr, *_call.msg.addr_len);
+			if (call.msg.addr) {
+				*call.msg.addr_len = min(*call.msg.addr_len, msg.msg_namelen);
+				Genode::memcpy(call.msg.addr, &call.addr, *call.msg.addr_len);
 			}
 		}
 
-		void _do_send()
+		void _do_send(Call &call)
 		{
 			using namespace Linux;
 			struct msghdr msg;
 			struct iovec  iov;
 
-			_result.len = socket_check_state(call_socket());
-			if (_result.len < 0)
+			call.result.len = socket_check_state(_socket(call));
+			if (call.result.len < 0)
 				return;
 
 			msg.msg_control      = nullptr;
 			msg.msg_controllen   = 0;
 			msg.msg_iter.iov     = &iov;
 			msg.msg_iter.nr_segs = 1;
-			msg.msg_iter.count   = _call.msg.len;
+			msg.msg_iter.count   = call.msg.len;
 
-			iov.iov_len        = _call.msg.len;
-			iov.iov_base       = _call.msg.buf;
-			msg.msg_name       = _call.addr_len ? &_call.addr : 0;
-			msg.msg_namelen    = _call.addr_len;
-			msg.msg_flags      = _call.msg.flags;
+			iov.iov_len        = call.msg.len;
+			iov.iov_base       = call.msg.buf;
+			msg.msg_name       = call.addr_len ? &call.addr : 0;
+			msg.msg_namelen    = call.addr_len;
+			msg.msg_flags      = call.msg.flags;
 
-			if (_call.handle.non_block)
+			if (call.handle.non_block)
 				msg.msg_flags |= MSG_DONTWAIT;
 
-			_result.len = call_socket()->ops->sendmsg(call_socket(), &msg,
-			                                          _call.msg.len);
+			call.result.len = _socket(call)->ops->sendmsg(_socket(call), &msg,
+			                                              call.msg.len);
 		}
 
-		void _do_setopt()
+		void _do_setopt(Call &call)
 		{
-			_result.err = Linux::sock_setsockopt(call_socket(), _call.sockopt.level,
-			                                     _call.sockopt.optname,
-			                                     (char *)_call.sockopt.optval,
-			                                     _call.sockopt.optlen);
+			call.result.err = Linux::sock_setsockopt(_socket(call), call.sockopt.level,
+			                                         call.sockopt.optname,
+			                                         (char *)call.sockopt.optval,
+			                                         call.sockopt.optlen);
 		}
 
-		void _do_shutdown()
+		void _do_shutdown(Call &call)
 		{
-			_result.err = call_socket()->ops->shutdown(call_socket(),
-			                                            _call.shutdown.how);
+			call.result.err = _socket(call)->ops->shutdown(_socket(call),
+			                                               call.shutdown.how);
 		}
 
-		void _do_socket()
+		void _do_socket(Call &call)
 		{
 			using namespace Linux;
-			int type = _call.socket.type == Lxip::TYPE_STREAM ? SOCK_STREAM  :
-			                                                    SOCK_DGRAM;
+			int type = call.socket.type == Lxip::TYPE_STREAM ? SOCK_STREAM  :
+			                                                   SOCK_DGRAM;
 
 			struct socket *s = sock_alloc();
 
 			if (sock_create_kern(nullptr, AF_INET, type, 0, &s)) {
-				_handle.socket = 0;
+				call.new_handle.socket = 0;
 				kfree(s);
 				return;
 			}
 
-			_handle.socket = static_cast<void *>(s);
+			call.new_handle.socket = static_cast<void *>(s);
+		}
+
+		void _execute(Call &call)
+		{
+			if (verbose)
+				PDBG("SOCKET dispatch %u", call.opcode);
+
+			switch (call.opcode) {
+
+				case OP_ACCEPT   : _do_accept(call);     break;
+				case OP_BIND     : _do_bind(call);       break;
+				case OP_CLOSE    : _do_close(call);      break;
+				case OP_CONNECT  : _do_connect(call);    break;
+				case OP_GETNAME  : _do_getname(call, 0); break;
+				case OP_GETOPT   : _do_getopt(call);     break;
+				case OP_IOCTL    : _do_ioctl(call);      break;
+				case OP_PEERNAME : _do_getname(call, 1); break;
+				case OP_LISTEN   : _do_listen(call);     break;
+				case OP_POLL     : _do_poll(call);       break;
+				case OP_RECV     : _do_recv(call);       break;
+				case OP_SEND     : _do_send(call);       break;
+				case OP_SETOPT   : _do_setopt(call);     break;
+				case OP_SHUTDOWN : _do_shutdown(call);   break;
+				case OP_SOCKET   : _do_socket(call);     break;
+
+				default:
+					call.new_handle.socket = 0;
+					PWRN("Unkown opcode: %u\n", call.opcode);
+			}
 		}
 
 	public:
@@ -406,6 +583,8 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 			while (true) {
 				Genode::Signal s = _sig_rec.wait_for_signal();
 				static_cast<Genode::Signal_dispatcher_base *>(s.context())->dispatch(s.num());
+
+				_schedule();
 			}
 		}
 
@@ -413,36 +592,10 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 		 ** Signal dispatcher **
 		 ***********************/
 
-		void dispatch(unsigned num)
-		{
-			if (verbose)
-				PDBG("SOCKET dispatch %u", _call.opcode);
-
-			switch (_call.opcode) {
-
-				case OP_ACCEPT   : _do_accept();   break;
-				case OP_BIND     : _do_bind();     break;
-				case OP_CLOSE    : _do_close();    break;
-				case OP_CONNECT  : _do_connect();  break;
-				case OP_GETNAME  : _do_getname(0); break;
-				case OP_GETOPT   : _do_getopt();   break;
-				case OP_IOCTL    : _do_ioctl();    break;
-				case OP_PEERNAME : _do_getname(1); break;
-				case OP_LISTEN   : _do_listen();   break;
-				case OP_POLL     : _do_poll();     break;
-				case OP_RECV     : _do_recv();     break;
-				case OP_SEND     : _do_send();     break;
-				case OP_SETOPT   : _do_setopt();   break;
-				case OP_SHUTDOWN : _do_shutdown(); break;
-				case OP_SOCKET   : _do_socket();   break;
-
-				default:
-					_handle.socket = 0;
-					PWRN("Unkown opcode: %u\n", _call.opcode);
-			}
-
-			_unblock();
-		}
+		/*
+		 * Queued calls are picked up by '_schedule'
+		 */
+		void dispatch(unsigned) { }
 
 
 		/**************************
@@ -451,186 +604,201 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 
 		Lxip::Handle accept(Lxip::Handle h, void *addr, Lxip::uint32_t *len)
 		{
-			_call.opcode      = OP_ACCEPT;
-			_call.handle      = h;
-			_call.accept.addr = addr;
-			_call.accept.len  = len;
+			Call call;
+			call.opcode      = OP_ACCEPT;
+			call.handle      = h;
+			call.accept.addr = addr;
+			call.accept.len  = len;
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _handle;
+			return call.new_handle;
 		}
 
 		int bind(Lxip::Handle h, Lxip::uint16_t family, void *addr)
 		{
-			_call.opcode   = OP_BIND;
-			_call.handle   = h;
-			_call.addr_len = _family_handler(family, addr);
+			Call call;
+			call.opcode   = OP_BIND;
+			call.handle   = h;
+			call.addr_len = _family_handler(call, family, addr);
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _result.err;
+			return call.result.err;
 		}
 
 		void close(Lxip::Handle h)
 		{
-			_call.opcode = OP_CLOSE;
-			_call.handle = h;
+			Call call;
+			call.opcode = OP_CLOSE;
+			call.handle = h;
 
-			_submit_and_block();
+			_submit_and_block(call);
 		}
 
 		int connect(Lxip::Handle h, Lxip::uint16_t family, void *addr)
 		{
-			_call.opcode   = OP_CONNECT;
-			_call.handle   = h;
-			_call.addr_len = _family_handler(family, addr);
+			Call call;
+			call.opcode   = OP_CONNECT;
+			call.handle   = h;
+			call.addr_len = _family_handler(call, family, addr);
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _result.err;
+			return call.result.err;
 		}
 
 		int getpeername(Lxip::Handle h, void *addr, Lxip::uint32_t *len)
 		{
-			_call.opcode      = OP_PEERNAME;
-			_call.handle      = h;
-			_call.accept.len  = len;
-			_call.accept.addr = addr;
+			Call call;
+			call.opcode      = OP_PEERNAME;
+			call.handle      = h;
+			call.accept.len  = len;
+			call.accept.addr = addr;
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _result.err;
+			return call.result.err;
 		}
 
 		int getsockname(Lxip::Handle h, void *addr, Lxip::uint32_t *len)
 		{
-			_call.opcode      = OP_GETNAME;
-			_call.handle      = h;
-			_call.accept.len  = len;
-			_call.accept.addr = addr;
+			Call call;
+			call.opcode      = OP_GETNAME;
+			call.handle      = h;
+			call.accept.len  = len;
+			call.accept.addr = addr;
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _result.err;
+			return call.result.err;
 		}
 
 		int getsockopt(Lxip::Handle h, int level, int optname,
 		               void *optval, int *optlen)
 		{
-			_call.opcode             = OP_GETOPT;
-			_call.handle             = h;
-			_call.sockopt.level      = level;
-			_call.sockopt.optname    = optname;
-			_call.sockopt.optval     = optval;
-			_call.sockopt.optlen_ptr = optlen;
+			Call call;
+			call.opcode             = OP_GETOPT;
+			call.handle             = h;
+			call.sockopt.level      = level;
+			call.sockopt.optname    = optname;
+			call.sockopt.optval     = optval;
+			call.sockopt.optlen_ptr = optlen;
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _result.err;
+			return call.result.err;
 		}
 
 		int ioctl(Lxip::Handle h, int request, char *arg)
 		{
-			_call.opcode        = OP_IOCTL;
-			_call.handle        = h;
-			_call.ioctl.request = request;
-			_call.ioctl.arg     = (unsigned long)arg;
+			Call call;
+			call.opcode        = OP_IOCTL;
+			call.handle        = h;
+			call.ioctl.request = request;
+			call.ioctl.arg     = (unsigned long)arg;
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _result.err;
+			return call.result.err;
 		}
 
 		int listen(Lxip::Handle h, int backlog)
 		{
-			_call.opcode         = OP_LISTEN;
-			_call.handle         = h;
-			_call.listen.backlog = backlog;
+			Call call;
+			call.opcode         = OP_LISTEN;
+			call.handle         = h;
+			call.listen.backlog = backlog;
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _result.err;
+			return call.result.err;
 		}
 
 		int poll(Lxip::Handle h, bool block)
 		{
-			_call.opcode     = OP_POLL;
-			_call.handle     = h;
-			_call.poll.block = block;
+			Call call;
+			call.opcode     = OP_POLL;
+			call.handle     = h;
+			call.poll.block = block;
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _result.err;
+			return call.result.err;
 		}
 
 		Lxip::ssize_t recv(Lxip::Handle h, void *buf, Lxip::size_t len, int flags,
 		                   Lxip::uint16_t family, void *addr,
 		                   Lxip::uint32_t *addr_len)
 		{
-			_call.opcode       = OP_RECV;
-			_call.handle       = h;
-			_call.msg.buf      = buf;
-			_call.msg.len      = len;
-			_call.msg.addr     = addr;
-			_call.msg.addr_len = addr_len;
-			_call.msg.flags    = flags;
-			_call.addr_len     = _family_handler(family, addr);
+			Call call;
+			call.opcode       = OP_RECV;
+			call.handle       = h;
+			call.msg.buf      = buf;
+			call.msg.len      = len;
+			call.msg.addr     = addr;
+			call.msg.addr_len = addr_len;
+			call.msg.flags    = flags;
+			call.addr_len     = _family_handler(call, family, addr);
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _result.len;
+			return call.result.len;
 		}
 
 		Lxip::ssize_t send(Lxip::Handle h, const void *buf, Lxip::size_t len, int flags,
 		                   Lxip::uint16_t family, void *addr)
 		{
-			_call.opcode     = OP_SEND;
-			_call.handle     = h;
-			_call.msg.buf    = (void *)buf;
-			_call.msg.len    = len;
-			_call.msg.flags  = flags;
-			_call.addr_len   = _family_handler(family, addr);
+			Call call;
+			call.opcode     = OP_SEND;
+			call.handle     = h;
+			call.msg.buf    = (void *)buf;
+			call.msg.len    = len;
+			call.msg.flags  = flags;
+			call.addr_len   = _family_handler(call, family, addr);
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _result.len;
+			return call.result.len;
 		}
 
 		int setsockopt(Lxip::Handle h, int level, int optname,
 		               const void *optval, Lxip::uint32_t optlen)
 		{
-			_call.opcode          = OP_SETOPT,
-			_call.handle          = h;
-			_call.sockopt.level   = level;
-			_call.sockopt.optname = optname;
-			_call.sockopt.optval  = optval;
-			_call.sockopt.optlen  = optlen;
+			Call call;
+			call.opcode          = OP_SETOPT;
+			call.handle          = h;
+			call.sockopt.level   = level;
+			call.sockopt.optname = optname;
+			call.sockopt.optval  = optval;
+			call.sockopt.optlen  = optlen;
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _result.err;
+			return call.result.err;
 		}
 
 		int shutdown(Lxip::Handle h, int how)
 		{
-			_call.opcode       = OP_SHUTDOWN;
-			_call.handle       = h;
-			_call.shutdown.how = how;
+			Call call;
+			call.opcode       = OP_SHUTDOWN;
+			call.handle       = h;
+			call.shutdown.how = how;
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _result.err;
+			return call.result.err;
 		}
 
 		Lxip::Handle socket(Lxip::Type type)
 		{
-			_call.opcode      = OP_SOCKET;
-			_call.socket.type = type;
+			Call call;
+			call.opcode      = OP_SOCKET;
+			call.socket.type = type;
 
-			_submit_and_block();
+			_submit_and_block(call);
 
-			return _handle;
+			return call.new_handle;
 		}
 };
 
@@ -300,6 +300,9 @@ void update_jiffies()
 }
 
 
+void Lx::timer_update_jiffies() { update_jiffies(); }
+
+
 /*******************
  ** linux/timer.h **
  *******************/
@@ -74,6 +74,17 @@ class Backend : public Hard_context_thread
 			return !!_pending()->first();
 		}
 
+		/**
+		 * Return true if flushes can be requested via the packet stream
+		 *
+		 * Otherwise, the blocking sync RPC is used, which stalls the
+		 * processing of all requests.
+		 */
+		bool _sync_packets()
+		{
+			return _blk_ops.supported(Block::Packet_descriptor::SYNC);
+		}
+
 		Packet *_find(Block::Packet_descriptor &packet)
 		{
 			Packet *p = _pending()->first();
@@ -127,7 +138,7 @@ class Backend : public Hard_context_thread
 
 
 				/* sync session if requested  */
-				if (p->sync)
+				if (p->sync && !_sync_packets())
 					_session.sync();
 
 				int dummy;
@@ -178,7 +189,7 @@ class Backend : public Hard_context_thread
 				Packet *p = _dequeue();
 
 				/* zero or sync request */
-				if (!p->cnt) {
+				if (!p->cnt && !(p->sync && _sync_packets())) {
 
 					if (p->sync)
 						_session.sync();
@@ -187,11 +198,20 @@ class Backend : public Hard_context_thread
 					continue;
 				}
 
+				/* sync packets carry no payload but need a packet anyway */
+				Genode::size_t const size = p->cnt ? p->cnt * _blk_size
+				                                   : _blk_size;
+
 				for (bool done = false; !done;)
 					try {
 						Block::Packet_descriptor packet(
-						_session.dma_alloc_packet(p->cnt * _blk_size),
+						_session.dma_alloc_packet(size),
 						                          p->opcode, p->blk, p->cnt);
+
+						/* let synchronous writes bypass the device cache */
+						packet.fua(p->sync && _sync_packets()
+						           && p->opcode == Block::Packet_descriptor::WRITE);
+
 						/* got packet copy data */
 						if (p->opcode == Block::Packet_descriptor::WRITE)
 							Genode::memcpy(_session.tx()->packet_content(packet),
@@ -334,9 +354,12 @@ void rumpuser_bio(int fd, int op, void *data, size_t dlen, int64_t off,
 void rump_io_backend_sync()
 {
 	/* send empty packet with sync request */
-	Packet *p = backend()->alloc();
-	p->cnt    = 0;
-	p->sync   = true;
+	Packet *p  = backend()->alloc();
+	p->opcode  = Block::Packet_descriptor::SYNC;
+	p->blk     = 0;
+	p->cnt     = 0;
+	p->biodone = 0;
+	p->sync    = true;
 	backend()->submit();
 }
 
@@ -2,7 +2,7 @@ TARGET   = decorator
 SRC_CC   = main.cc texture_by_id.cc default_font.h window.cc
 SRC_BIN  = closer.rgba maximize.rgba minimize.rgba windowed.rgba
 SRC_BIN += droidsansb10.tff
-LIBS     = base config server
+LIBS     = base config server blit
 TFF_DIR  = $(call select_from_repositories,src/app/scout/data)
 INC_DIR += $(PRG_DIR)
 
@@ -34,6 +34,7 @@
 #include "libc_file.h"
 #include "libc_mem_alloc.h"
 #include "libc_mmap_registry.h"
+#include "libc_select.h"
 
 using namespace Libc;
 
@@ -240,8 +241,13 @@ extern "C" int chdir(const char *path)
 }
 
 
-extern "C" int _close(int libc_fd) {
-	FD_FUNC_WRAPPER(close, libc_fd); }
+extern "C" int _close(int libc_fd)
+{
+	/* drop the events registered at kqueues for the descriptor */
+	Libc::kqueue_fd_closed(libc_fd);
+
+	FD_FUNC_WRAPPER(close, libc_fd);
+}
 
 
 extern "C" int close(int libc_fd) { return _close(libc_fd); }
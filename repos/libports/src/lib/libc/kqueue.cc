@@ -0,0 +1,714 @@
+/*
+ * \brief  kqueue() and kevent() implementation
+ * \author Genode Labs
+ * \date   2016-07-04
+ *
+ * A kqueue holds the interest set of an event-driven application
+ * persistently. In contrast to 'select', the sets of observed file
+ * descriptors are not rebuilt for each call. Each kqueue keeps track of the
+ * events that may have become ready since they were checked last, and
+ * 'kevent' queries the plugins for these events only.
+ *
+ * File descriptors of the VFS notify individually when they become
+ * readable. Such a notification wakes up only the kqueues that observe the
+ * descriptor. The other plugins invoke the global notification callback,
+ * which does not tell the affected descriptor. It marks the events of all
+ * descriptors without individual notification as pending and wakes up the
+ * kqueues that observe any of those. This includes the 'EVFILT_WRITE'
+ * events of VFS file descriptors, whose write readiness is checked
+ * directly at the VFS.
+ *
+ * When a file descriptor is closed, its events are dropped from all
+ * kqueues.
+ *
+ * Supported are the filters 'EVFILT_READ' and 'EVFILT_WRITE' with the
+ * flags 'EV_ADD', 'EV_DELETE', 'EV_ENABLE', 'EV_DISABLE', 'EV_ONESHOT',
+ * and 'EV_CLEAR'. An edge-triggered ('EV_CLEAR') event is reported once
+ * per notification while its descriptor is ready. For descriptors notified
+ * globally, this includes notifications about other descriptors.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/lock.h>
+#include <util/list.h>
+#include <util/misc_math.h>
+#include <os/timed_semaphore.h>
+
+/* Genode-specific libc interfaces */
+#include <libc-plugin/fd_alloc.h>
+#include <libc-plugin/plugin.h>
+
+/* libc includes */
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/event.h>
+#include <sys/time.h>
+
+/* libc-internal includes */
+#include "libc_file.h"
+#include "libc_select.h"
+
+using namespace Libc;
+
+
+struct Kqueue;
+
+
+/**
+ * Registered event of a kqueue
+ */
+struct Knote : Genode::List<Knote>::Element
+{
+	/**
+	 * Element of the list of knotes of the observed file descriptor
+	 */
+	struct Fd_link : Genode::List<Fd_link>::Element
+	{
+		Knote &knote;
+
+		Fd_link(Knote &knote) : knote(knote) { }
+	};
+
+	Kqueue        &kqueue;
+	struct kevent  event;
+	Fd_link        fd_link { *this };
+
+	bool enabled = true;
+
+	/* descriptor was closed, protected by the notify lock */
+	bool closed = false;
+
+	/* true if the descriptor notifies about its readiness individually */
+	bool const fd_notify;
+
+	/* true if the readiness is checked at the VFS instead of 'select_scan' */
+	bool const vfs;
+
+	Knote(Kqueue &kqueue, struct kevent const &ev, bool fd_notify, bool vfs)
+	: kqueue(kqueue), event(ev), fd_notify(fd_notify), vfs(vfs) { }
+
+	bool matches(struct kevent const &ev) const {
+		return event.ident == ev.ident && event.filter == ev.filter; }
+};
+
+
+/**
+ * Lock protecting the pending events and wakeup state of the kqueues, the
+ * list of kqueues, and the knotes of each file descriptor
+ */
+static Genode::Lock &notify_lock()
+{
+	static Genode::Lock _notify_lock;
+	return _notify_lock;
+}
+
+
+/**
+ * Knotes of all kqueues per file descriptor
+ */
+static Genode::List<Knote::Fd_link> fd_knotes[FD_SETSIZE];
+
+
+static void fd_set_or(fd_set &dst, fd_set const &src)
+{
+	for (unsigned i = 0; i < sizeof(fd_set)/sizeof(dst.__fds_bits[0]); i++)
+		dst.__fds_bits[i] |= src.__fds_bits[i];
+}
+
+
+static void fd_set_and(fd_set &dst, fd_set const &src)
+{
+	for (unsigned i = 0; i < sizeof(fd_set)/sizeof(dst.__fds_bits[0]); i++)
+		dst.__fds_bits[i] &= src.__fds_bits[i];
+}
+
+
+static void fd_set_and_not(fd_set &dst, fd_set const &src)
+{
+	for (unsigned i = 0; i < sizeof(fd_set)/sizeof(dst.__fds_bits[0]); i++)
+		dst.__fds_bits[i] &= ~src.__fds_bits[i];
+}
+
+
+/**
+ * Kqueue, referred to by the context of a kqueue file descriptor
+ */
+struct Kqueue : Plugin_context, Genode::List<Kqueue>::Element
+{
+	Genode::Lock         lock;
+	Genode::List<Knote>  knotes;
+
+	/* interest sets of all enabled events */
+	fd_set readfds;
+	fd_set writefds;
+	int    nfds = 0;
+
+	/* write interest set of VFS descriptors, not passed to 'select_scan' */
+	fd_set vfs_writefds;
+
+	/*
+	 * Interest sets of enabled events without per-descriptor notification,
+	 * protected by the notify lock
+	 */
+	fd_set global_readfds;
+	fd_set global_writefds;
+	bool   global = false;
+
+	/* events to be checked by the next 'collect', protected by the notify lock */
+	fd_set pending_readfds;
+	fd_set pending_writefds;
+	bool   pending = false;
+
+	/* knotes of closed descriptors exist, protected by the notify lock */
+	bool closed = false;
+
+	/* used for blocking in 'kevent', protected by the notify lock */
+	Timed_semaphore sem;
+	bool            waiting   = false;
+	bool            signalled = false;
+
+	Kqueue()
+	{
+		FD_ZERO(&readfds);
+		FD_ZERO(&writefds);
+		FD_ZERO(&vfs_writefds);
+		FD_ZERO(&global_readfds);
+		FD_ZERO(&global_writefds);
+		FD_ZERO(&pending_readfds);
+		FD_ZERO(&pending_writefds);
+	}
+
+	~Kqueue()
+	{
+		while (Knote *kn = knotes.first())
+			remove(kn);
+	}
+
+	Knote *lookup(struct kevent const &ev)
+	{
+		Genode::Lock::Guard guard(notify_lock());
+
+		for (Knote *kn = knotes.first(); kn; kn = kn->next())
+			if (!kn->closed && kn->matches(ev))
+				return kn;
+		return 0;
+	}
+
+	void remove(Knote *kn)
+	{
+		{
+			Genode::Lock::Guard guard(notify_lock());
+			if (!kn->closed)
+				fd_knotes[kn->event.ident].remove(&kn->fd_link);
+		}
+		knotes.remove(kn);
+		Genode::destroy(Genode::env()->heap(), kn);
+	}
+
+	/**
+	 * Drop the knotes of closed descriptors
+	 *
+	 * 
+eturn  true if any knote was dropped
+	 */
+	bool purge_closed()
+	{
+		Genode::List<Knote> dropped;
+		{
+			Genode::Lock::Guard guard(notify_lock());
+
+			if (!closed)
+				return false;
+
+			closed = false;
+
+			Knote *next = 0;
+			for (Knote *kn = knotes.first(); kn; kn = next) {
+				next = kn->next();
+				if (kn->closed) {
+					knotes.remove(kn);
+					dropped.insert(kn);
+				}
+			}
+		}
+
+		while (Knote *kn = dropped.first()) {
+			dropped.remove(kn);
+			Genode::destroy(Genode::env()->heap(), kn);
+		}
+		return true;
+	}
+
+	/**
+	 * Wake up the thread blocking in 'kevent', called with the notify lock
+	 */
+	void wakeup()
+	{
+		if (waiting && !signalled) {
+			signalled = true;
+			sem.up();
+		}
+	}
+
+	/**
+	 * Mark event as pending, called with the notify lock held
+	 */
+	void mark_pending(int fd, short filter)
+	{
+		if (filter == EVFILT_READ)  FD_SET(fd, &pending_readfds);
+		if (filter == EVFILT_WRITE) FD_SET(fd, &pending_writefds);
+		pending = true;
+	}
+
+	/**
+	 * Mark events without per-descriptor notification as pending
+	 *
+	 * Called with the notify lock held.
+	 *
+	 * \return  true if the kqueue observes any of these events
+	 */
+	bool mark_global_pending()
+	{
+		if (!global)
+			return false;
+
+		fd_set_or(pending_readfds,  global_readfds);
+		fd_set_or(pending_writefds, global_writefds);
+		pending = true;
+		return true;
+	}
+
+	/**
+	 * Rebuild interest sets after a change of the registered events
+	 */
+	void update_interest()
+	{
+		FD_ZERO(&readfds);
+		FD_ZERO(&writefds);
+		FD_ZERO(&vfs_writefds);
+		nfds = 0;
+
+		Genode::Lock::Guard guard(notify_lock());
+
+		FD_ZERO(&global_readfds);
+		FD_ZERO(&global_writefds);
+		global = false;
+
+		for (Knote *kn = knotes.first(); kn; kn = kn->next()) {
+
+			if (!kn->enabled || kn->closed)
+				continue;
+
+			int const fd = kn->event.ident;
+
+			if (kn->event.filter == EVFILT_READ)  FD_SET(fd, &readfds);
+			if (kn->event.filter == EVFILT_WRITE) FD_SET(fd, &writefds);
+
+			if (kn->vfs && kn->event.filter == EVFILT_WRITE)
+				FD_SET(fd, &vfs_writefds);
+
+			if (!kn->fd_notify) {
+				if (kn->event.filter == EVFILT_READ)  FD_SET(fd, &global_readfds);
+				if (kn->event.filter == EVFILT_WRITE) FD_SET(fd, &global_writefds);
+				global = true;
+			}
+
+			nfds = Genode::max(nfds, fd + 1);
+		}
+	}
+
+	/**
+	 * Apply change to the registered events
+	 *
+	 * \return  0 on success, or errno value
+	 */
+	int apply(struct kevent const &ev)
+	{
+		if (ev.filter != EVFILT_READ && ev.filter != EVFILT_WRITE)
+			return EINVAL;
+
+		if ((int)ev.ident < 0 || ev.ident >= FD_SETSIZE)
+			return EBADF;
+
+		Knote *kn = lookup(ev);
+
+		if (ev.flags & EV_DELETE) {
+			if (!kn)
+				return ENOENT;
+
+			remove(kn);
+			return 0;
+		}
+
+		if (ev.flags & EV_ADD) {
+			if (!kn) {
+				File_descriptor *fd =
+					file_descriptor_allocator()->find_by_libc_fd(ev.ident);
+				if (!fd)
+					return EBADF;
+
+				/*
+				 * The VFS notifies individually only about descriptors
+				 * becoming readable.
+				 */
+				bool const vfs = vfs_fd(fd);
+				bool const fd_notify = vfs && ev.filter == EVFILT_READ
+				                    && vfs_watch_read_ready(fd);
+
+				kn = new (Genode::env()->heap())
+					Knote(*this, ev, fd_notify, vfs);
+				knotes.insert(kn);
+
+				Genode::Lock::Guard guard(notify_lock());
+				fd_knotes[ev.ident].insert(&kn->fd_link);
+			}
+
+			kn->event.flags  = ev.flags & (EV_ONESHOT | EV_CLEAR);
+			kn->event.fflags = ev.fflags;
+			kn->event.udata  = ev.udata;
+			kn->enabled      = true;
+		}
+
+		if (!kn)
+			return ENOENT;
+
+		if (ev.flags & EV_ENABLE)  kn->enabled = true;
+		if (ev.flags & EV_DISABLE) kn->enabled = false;
+
+		/* check the current state of an added or enabled event */
+		if (kn->enabled) {
+			Genode::Lock::Guard guard(notify_lock());
+			mark_pending(kn->event.ident, kn->event.filter);
+		}
+		return 0;
+	}
+
+	/**
+	 * Collect pending events
+	 *
+	 * Only the pending events are checked. Level-triggered events that
+	 * are ready, as well as ready events that do not fit into 'eventlist',
+	 * stay pending.
+	 *
+	 * \return  number of events stored in 'eventlist'
+	 */
+	int collect(struct kevent *eventlist, int nevents)
+	{
+		fd_set in_readfds, in_writefds, in_exceptfds;
+		{
+			Genode::Lock::Guard guard(notify_lock());
+
+			if (!pending)
+				return 0;
+
+			in_readfds  = pending_readfds;
+			in_writefds = pending_writefds;
+
+			FD_ZERO(&pending_readfds);
+			FD_ZERO(&pending_writefds);
+			pending = false;
+		}
+
+		fd_set_and(in_readfds,  readfds);
+		fd_set_and(in_writefds, writefds);
+		FD_ZERO(&in_exceptfds);
+
+		/* descriptors with individual notification are checked by the VFS */
+		fd_set const vfs_readfds  = in_readfds;
+		fd_set const vfs_writefds = in_writefds;
+
+		fd_set_and(in_readfds,  global_readfds);
+		fd_set_and(in_writefds, global_writefds);
+
+		/* write readiness of VFS descriptors is checked at the VFS */
+		fd_set scan_writefds = in_writefds;
+		fd_set_and_not(scan_writefds, vfs_writefds);
+
+		fd_set out_readfds, out_writefds, out_exceptfds;
+
+		select_scan(nfds, &in_readfds, &scan_writefds, &in_exceptfds,
+		            &out_readfds, &out_writefds, &out_exceptfds);
+
+		/* events to be checked again by the next 'collect' */
+		fd_set again_readfds, again_writefds;
+		FD_ZERO(&again_readfds);
+		FD_ZERO(&again_writefds);
+		bool again = false;
+
+		int     num  = 0;
+		bool    drop = false;
+		Knote  *next = 0;
+
+		for (Knote *kn = knotes.first(); kn; kn = next) {
+
+			next = kn->next();
+
+			if (!kn->enabled)
+				continue;
+
+			int  const fd   = kn->event.ident;
+			bool const read = kn->event.filter == EVFILT_READ;
+
+			bool ready = false;
+
+			if (kn->fd_notify)
+				ready = FD_ISSET(fd, read ? &vfs_readfds : &vfs_writefds)
+				        && vfs_ready(fd, read, !read);
+			else if (kn->vfs && !read)
+				ready = FD_ISSET(fd, &in_writefds) && vfs_ready(fd, false, true);
+			else
+				ready = FD_ISSET(fd, read ? &out_readfds : &out_writefds);
+
+			if (!ready)
+				continue;
+
+			fd_set &again_fds = read ? again_readfds : again_writefds;
+
+			if (num == nevents) {
+				FD_SET(fd, &again_fds);
+				again = true;
+				continue;
+			}
+
+			eventlist[num]      = kn->event;
+			eventlist[num].data = 0;
+			num++;
+
+			if (kn->event.flags & EV_ONESHOT) {
+				remove(kn);
+				drop = true;
+				continue;
+			}
+
+			if (!(kn->event.flags & EV_CLEAR)) {
+				FD_SET(fd, &again_fds);
+				again = true;
+			}
+		}
+
+		if (drop)
+			update_interest();
+
+		Genode::Lock::Guard guard(notify_lock());
+
+		fd_set_or(pending_readfds,  again_readfds);
+		fd_set_or(pending_writefds, again_writefds);
+		pending = pending || again;
+
+		return num;
+	}
+};
+
+
+/**
+ * All kqueues, protected by the notify lock
+ */
+static Genode::List<Kqueue> kqueues;
+
+
+void Libc::kqueue_notify()
+{
+	Genode::Lock::Guard guard(notify_lock());
+
+	for (Kqueue *kq = kqueues.first(); kq; kq = kq->next())
+		if (kq->mark_global_pending())
+			kq->wakeup();
+}
+
+
+void Libc::kqueue_fd_closed(int libc_fd)
+{
+	if (libc_fd < 0 || libc_fd >= FD_SETSIZE)
+		return;
+
+	Genode::Lock::Guard guard(notify_lock());
+
+	/*
+	 * The knotes are dropped by their kqueues, which requires the lock of
+	 * the kqueue. Here, they are merely detached from the descriptor so
+	 * that a descriptor reusing the number starts without events.
+	 */
+	while (Knote::Fd_link *l = fd_knotes[libc_fd].first()) {
+		fd_knotes[libc_fd].remove(l);
+		l->knote.closed        = true;
+		l->knote.kqueue.closed = true;
+	}
+}
+
+
+void Libc::kqueue_notify_fd(int libc_fd)
+{
+	if (libc_fd < 0 || libc_fd >= FD_SETSIZE)
+		return;
+
+	Genode::Lock::Guard guard(notify_lock());
+
+	for (Knote::Fd_link *l = fd_knotes[libc_fd].first(); l; l = l->next()) {
+		Knote &kn = l->knote;
+		kn.kqueue.mark_pending(libc_fd, kn.event.filter);
+		kn.kqueue.wakeup();
+	}
+}
+
+
+/**
+ * Plugin responsible for kqueue file descriptors
+ */
+struct Kqueue_plugin : Plugin
+{
+	int close(File_descriptor *fd) override
+	{
+		Kqueue *kq = static_cast<Kqueue *>(fd->context);
+		{
+			Genode::Lock::Guard guard(notify_lock());
+			kqueues.remove(kq);
+		}
+
+		Genode::destroy(Genode::env()->heap(), kq);
+		file_descriptor_allocator()->free(fd);
+		return 0;
+	}
+};
+
+
+static Kqueue_plugin &kqueue_plugin()
+{
+	static Kqueue_plugin _kqueue_plugin;
+	return _kqueue_plugin;
+}
+
+
+extern "C" int
+__attribute__((weak))
+kqueue(void)
+{
+	select_notify_init();
+
+	Kqueue *kq = new (Genode::env()->heap()) Kqueue;
+
+	File_descriptor *fd = file_descriptor_allocator()->alloc(&kqueue_plugin(), kq);
+	if (!fd) {
+		Genode::destroy(Genode::env()->heap(), kq);
+		errno = EMFILE;
+		return -1;
+	}
+
+	Genode::Lock::Guard guard(notify_lock());
+	kqueues.insert(kq);
+
+	return fd->libc_fd;
+}
+
+
+extern "C" int
+__attribute__((weak))
+kevent(int kq_fd, const struct kevent *changelist, int nchanges,
+       struct kevent *eventlist, int nevents, const struct timespec *timeout)
+{
+	File_descriptor *fd = libc_fd_to_fd(kq_fd, "kevent");
+	if (!fd || fd->plugin != &kqueue_plugin()) {
+		errno = EBADF;
+		return -1;
+	}
+
+	Kqueue &kq = *static_cast<Kqueue *>(fd->context);
+
+	int num = 0;
+
+	/* apply changes, report errors via the event list if possible */
+	{
+		Genode::Lock::Guard guard(kq.lock);
+
+		kq.purge_closed();
+
+		for (int i = 0; i < nchanges; i++) {
+
+			int const err = kq.apply(changelist[i]);
+			if (!err && !(changelist[i].flags & EV_RECEIPT))
+				continue;
+
+			if (num == nevents) {
+				if (!err)
+					continue;
+
+				kq.update_interest();
+				errno = err;
+				return -1;
+			}
+
+			eventlist[num]        = changelist[i];
+			eventlist[num].flags |= EV_ERROR;
+			eventlist[num].data   = err;
+			num++;
+		}
+
+		kq.update_interest();
+	}
+
+	if (num > 0 || nevents == 0)
+		return num;
+
+	bool const poll_only = timeout && timeout->tv_sec == 0 && timeout->tv_nsec == 0;
+
+	Genode::Alarm::Time remaining = timeout
+		? timeout->tv_sec*1000 + (timeout->tv_nsec + 999999)/1000000 : 0;
+
+	for (;;) {
+
+		{
+			Genode::Lock::Guard guard(kq.lock);
+
+			if (kq.purge_closed())
+				kq.update_interest();
+
+			num = kq.collect(eventlist, nevents);
+		}
+
+		if (num > 0 || poll_only)
+			return num;
+
+		/* block until notified unless events became pending meanwhile */
+		{
+			Genode::Lock::Guard guard(notify_lock());
+
+			if (kq.pending)
+				continue;
+
+			kq.signalled = false;
+			kq.waiting   = true;
+		}
+
+		bool timed_out = false;
+
+		if (!timeout) {
+			kq.sem.down();
+		} else {
+			try {
+				Genode::Alarm::Time const blocked = kq.sem.down(remaining);
+				remaining = blocked < remaining ? remaining - blocked : 1;
+			} catch (Timeout_exception) {
+				timed_out = true;
+			}
+		}
+
+		{
+			Genode::Lock::Guard guard(notify_lock());
+			kq.waiting = false;
+
+			/* consume wakeup that raced with the timeout */
+			if (timed_out && kq.signalled)
+				timed_out = false;
+		}
+
+		if (timed_out)
+			return 0;
+	}
+}
@@ -0,0 +1,86 @@
+/*
+ * \brief  Interface between the select and kqueue implementations
+ * \author Genode Labs
+ * \date   2016-07-04
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LIBC_SELECT_H_
+#define _LIBC_SELECT_H_
+
+/* libc includes */
+#include <sys/select.h>
+
+namespace Libc {
+
+	struct File_descriptor;
+
+	/**
+	 * Poll plugins for the readiness of the specified file descriptors
+	 *
+	 * The input sets must not be NULL.
+	 *
+	 * \return  number of ready file descriptors
+	 */
+	int select_scan(int nfds, fd_set *in_readfds, fd_set *in_writefds,
+	                fd_set *in_exceptfds, fd_set *out_readfds,
+	                fd_set *out_writefds, fd_set *out_exceptfds);
+
+	/**
+	 * Install the notification callback called by the plugins on events
+	 */
+	void select_notify_init();
+
+	/**
+	 * Wake up threads blocking in 'kevent' on descriptors of plugins
+	 *
+	 * Called from the notification callback, which does not tell the
+	 * affected descriptor. Hence, all registered events of descriptors
+	 * without per-descriptor notification are checked again.
+	 */
+	void kqueue_notify();
+
+	/**
+	 * Wake up threads blocking in 'kevent' on the specified descriptor
+	 *
+	 * Only the kqueues observing 'libc_fd' are woken up, and only the
+	 * events of this descriptor are checked again.
+	 */
+	void kqueue_notify_fd(int libc_fd);
+
+	/**
+	 * Drop the events of a file descriptor that is about to be closed
+	 *
+	 * Called for each 'close' such that a descriptor that reuses the
+	 * number does not inherit the registered events.
+	 */
+	void kqueue_fd_closed(int libc_fd);
+
+	/**
+	 * Return true if 'fd' is served by the VFS plugin
+	 */
+	bool vfs_fd(File_descriptor *fd);
+
+	/**
+	 * Request per-descriptor notifications for a VFS file descriptor
+	 *
+	 * \return  true if 'fd' is served by the VFS plugin, which then calls
+	 *          'kqueue_notify_fd' whenever the file becomes readable
+	 *
+	 * There is no notification about a file becoming writeable.
+	 */
+	bool vfs_watch_read_ready(File_descriptor *fd);
+
+	/**
+	 * Return true if the VFS file descriptor is ready for reading or writing
+	 */
+	bool vfs_ready(int libc_fd, bool rd, bool wr);
+}
+
+#endif /* _LIBC_SELECT_H_ */
@@ -23,6 +23,9 @@
 #include <sys/select.h>
 #include <signal.h>
 
+/* libc-internal includes */
+#include "libc_select.h"
+
 using namespace Libc;
 
 
@@ -58,9 +61,9 @@ static Genode::Lock &select_cb_list_lock()
 
 /* poll plugin select() functions */
 /* input fds may not be NULL */
-static int selscan(int nfds, fd_set *in_readfds, fd_set *in_writefds,
-                   fd_set *in_exceptfds, fd_set *out_readfds,
-                   fd_set *out_writefds, fd_set *out_exceptfds)
+int Libc::select_scan(int nfds, fd_set *in_readfds, fd_set *in_writefds,
+                      fd_set *in_exceptfds, fd_set *out_readfds,
+                      fd_set *out_writefds, fd_set *out_exceptfds)
 {
 	int nready = 0;
 
@@ -128,9 +131,9 @@ static void select_notify()
 				FD_ZERO(&tmp_readfds);
 				FD_ZERO(&tmp_writefds);
 				FD_ZERO(&tmp_exceptfds);
-				nready = selscan(scb->nfds, &scb->readset, &scb->writeset,
-			                     &scb->exceptset, &tmp_readfds, &tmp_writefds,
-			                     &tmp_exceptfds);
+				nready = select_scan(scb->nfds, &scb->readset, &scb->writeset,
+				                     &scb->exceptset, &tmp_readfds, &tmp_writefds,
+				                     &tmp_exceptfds);
 				if (nready > 0)
 					break;
 			}
@@ -149,6 +152,15 @@ static void select_notify()
 			break;
 		}
 	}
+
+	kqueue_notify();
+}
+
+
+void Libc::select_notify_init()
+{
+	if (!libc_select_notify)
+		libc_select_notify = select_notify;
 }
 
 
@@ -165,8 +177,7 @@ select(int nfds, fd_set *readfds, fd_set *writefds,
 	bool timed_out = false;
 
 	/* initialize the select notification function pointer */
-	if (!libc_select_notify)
-		libc_select_notify = select_notify;
+	select_notify_init();
 
 	/* Protect ourselves searching through the list */
 	select_cb_list_lock().lock();
@@ -186,7 +197,7 @@ select(int nfds, fd_set *readfds, fd_set *writefds,
 
 	/* Go through each socket in each list to count number of sockets which
 	   currently match */
-	nready = selscan(nfds, &in_readfds, &in_writefds, &in_exceptfds, readfds, writefds, exceptfds);
+	nready = select_scan(nfds, &in_readfds, &in_writefds, &in_exceptfds, readfds, writefds, exceptfds);
 
 	/* If we don't have any current events, then suspend if we are supposed to */
 	if (!nready) {
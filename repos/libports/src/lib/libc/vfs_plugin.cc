@@ -14,6 +14,7 @@
 /* Genode includes */
 #include <base/env.h>
 #include <base/printf.h>
+#include <base/thread.h>
 #include <vfs/dir_file_system.h>
 #include <os/config.h>
 
@@ -38,6 +39,7 @@
 /* libc-internal includes */
 #include <libc_mem_alloc.h>
 #include "libc_errno.h"
+#include "libc_select.h"
 
 
 static Vfs::Vfs_handle *vfs_handle(Libc::File_descriptor *fd)
@@ -52,6 +54,98 @@ static Libc::Plugin_context *vfs_context(Vfs::Vfs_handle *vfs_handle)
 }
 
 
+namespace {
+
+	typedef Genode::Thread_deprecated<4096> Read_ready_thread;
+
+
+	/**
+	 * Signal context of a VFS file descriptor observed by a kqueue
+	 */
+	struct Read_ready_watch : Genode::Signal_context,
+	                          Genode::List<Read_ready_watch>::Element
+	{
+		int const libc_fd;
+
+		Read_ready_watch(int libc_fd) : libc_fd(libc_fd) { }
+	};
+
+
+	/**
+	 * Thread for receiving notifications about data available for reading
+	 * from VFS file descriptors observed by kqueues
+	 */
+	class Read_ready : Read_ready_thread
+	{
+		private:
+
+			Genode::Signal_receiver        _sig_rec;
+			Genode::Lock                   _watches_lock;
+			Genode::List<Read_ready_watch> _watches;
+
+			void entry()
+			{
+				for (;;) {
+					Genode::Signal sig = _sig_rec.wait_for_signal();
+
+					Read_ready_watch *watch =
+						static_cast<Read_ready_watch *>(sig.context());
+
+					Libc::kqueue_notify_fd(watch->libc_fd);
+				}
+			}
+
+		public:
+
+			Read_ready() : Read_ready_thread("vfs_read_ready") { start(); }
+
+			void watch(int libc_fd, Vfs::Vfs_handle *handle)
+			{
+				Genode::Lock::Guard guard(_watches_lock);
+
+				for (Read_ready_watch *w = _watches.first(); w; w = w->next())
+					if (w->libc_fd == libc_fd)
+						return;
+
+				Read_ready_watch *w =
+					new (Genode::env()->heap()) Read_ready_watch(libc_fd);
+				_watches.insert(w);
+
+				handle->fs().register_read_ready_sigh(handle, _sig_rec.manage(w));
+			}
+
+			void unwatch(int libc_fd)
+			{
+				Genode::Lock::Guard guard(_watches_lock);
+
+				for (Read_ready_watch *w = _watches.first(); w; w = w->next()) {
+					if (w->libc_fd != libc_fd)
+						continue;
+
+					_sig_rec.dissolve(w);
+					_watches.remove(w);
+					Genode::destroy(Genode::env()->heap(), w);
+					return;
+				}
+			}
+	};
+
+
+	/**
+	 * Return singleton instance of 'Read_ready', started on first use
+	 */
+	static Read_ready &read_ready()
+	{
+		static Read_ready inst;
+		return inst;
+	}
+
+
+	/* set once the watch thread exists, checked on close */
+	bool read_ready_started = false;
+}
+
+
 /**
  * Utility to convert VFS stat struct to the libc stat struct
  *
@@ -332,6 +426,10 @@ Libc::File_descriptor *Libc::Vfs_plugin::open(char const *path, int flags,
 int Libc::Vfs_plugin::close(Libc::File_descriptor *fd)
 {
 	Vfs::Vfs_handle *handle = vfs_handle(fd);
+
+	if (read_ready_started)
+		read_ready().unwatch(fd->libc_fd);
+
 	handle->ds().close(handle);
 	Libc::file_descriptor_allocator()->free(fd);
 	return 0;
@@ -859,7 +957,41 @@ int Libc::Vfs_plugin::munmap(void *addr, ::size_t)
 }
 
 
+static Libc::Plugin *vfs_plugin;
+
+
+bool Libc::vfs_fd(Libc::File_descriptor *fd)
+{
+	return vfs_plugin && fd->plugin == vfs_plugin;
+}
+
+
+bool Libc::vfs_watch_read_ready(Libc::File_descriptor *fd)
+{
+	if (!vfs_fd(fd))
+		return false;
+
+	read_ready_started = true;
+	read_ready().watch(fd->libc_fd, vfs_handle(fd));
+	return true;
+}
+
+
+bool Libc::vfs_ready(int libc_fd, bool rd, bool wr)
+{
+	Libc::File_descriptor *fd =
+		Libc::file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+
+	if (!fd || !vfs_plugin || fd->plugin != vfs_plugin)
+		return false;
+
+	Vfs::Vfs_handle *handle = vfs_handle(fd);
+	return handle->fs().check_unblock(handle, rd, wr, false);
+}
+
+
 void __attribute__((constructor)) init_libc_vfs(void)
 {
 	static Libc::Vfs_plugin plugin;
+	vfs_plugin = &plugin;
 }
@@ -49,8 +49,41 @@ class Nic_receiver_thread : public Genode::Thread_deprecated<8192>
 
 		typedef Nic::Packet_descriptor Packet_descriptor;
 
+		/*
+		 * Custom pbuf that refers to a packet of the RX packet stream
+		 *
+		 * Received packets are handed over to lwIP without copying them.
+		 * The packet is acknowledged not before lwIP frees the pbuf, which
+		 * may happen in the context of any thread using lwIP. Because only
+		 * the receiver thread gets notified about free space in the ack
+		 * queue, freed pbufs are queued and acknowledged by the receiver.
+		 */
+		struct Rx_pbuf
+		{
+			struct pbuf_custom   custom;
+			Packet_descriptor    packet;
+			Nic_receiver_thread *thread     = nullptr;
+			Rx_pbuf             *next_freed = nullptr;
+			bool                 used       = false;
+		};
+
+		/*
+		 * Packets held by lwIP, e.g., in the receive queue of a socket, keep
+		 * occupying the RX packet buffer. To prevent lwIP from exhausting
+		 * the buffer, we limit the number and the total size of those
+		 * packets. Beyond the limits, packets are copied into pool pbufs.
+		 */
+		enum { MAX_RX_PBUFS = 64 };
+
+		Rx_pbuf             _rx_pbufs[MAX_RX_PBUFS];
+		Genode::Lock        _rx_pbuf_lock;
+		Rx_pbuf            *_freed_rx_pbufs = nullptr;
+		Genode::size_t      _rx_pinned = 0;
+		Genode::size_t const _rx_pin_limit;
+
 		Nic::Connection  *_nic;       /* nic-session */
 		Packet_descriptor _rx_packet; /* actual packet received */
+		bool              _rx_packet_referenced = false;
 		struct netif     *_netif;     /* LwIP network interface structure */
 
 		Genode::Signal_receiver  _sig_rec;
@@ -58,16 +91,60 @@ class Nic_receiver_thread : public Genode::Thread_deprecated<8192>
 		Genode::Signal_dispatcher<Nic_receiver_thread> _link_state_dispatcher;
 		Genode::Signal_dispatcher<Nic_receiver_thread> _rx_packet_avail_dispatcher;
 		Genode::Signal_dispatcher<Nic_receiver_thread> _rx_ready_to_ack_dispatcher;
+		Genode::Signal_dispatcher<Nic_receiver_thread> _rx_pbuf_freed_dispatcher;
+
+		/**
+		 * Acknowledge packets of freed pbufs as long as the ack queue has space
+		 */
+		void _ack_freed_rx_pbufs()
+		{
+			Genode::Lock::Guard guard(_rx_pbuf_lock);
+
+			while (_freed_rx_pbufs && _nic->rx()->ready_to_ack()) {
+
+				Rx_pbuf &rx_pbuf = *_freed_rx_pbufs;
+				_freed_rx_pbufs  = rx_pbuf.next_freed;
+
+				_nic->rx()->acknowledge_packet(rx_pbuf.packet);
+
+				_rx_pinned  -= rx_pbuf.packet.size();
+				rx_pbuf.used = false;
+			}
+		}
 
 		void _handle_rx_packet_avail(unsigned)
 		{
+			_ack_freed_rx_pbufs();
+
 			while (_nic->rx()->packet_avail() && _nic->rx()->ready_to_ack()) {
-				_rx_packet = _nic->rx()->get_packet();
+				_rx_packet            = _nic->rx()->get_packet();
+				_rx_packet_referenced = false;
+
 				genode_netif_input(_netif);
-				_nic->rx()->acknowledge_packet(_rx_packet);
+
+				/* packets referenced by a pbuf are acknowledged on free */
+				if (!_rx_packet_referenced)
+					_nic->rx()->acknowledge_packet(_rx_packet);
 			}
 		}
 
+		static void _free_rx_pbuf(struct pbuf *p)
+		{
+			Rx_pbuf             *rx_pbuf = reinterpret_cast<Rx_pbuf *>(p);
+			Nic_receiver_thread &thread  = *rx_pbuf->thread;
+
+			{
+				Genode::Lock::Guard guard(thread._rx_pbuf_lock);
+				rx_pbuf->next_freed    = thread._freed_rx_pbufs;
+				thread._freed_rx_pbufs = rx_pbuf;
+			}
+
+			/* let the receiver thread acknowledge the packet */
+			Genode::Signal_transmitter(thread._rx_pbuf_freed_dispatcher).submit();
+		}
+
+		void _handle_rx_pbuf_freed(unsigned) { _handle_rx_packet_avail(0); }
+
 		void _handle_rx_read_to_ack(unsigned) { _handle_rx_packet_avail(0); }
 
 		void _handle_link_state(unsigned)
@@ -87,12 +164,15 @@ class Nic_receiver_thread : public Genode::Thread_deprecated<8192>
 
 	public:
 
-		Nic_receiver_thread(Nic::Connection *nic, struct netif *netif)
+		Nic_receiver_thread(Nic::Connection *nic, struct netif *netif,
+		                    Genode::size_t rx_buf_size)
 		:
-			Genode::Thread_deprecated<8192>("nic-recv"), _nic(nic), _netif(netif),
+			Genode::Thread_deprecated<8192>("nic-recv"),
+			_rx_pin_limit(rx_buf_size/2), _nic(nic), _netif(netif),
 			_link_state_dispatcher(_sig_rec, *this, &Nic_receiver_thread::_handle_link_state),
 			_rx_packet_avail_dispatcher(_sig_rec, *this, &Nic_receiver_thread::_handle_rx_packet_avail),
-			_rx_ready_to_ack_dispatcher(_sig_rec, *this, &Nic_receiver_thread::_handle_rx_read_to_ack)
+			_rx_ready_to_ack_dispatcher(_sig_rec, *this, &Nic_receiver_thread::_handle_rx_read_to_ack),
+			_rx_pbuf_freed_dispatcher(_sig_rec, *this, &Nic_receiver_thread::_handle_rx_pbuf_freed)
 		{
 			_nic->link_state_sigh(_link_state_dispatcher);
 			_nic->rx_channel()->sigh_packet_avail(_rx_packet_avail_dispatcher);
@@ -103,6 +183,44 @@ class Nic_receiver_thread : public Genode::Thread_deprecated<8192>
 		Nic::Connection  *nic() { return _nic; };
 		Packet_descriptor rx_packet() { return _rx_packet; };
 
+		/**
+		 * Return pbuf that refers to the current RX packet
+		 *
+		 * \return  pbuf, or 0 if the packet must be copied
+		 */
+		struct pbuf *rx_packet_pbuf()
+		{
+			Rx_pbuf *rx_pbuf = nullptr;
+			{
+				Genode::Lock::Guard guard(_rx_pbuf_lock);
+
+				if (_rx_pinned + _rx_packet.size() > _rx_pin_limit)
+					return 0;
+
+				for (unsigned i = 0; i < MAX_RX_PBUFS && !rx_pbuf; i++)
+					if (!_rx_pbufs[i].used)
+						rx_pbuf = &_rx_pbufs[i];
+
+				if (!rx_pbuf)
+					return 0;
+
+				rx_pbuf->used  = true;
+				_rx_pinned    += _rx_packet.size();
+			}
+
+			rx_pbuf->packet = _rx_packet;
+			rx_pbuf->thread = this;
+			rx_pbuf->custom.custom_free_function = _free_rx_pbuf;
+
+			u16_t const len = _rx_packet.size();
+			struct pbuf *p = pbuf_alloced_custom(PBUF_RAW, len, PBUF_REF,
+			                                     &rx_pbuf->custom,
+			                                     _nic->rx()->packet_content(_rx_packet),
+			                                     len);
+			_rx_packet_referenced = true;
+			return p;
+		}
+
 		Packet_descriptor alloc_tx_packet(Genode::size_t size)
 		{
 			while (true) {
@@ -199,6 +317,13 @@ extern "C" {
 
 #if ETH_PAD_SIZE
 		len += ETH_PAD_SIZE; /* allow room for Ethernet padding */
+#else
+		/* hand over the packet without copying if possible */
+		struct pbuf *rx_pbuf = th->rx_packet_pbuf();
+		if (rx_pbuf) {
+			LINK_STATS_INC(link.recv);
+			return rx_pbuf;
+		}
 #endif
 
 		/* We allocate a pbuf chain of pbufs from the pool. */
@@ -295,7 +420,7 @@ extern "C" {
 
 		/* Setup receiver thread */
 		Nic_receiver_thread *th = new (env()->heap())
-			Nic_receiver_thread(nic, netif);
+			Nic_receiver_thread(nic, netif, nbs->rx_buf_size);
 
 		/* Store receiver thread address in user-defined netif struct part */
 		netif->state      = (void*) th;
@@ -171,6 +171,14 @@ extern "C" {
 			vformat->Gmask = 0x000007e0;
 			vformat->Bmask = 0x0000001f;
 			break;
+		case Framebuffer::Mode::XRGB8888:
+			PDBG("We use pixelformat xrgb8888.");
+			vformat->BitsPerPixel  = 32;
+			vformat->BytesPerPixel = scr_mode.bytes_per_pixel();
+			vformat->Rmask = 0x00ff0000;
+			vformat->Gmask = 0x0000ff00;
+			vformat->Bmask = 0x000000ff;
+			break;
 		default:
 			SDL_SetError("Couldn't get console mode info");
 			Genode_Fb_VideoQuit(t);
@@ -201,7 +209,7 @@ extern "C" {
 	                               SDL_PixelFormat *format,
 	                               Uint32 flags)
 	{
-		if(format->BitsPerPixel != 16)
+		if(format->BitsPerPixel != scr_mode.bytes_per_pixel()*8)
 			return (SDL_Rect **) 0;
 		return modes;
 	}
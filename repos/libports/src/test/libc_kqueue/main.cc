@@ -0,0 +1,176 @@
+/*
+ * \brief  kqueue test
+ * \author Genode Labs
+ * \date   2016-07-04
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* libc includes */
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/event.h>
+#include <sys/time.h>
+
+
+static int pipefd[2];
+
+static volatile bool writer_finished = false;
+
+
+static void *write_pipe(void *)
+{
+	/* give the main thread the chance to block in 'kevent' */
+	usleep(100*1000);
+
+	char c = 'x';
+	if (write(pipefd[1], &c, 1) != 1) {
+		fprintf(stderr, "Error writing to pipe\n");
+		exit(1);
+	}
+
+	writer_finished = true;
+	return 0;
+}
+
+
+static void check(bool condition, char const *what)
+{
+	if (condition) {
+		printf("%s\n", what);
+		return;
+	}
+
+	fprintf(stderr, "Error: %s failed\n", what);
+	exit(1);
+}
+
+
+static int change(int kq, int fd, short filter, unsigned short flags)
+{
+	struct kevent ev;
+	EV_SET(&ev, fd, filter, flags, 0, 0, 0);
+	return kevent(kq, &ev, 1, 0, 0, 0);
+}
+
+
+static int wait(int kq, struct kevent *ev, int nevents, long timeout_ms)
+{
+	struct timespec timeout = { timeout_ms / 1000, (timeout_ms % 1000)*1000*1000 };
+	return kevent(kq, 0, 0, ev, nevents, &timeout);
+}
+
+
+int main(int argc, char *argv[])
+{
+	struct kevent ev[4];
+	char c;
+
+	check(pipe(pipefd) == 0, "pipe created");
+
+	int const kq = kqueue();
+	check(kq >= 0, "kqueue created");
+
+	/* level-triggered read event */
+	check(change(kq, pipefd[0], EVFILT_READ, EV_ADD) == 0, "read event added");
+	check(wait(kq, ev, 4, 0) == 0, "empty pipe not readable");
+
+	pthread_t tid;
+	pthread_create(&tid, 0, write_pipe, 0);
+
+	check(wait(kq, ev, 4, 2000) == 1 && (int)ev[0].ident == pipefd[0]
+	      && ev[0].filter == EVFILT_READ, "woken up by write to pipe");
+
+	/* pthread_join() is not implemented at this time */
+	while (!writer_finished) { }
+
+	check(wait(kq, ev, 4, 0) == 1, "level-triggered event reported again");
+	check(read(pipefd[0], &c, 1) == 1, "byte read");
+	check(wait(kq, ev, 4, 0) == 0, "drained pipe not readable");
+	check(wait(kq, ev, 4, 100) == 0, "timeout without event");
+
+	/* edge-triggered read event */
+	check(change(kq, pipefd[0], EVFILT_READ, EV_ADD | EV_CLEAR) == 0,
+	      "read event changed to edge-triggered");
+	c = 'y';
+	check(write(pipefd[1], &c, 1) == 1, "byte written");
+	check(wait(kq, ev, 4, 0) == 1, "edge-triggered event reported");
+	check(wait(kq, ev, 4, 0) == 0, "edge-triggered event reported once");
+	check(read(pipefd[0], &c, 1) == 1, "byte read");
+
+	/* disabled and deleted events */
+	check(change(kq, pipefd[0], EVFILT_READ, EV_DISABLE) == 0, "read event disabled");
+	check(write(pipefd[1], &c, 1) == 1, "byte written");
+	check(wait(kq, ev, 4, 0) == 0, "disabled event not reported");
+	check(change(kq, pipefd[0], EVFILT_READ, EV_DELETE) == 0, "read event deleted");
+	check(change(kq, pipefd[0], EVFILT_READ, EV_DELETE) == -1, "deleted event unknown");
+	check(read(pipefd[0], &c, 1) == 1, "byte read");
+
+	/* one-shot write event */
+	check(change(kq, pipefd[1], EVFILT_WRITE, EV_ADD | EV_ONESHOT) == 0,
+	      "one-shot write event added");
+	check(wait(kq, ev, 4, 0) == 1 && (int)ev[0].ident == pipefd[1],
+	      "writable pipe reported");
+	check(wait(kq, ev, 4, 0) == 0, "one-shot event removed");
+
+	/* file of the VFS, checked via the VFS plugin */
+	int const file_fd = open("/tmp/kqueue", O_CREAT | O_RDWR);
+	check(file_fd >= 0, "VFS file opened");
+
+	int const kq2 = kqueue();
+	check(kq2 >= 0, "second kqueue created");
+	check(change(kq2, file_fd, EVFILT_READ, EV_ADD) == 0, "VFS read event added");
+	check(wait(kq2, ev, 4, 0) == 1 && (int)ev[0].ident == file_fd,
+	      "VFS file readable");
+
+	/* a notification must not touch a closed kqueue */
+	check(close(kq2) == 0, "second kqueue closed");
+	check(change(kq, pipefd[0], EVFILT_READ, EV_ADD) == 0, "read event added");
+	check(write(pipefd[1], &c, 1) == 1, "byte written");
+	check(wait(kq, ev, 4, 0) == 1, "event reported after close of other kqueue");
+	check(read(pipefd[0], &c, 1) == 1, "byte read");
+
+	/* write readiness of a VFS file */
+	check(change(kq, file_fd, EVFILT_WRITE, EV_ADD | EV_ONESHOT) == 0,
+	      "VFS write event added");
+	check(wait(kq, ev, 4, 0) == 1 && (int)ev[0].ident == file_fd
+	      && ev[0].filter == EVFILT_WRITE, "VFS file writeable");
+
+	/* events of a closed descriptor must not stick to its number */
+	check(change(kq, file_fd, EVFILT_READ,  EV_ADD) == 0, "VFS read event added");
+	check(change(kq, file_fd, EVFILT_WRITE, EV_ADD) == 0, "VFS write event added");
+	check(close(file_fd) == 0, "VFS file closed");
+	check(wait(kq, ev, 4, 0) == 0, "events of closed descriptor dropped");
+
+	/* allocate pipes until one end reuses the number of the closed file */
+	int reuse[2] = { -1, -1 };
+	for (unsigned i = 0; i < 8 && reuse[0] != file_fd && reuse[1] != file_fd; i++)
+		check(pipe(reuse) == 0, "pipe created");
+
+	bool const read_end = (reuse[0] == file_fd);
+	check(read_end || reuse[1] == file_fd, "descriptor number reused by pipe");
+
+	short const filter = read_end ? EVFILT_READ : EVFILT_WRITE;
+	check(change(kq, file_fd, filter, EV_ADD) == 0, "event of reused descriptor added");
+	if (read_end)
+		check(write(reuse[1], &c, 1) == 1, "byte written");
+	check(wait(kq, ev, 4, 1000) == 1 && (int)ev[0].ident == file_fd
+	      && ev[0].filter == filter, "event of reused descriptor reported");
+
+	close(reuse[0]);
+	close(reuse[1]);
+	close(kq);
+
+	printf("--- test finished ---\n");
+
+	return 0;
+}
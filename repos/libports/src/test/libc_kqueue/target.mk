@@ -0,0 +1,3 @@
+TARGET = test-libc_kqueue
+LIBS   = libc libc_pipe pthread
+SRC_CC = main.cc
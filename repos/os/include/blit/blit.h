@@ -14,6 +14,8 @@
 #ifndef _INCLUDE__BLIT__BLIT_H_
 #define _INCLUDE__BLIT__BLIT_H_
 
+#include <base/stdint.h>
+
 /**
  * Blit memory from source buffer to destination buffer
  *
@@ -31,4 +33,81 @@
 extern "C" void blit(void const *src, unsigned src_w,
                      void *dst, unsigned dst_w, int w, int h);
 
+
+namespace Blit {
+
+	using Genode::uint16_t;
+	using Genode::uint32_t;
+
+	struct Kernels;
+
+	/**
+	 * Return kernels best suited for the CPU
+	 *
+	 * The kernels are selected at the first call by probing the CPU
+	 * features.
+	 */
+	Kernels const &kernels();
+
+	/**
+	 * Return kernel variant supported by the CPU
+	 *
+	 * \param i  index of variant, variants are ordered from the fastest to
+	 *           the generic one
+	 *
+	 * \return  kernels, or 0 if 'i' exceeds the number of variants
+	 *
+	 * This function is meant for benchmarking the individual variants.
+	 */
+	Kernels const *kernels(unsigned i);
+}
+
+
+/**
+ * Set of pixel-processing functions
+ *
+ * In contrast to 'blit', the line lengths 'src_w' and 'dst_w' as well as
+ * the width 'w' of the pixel kernels are specified in pixels. The alpha
+ * values of the 'blend' kernels have the same line length as the source
+ * pixels.
+ *
+ * The 'mix' and 'blend' kernels produce the same results as the 'mix'
+ * functions of the corresponding pixel types. The 'blend' kernels leave
+ * destination pixels with an alpha value of zero untouched.
+ */
+struct Blit::Kernels
+{
+	char const *name;
+
+	/**
+	 * Copy pixels, semantics corresponds to the 'blit' function
+	 */
+	void (*copy)(void const *src, unsigned src_w,
+	             void *dst, unsigned dst_w, int w, int h);
+
+	/**
+	 * Fill area with pixel value
+	 */
+	void (*fill_16bit)(void *dst, unsigned dst_w, uint16_t value, int w, int h);
+	void (*fill_32bit)(void *dst, unsigned dst_w, uint32_t value, int w, int h);
+
+	/**
+	 * Mix color into area at the ratio 'alpha'
+	 */
+	void (*mix_rgb565)  (void *dst, unsigned dst_w, uint16_t color,
+	                     int alpha, int w, int h);
+	void (*mix_xrgb8888)(void *dst, unsigned dst_w, uint32_t color,
+	                     int alpha, int w, int h);
+
+	/**
+	 * Blend source pixels over destination according to per-pixel alpha
+	 */
+	void (*blend_rgb565)  (void const *src, unsigned src_w,
+	                       unsigned char const *alpha,
+	                       void *dst, unsigned dst_w, int w, int h);
+	void (*blend_xrgb8888)(void const *src, unsigned src_w,
+	                       unsigned char const *alpha,
+	                       void *dst, unsigned dst_w, int w, int h);
+};
+
 #endif /* _INCLUDE__BLIT__BLIT_H_ */
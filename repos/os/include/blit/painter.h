@@ -0,0 +1,120 @@
+/*
+ * \brief  Pixel operations used by the painters of 'nitpicker_gfx'
+ * \author Genode Labs
+ * \date   2016-06-27
+ *
+ * The generic functions operate on arbitrary pixel types. For the pixel
+ * types used for framebuffers, the functions are overloaded with versions
+ * that use the CPU-specific kernels of the blit library.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BLIT__PAINTER_H_
+#define _INCLUDE__BLIT__PAINTER_H_
+
+#include <blit/blit.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+
+namespace Blit {
+
+	using Genode::Pixel_rgb565;
+	using Genode::Pixel_rgb888;
+
+	namespace Generic {
+
+		/**
+		 * Fill area with pixel
+		 *
+		 * \param dst_w  line length of destination in pixels
+		 */
+		template <typename PT>
+		inline void fill(PT *dst, unsigned dst_w, PT pixel, int w, int h)
+		{
+			for (PT *d; h-- > 0; dst += dst_w) {
+				d = dst;
+				for (int i = w; i--; d++)
+					*d = pixel;
+			}
+		}
+
+		/**
+		 * Mix color into area at the ratio 'alpha'
+		 */
+		template <typename PT>
+		inline void mix(PT *dst, unsigned dst_w, PT color, int alpha, int w, int h)
+		{
+			for (PT *d; h-- > 0; dst += dst_w) {
+				d = dst;
+				for (int i = w; i--; d++)
+					*d = PT::mix(*d, color, alpha);
+			}
+		}
+
+		/**
+		 * Blend pixels over destination according to per-pixel alpha
+		 *
+		 * \param alpha  alpha values with the line length 'src_w'
+		 */
+		template <typename PT>
+		inline void blend(PT const *src, unsigned src_w, unsigned char const *alpha,
+		                  PT *dst, unsigned dst_w, int w, int h)
+		{
+			PT const *s; PT *d; unsigned char const *a;
+
+			for (; h-- > 0; src += src_w, alpha += src_w, dst += dst_w) {
+				s = src; d = dst; a = alpha;
+				for (int i = w; i--; s++, d++, a++)
+					if (*a)
+						*d = PT::mix(*d, *s, *a);
+			}
+		}
+	}
+
+	template <typename PT>
+	inline void fill(PT *dst, unsigned dst_w, PT pixel, int w, int h) {
+		Generic::fill(dst, dst_w, pixel, w, h); }
+
+	template <typename PT>
+	inline void mix(PT *dst, unsigned dst_w, PT color, int alpha, int w, int h) {
+		Generic::mix(dst, dst_w, color, alpha, w, h); }
+
+	template <typename PT>
+	inline void blend(PT const *src, unsigned src_w, unsigned char const *alpha,
+	                  PT *dst, unsigned dst_w, int w, int h) {
+		Generic::blend(src, src_w, alpha, dst, dst_w, w, h); }
+
+	inline void fill(Pixel_rgb565 *dst, unsigned dst_w, Pixel_rgb565 pixel,
+	                 int w, int h) {
+		kernels().fill_16bit(dst, dst_w, pixel.pixel, w, h); }
+
+	inline void fill(Pixel_rgb888 *dst, unsigned dst_w, Pixel_rgb888 pixel,
+	                 int w, int h) {
+		kernels().fill_32bit(dst, dst_w, pixel.pixel, w, h); }
+
+	inline void mix(Pixel_rgb565 *dst, unsigned dst_w, Pixel_rgb565 color,
+	                int alpha, int w, int h) {
+		kernels().mix_rgb565(dst, dst_w, color.pixel, alpha, w, h); }
+
+	inline void mix(Pixel_rgb888 *dst, unsigned dst_w, Pixel_rgb888 color,
+	                int alpha, int w, int h) {
+		kernels().mix_xrgb8888(dst, dst_w, color.pixel, alpha, w, h); }
+
+	inline void blend(Pixel_rgb565 const *src, unsigned src_w,
+	                  unsigned char const *alpha,
+	                  Pixel_rgb565 *dst, unsigned dst_w, int w, int h) {
+		kernels().blend_rgb565(src, src_w, alpha, dst, dst_w, w, h); }
+
+	inline void blend(Pixel_rgb888 const *src, unsigned src_w,
+	                  unsigned char const *alpha,
+	                  Pixel_rgb888 *dst, unsigned dst_w, int w, int h) {
+		kernels().blend_xrgb8888(src, src_w, alpha, dst, dst_w, w, h); }
+}
+
+#endif /* _INCLUDE__BLIT__PAINTER_H_ */
@@ -74,6 +74,7 @@ class Block::Session_component : public Block::Session_component_base,
 		bool                                 _ack_queue_full;
 		Packet_descriptor                    _p_to_handle;
 		unsigned                             _p_in_fly;
+		bool                                 _sync_pending;
 
 		/**
 		 * Acknowledge a packet already handled
@@ -102,8 +103,10 @@ class Block::Session_component : public Block::Session_component_base,
 			_p_to_handle = packet;
 			_p_to_handle.succeeded(false);
 
+			bool const sync = packet.operation() == Block::Packet_descriptor::SYNC;
+
 			/* ignore invalid packets */
-			if (!packet.size() || !_range_check(_p_to_handle)) {
+			if (!packet.size() || (!sync && !_range_check(_p_to_handle))) {
 				_ack_packet(_p_to_handle);
 				return;
 			}
@@ -137,6 +140,36 @@ class Block::Session_component : public Block::Session_component_base,
 						              _p_to_handle);
 					break;
 
+				case Block::Packet_descriptor::TRIM:
+					_driver.trim(packet.block_number(), packet.block_count(),
+					             _p_to_handle);
+					break;
+
+				case Block::Packet_descriptor::SYNC:
+				{
+					/*
+					 * Flush not before all previously submitted requests are
+					 * completed. Meanwhile, no further packets are taken out
+					 * of the submit queue. When retried, the in-flight
+					 * counter already accounts for the sync packet itself.
+					 */
+					unsigned const preceding = _sync_pending ? _p_in_fly - 1
+					                                         : _p_in_fly;
+					if (preceding) {
+						_sync_pending   = true;
+						_req_queue_full = true;
+						break;
+					}
+
+					_sync_pending = false;
+					try { _driver.flush(_p_to_handle); }
+					catch (Driver::Request_congestion) {
+						_sync_pending = true;
+						throw;
+					}
+					break;
+				}
+
 				default:
 					throw Driver::Io_error();
 				}
@@ -187,7 +220,8 @@ class Block::Session_component : public Block::Session_component_base,
 		  _sink_ack(ep, *this, &Session_component::_ready_to_ack),
 		  _sink_submit(ep, *this, &Session_component::_packet_avail),
 		  _req_queue_full(false),
-		  _p_in_fly(0)
+		  _p_in_fly(0),
+		  _sync_pending(false)
 		{
 			_tx.sigh_ready_to_ack(_sink_ack);
 			_tx.sigh_packet_avail(_sink_submit);
@@ -207,6 +241,11 @@ class Block::Session_component : public Block::Session_component_base,
 		 */
 		void ack_packet(Packet_descriptor &packet, bool success)
 		{
+			/* emulate FUA for drivers that do not honor the flag */
+			if (success && packet.fua() && !_driver.fua_supported()
+			 && packet.operation() == Block::Packet_descriptor::WRITE)
+				_driver.sync();
+
 			packet.succeeded(success);
 			_ack_packet(packet);
 
@@ -237,6 +276,9 @@ class Block::Session_component : public Block::Session_component_base,
 			*blk_count = _driver.block_count();
 			*blk_size  = _driver.block_size();
 			*ops       = _driver.ops();
+
+			/* sync packets are supported for all drivers */
+			ops->set_operation(Block::Packet_descriptor::SYNC);
 		}
 
 		void sync() { _driver.sync(); }
@@ -24,26 +24,21 @@
 #include <block_session/rpc_object.h>
 
 namespace Block {
+	class Driver_session_base;
 	class Driver_session;
 	class Driver;
 	struct Driver_factory;
 };
 
 
-class Block::Driver_session : public Block::Session_rpc_object
+/**
+ * Receiver of the packets acknowledged by the driver
+ */
+class Block::Driver_session_base
 {
 	public:
 
-		/**
-		 * Constructor
-		 *
-		 * \param tx_ds  dataspace used as communication buffer
-		 *               for the tx packet stream
-		 * \param ep     entry point used for packet-stream channel
-		 */
-		Driver_session(Genode::Dataspace_capability tx_ds,
-		               Genode::Rpc_entrypoint &ep)
-		: Session_rpc_object(tx_ds, ep) { }
+		virtual ~Driver_session_base() { }
 
 		/**
 		 * Acknowledges a packet processed by the driver to the client
@@ -58,6 +53,24 @@ class Block::Driver_session : public Block::Session_rpc_object
 };
 
 
+class Block::Driver_session : public Block::Driver_session_base,
+                              public Block::Session_rpc_object
+{
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param tx_ds  dataspace used as communication buffer
+		 *               for the tx packet stream
+		 * \param ep     entry point used for packet-stream channel
+		 */
+		Driver_session(Genode::Dataspace_capability tx_ds,
+		               Genode::Rpc_entrypoint &ep)
+		: Session_rpc_object(tx_ds, ep) { }
+};
+
+
 /**
  * Interface to be implemented by the device-specific driver code
  */
@@ -65,7 +78,7 @@ class Block::Driver
 {
 	private:
 
-		Driver_session *_session = nullptr;
+		Driver_session_base *_session = nullptr;
 
 	public:
 
@@ -167,6 +180,51 @@ class Block::Driver
 		                       Packet_descriptor &packet) {
 			throw Io_error(); }
 
+		/**
+		 * Discard content of blocks
+		 *
+		 * \param block_number  number of first block to discard
+		 * \param block_count   number of blocks to discard
+		 * \param packet        packet descriptor from the client
+		 *
+		 * \throw Request_congestion
+		 *
+		 * Note: should be overridden by devices that announce the
+		 *       'TRIM' operation
+		 */
+		virtual void trim(sector_t           block_number,
+		                  Genode::size_t     block_count,
+		                  Packet_descriptor &packet) {
+			throw Io_error(); }
+
+		/**
+		 * Flush written data to stable storage
+		 *
+		 * \param packet  packet descriptor from the client
+		 *
+		 * \throw Request_congestion
+		 *
+		 * The packet is acknowledged once the flush is completed. It is
+		 * issued not before all requests submitted prior the packet are
+		 * acknowledged. The default implementation calls the blocking
+		 * 'sync' method.
+		 *
+		 * Note: should be overridden by asynchronously working drivers
+		 */
+		virtual void flush(Packet_descriptor &packet)
+		{
+			sync();
+			ack_packet(packet);
+		}
+
+		/**
+		 * Return true if the driver honors the FUA flag of write packets
+		 *
+		 * Otherwise, the session component calls 'sync' after the
+		 * completion of each write packet flagged as FUA.
+		 */
+		virtual bool fua_supported() { return false; }
+
 		/**
 		 * Check if DMA is enabled for driver
 		 *
@@ -212,9 +270,11 @@ class Block::Driver
 		/**
 		 * Set single session component of the driver
 		 *
-		 * Session might get used to acknowledge requests.
+		 * Session might get used to acknowledge requests. When serving
+		 * multiple sessions, the session is a scheduler that forwards the
+		 * acknowledgements to the originating sessions.
 		 */
-		void session(Driver_session *session) {
+		void session(Driver_session_base *session) {
 			if (!(_session = session)) session_invalidated(); }
 
 		/**
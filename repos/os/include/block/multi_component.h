@@ -0,0 +1,824 @@
+/*
+ * \brief  Block-session components sharing one driver among several clients
+ * \author Genode Labs
+ * \date   2016-07-06
+ *
+ * In contrast to 'Block::Root', which hands out a single session, the
+ * 'Block::Multi_root' serves any number of sessions with one driver
+ * instance. The requests of all sessions are taken out of their submit
+ * queues and dispatched to the driver by a scheduler:
+ *
+ * - Each session has a weight. Sessions with pending requests share the
+ *   driver according to their weights by the means of start-time fair
+ *   queueing, where the cost of a request is its number of blocks.
+ *
+ * - A request that was queued longer than the deadline of its session is
+ *   dispatched with priority, the earliest deadline first.
+ *
+ * - The number of requests per second of a session can be limited.
+ *
+ * The parameters are taken from the '<policy>' node of the server's
+ * configuration that matches the session label, e.g.,
+ *
+ * ! <policy label="db"     weight="4" deadline_ms="20"/>
+ * ! <policy label="logger" weight="1" iops_limit="100"/>
+ *
+ * For each session, the scheduler records the latencies of the requests
+ * from their arrival until their acknowledgement.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BLOCK__MULTI_COMPONENT_H_
+#define _INCLUDE__BLOCK__MULTI_COMPONENT_H_
+
+#include <base/log.h>
+#include <root/component.h>
+#include <os/session_policy.h>
+#include <timer_session/connection.h>
+#include <util/list.h>
+#include <util/xml_generator.h>
+#include <block/driver.h>
+
+namespace Block {
+
+	using namespace Genode;
+
+	struct Session_params;
+	struct Session_stats;
+	class  Scheduler;
+	class  Multi_session_component_base;
+	class  Multi_session_component;
+	class  Multi_root;
+}
+
+
+/**
+ * Scheduling parameters of a session
+ */
+struct Block::Session_params
+{
+	enum { DEFAULT_DEADLINE_MS = 500 };
+
+	unsigned weight      = 1; /* share of the device             */
+	unsigned iops_limit  = 0; /* requests per second, 0 if unlimited */
+	unsigned deadline_ms = DEFAULT_DEADLINE_MS;
+
+	Session_params() { }
+
+	Session_params(Xml_node policy)
+	:
+		weight(max(policy.attribute_value("weight", 1U), 1U)),
+		iops_limit(policy.attribute_value("iops_limit", 0U)),
+		deadline_ms(policy.attribute_value("deadline_ms",
+		                                   (unsigned)DEFAULT_DEADLINE_MS))
+	{ }
+};
+
+
+/**
+ * Latency statistics of a session
+ */
+struct Block::Session_stats
+{
+	/* upper bounds of the latency histogram buckets in milliseconds */
+	enum { BUCKETS = 5 };
+	static unsigned long bucket_limit_ms(unsigned i)
+	{
+		static unsigned long const limits[BUCKETS] = { 1, 10, 100, 1000, ~0UL };
+		return limits[i];
+	}
+
+	unsigned long requests        = 0;
+	unsigned long failed          = 0;
+	unsigned long deadline_misses = 0;
+	Genode::uint64_t blocks       = 0;
+	Genode::uint64_t latency_sum_ms = 0;
+	unsigned long latency_max_ms  = 0;
+	unsigned long histogram[BUCKETS] { };
+
+	void record(Packet_descriptor const &p, bool success,
+	            unsigned long latency_ms, bool deadline_missed)
+	{
+		requests++;
+		blocks         += p.block_count();
+		latency_sum_ms += latency_ms;
+		latency_max_ms  = max(latency_max_ms, latency_ms);
+
+		if (!success)       failed++;
+		if (deadline_missed) deadline_misses++;
+
+		for (unsigned i = 0; i < BUCKETS; i++)
+			if (latency_ms < bucket_limit_ms(i) || i == BUCKETS - 1) {
+				histogram[i]++;
+				break;
+			}
+	}
+
+	void generate(Xml_generator &xml) const
+	{
+		xml.attribute("requests",        requests);
+		xml.attribute("failed",          failed);
+		xml.attribute("blocks",          blocks);
+		xml.attribute("deadline_misses", deadline_misses);
+		xml.attribute("latency_avg_ms",  requests ? latency_sum_ms/requests : 0);
+		xml.attribute("latency_max_ms",  latency_max_ms);
+
+		for (unsigned i = 0; i < BUCKETS; i++)
+			xml.node("latency", [&] () {
+				if (i < BUCKETS - 1)
+					xml.attribute("below_ms", bucket_limit_ms(i));
+				xml.attribute("requests", histogram[i]);
+			});
+	}
+};
+
+
+/**
+ * Dispatcher of the requests of all sessions to the driver
+ */
+class Block::Scheduler : public Driver_session_base
+{
+	public:
+
+		enum { MAX_REQUESTS = Session::TX_QUEUE_SIZE };
+
+	private:
+
+		friend class Multi_session_component;
+
+		/**
+		 * Request passed to the driver
+		 *
+		 * The driver is handed out a copy of the client's packet descriptor
+		 * with the index of the request as offset, which identifies the
+		 * request on acknowledgement.
+		 */
+		struct Request
+		{
+			bool                      used = false;
+			Multi_session_component  *session = nullptr;
+			Packet_descriptor         packet;
+			unsigned long             arrival_ms = 0;
+			bool                      deadline_missed = false;
+
+			/* buffer of a closed session that is still accessed by the driver */
+			Ram_dataspace_capability  orphan_ds;
+		};
+
+		Driver_factory &_factory;
+		Driver         *_driver = nullptr;
+
+		Timer::Connection         _timer;
+		Signal_handler<Scheduler> _timeout_handler;
+
+		List<Multi_session_component> _sessions;
+
+		Request _requests[MAX_REQUESTS];
+
+		/* virtual time of the last dispatched request */
+		Genode::uint64_t _vtime = 0;
+
+		bool _dispatching = false; /* prevents nested dispatching        */
+		bool _again       = false; /* state changed during dispatching   */
+		bool _congested   = false; /* driver refused the last request    */
+
+		Request *_free_request()
+		{
+			for (unsigned i = 0; i < MAX_REQUESTS; i++)
+				if (!_requests[i].used)
+					return &_requests[i];
+			return nullptr;
+		}
+
+		inline Multi_session_component *_select(unsigned long now);
+		inline void _issue(Multi_session_component &, Request &, unsigned long now);
+		inline void _dispatch(unsigned long now);
+		inline void _free_orphan_ds(Ram_dataspace_capability ds);
+
+		void _handle_timeout() { schedule(); }
+
+	public:
+
+		Scheduler(Env &env, Driver_factory &factory)
+		:
+			_factory(factory), _timer(env),
+			_timeout_handler(env.ep(), *this, &Scheduler::_handle_timeout)
+		{
+			_timer.sigh(_timeout_handler);
+		}
+
+		~Scheduler()
+		{
+			if (!_driver)
+				return;
+
+			_driver->session(nullptr);
+			_factory.destroy(_driver);
+		}
+
+		/**
+		 * Return driver, which is created when used for the first time
+		 */
+		Driver &driver()
+		{
+			if (!_driver) {
+				_driver = _factory.create();
+				_driver->session(this);
+			}
+			return *_driver;
+		}
+
+		/**
+		 * Take pending packets of all sessions and dispatch them
+		 */
+		inline void schedule();
+
+		inline void add(Multi_session_component &);
+		inline void remove(Multi_session_component &);
+
+		/**
+		 * Release communication buffer of a closed session
+		 *
+		 * The buffer is freed not before the driver completed the
+		 * outstanding requests of the session.
+		 */
+		inline void release_buffer(Ram_dataspace_capability ds);
+
+		template <typename FN>
+		inline void for_each_session(FN const &fn) const;
+
+
+		/*************************
+		 ** Driver_session_base **
+		 *************************/
+
+		inline void ack_packet(Packet_descriptor &packet, bool success) override;
+};
+
+
+/**
+ * Base class allocating the communication buffer of a session
+ *
+ * See 'Block::Session_component_base' for the rationale.
+ */
+class Block::Multi_session_component_base
+{
+	protected:
+
+		Scheduler               &_scheduler;
+		Ram_dataspace_capability _rq_ds;
+
+		Multi_session_component_base(Scheduler &scheduler, size_t tx_buf_size)
+		:
+			_scheduler(scheduler),
+			_rq_ds(scheduler.driver().alloc_dma_buffer(tx_buf_size))
+		{ }
+
+		~Multi_session_component_base() { _scheduler.release_buffer(_rq_ds); }
+};
+
+
+class Block::Multi_session_component : public Multi_session_component_base,
+                                       public Session_rpc_object,
+                                       public List<Multi_session_component>::Element
+{
+	private:
+
+		friend class Scheduler;
+
+		enum { QUEUE_SIZE = Session::TX_QUEUE_SIZE };
+
+		/* scale of the virtual time to keep precision for high weights */
+		enum { VTIME_SCALE = 1024 };
+
+		/**
+		 * Request taken out of the submit queue but not yet dispatched
+		 */
+		struct Queued
+		{
+			Packet_descriptor packet;
+			unsigned long     arrival_ms;
+		};
+
+		Session_label  const _label;
+		Session_params const _params;
+		Session_stats        _stats;
+
+		addr_t const _rq_phys;
+
+		Queued   _queue[QUEUE_SIZE];
+		unsigned _queue_head  = 0;
+		unsigned _queue_count = 0;
+
+		unsigned _in_flight = 0; /* requests passed to the driver */
+
+		Genode::uint64_t _vtime = 0;
+
+		/* token bucket of the IOPS limit, in thousandths of a request */
+		unsigned long _tokens         = 0;
+		unsigned long _last_refill_ms = 0;
+
+		Signal_handler<Multi_session_component> _packet_avail;
+		Signal_handler<Multi_session_component> _ready_to_ack;
+
+		void _handle_packet_stream() { _scheduler.schedule(); }
+
+		Queued &_head() { return _queue[_queue_head]; }
+
+		void _pop()
+		{
+			_queue_head = (_queue_head + 1) % QUEUE_SIZE;
+			_queue_count--;
+		}
+
+		/**
+		 * Revert the most recent '_pop'
+		 */
+		void _unpop()
+		{
+			_queue_head = (_queue_head + QUEUE_SIZE - 1) % QUEUE_SIZE;
+			_queue_count++;
+		}
+
+		bool _valid(Packet_descriptor const &p)
+		{
+			if (!p.size())
+				return false;
+
+			if (p.operation() == Packet_descriptor::SYNC)
+				return true;
+
+			return p.block_count()
+			    && p.block_number() + p.block_count()
+			       <= _scheduler.driver().block_count();
+		}
+
+		/**
+		 * Take packets out of the submit queue
+		 *
+		 * \param vtime  current virtual time of the scheduler
+		 *
+		 * The number of taken packets is bounded by the free slots of the
+		 * ack queue to be able to acknowledge each packet without blocking.
+		 */
+		void _fetch(unsigned long now, Genode::uint64_t vtime)
+		{
+			while (_queue_count < QUEUE_SIZE
+			    && tx_sink()->packet_avail()
+			    && _queue_count + _in_flight < tx_sink()->ack_slots_free()) {
+
+				Packet_descriptor p = tx_sink()->get_packet();
+
+				/* ignore invalid packets */
+				if (!_valid(p)) {
+					p.succeeded(false);
+					tx_sink()->acknowledge_packet(p);
+					_stats.record(p, false, 0, false);
+					continue;
+				}
+
+				/* an idle session does not accumulate credit */
+				if (!_queue_count && !_in_flight)
+					_vtime = max(_vtime, vtime);
+
+				_queue[(_queue_head + _queue_count) % QUEUE_SIZE] = { p, now };
+				_queue_count++;
+			}
+		}
+
+		/**
+		 * Return true if the IOPS limit permits dispatching a request
+		 */
+		bool _may_dispatch(unsigned long now)
+		{
+			if (!_params.iops_limit)
+				return true;
+
+			/* allow bursts of a tenth of the limit */
+			unsigned long const burst = max(_params.iops_limit / 10, 1U)*1000UL;
+
+			_tokens = min(_tokens + (now - _last_refill_ms)*_params.iops_limit,
+			              burst);
+			_last_refill_ms = now;
+
+			return _tokens >= 1000;
+		}
+
+		/**
+		 * Return time until the IOPS limit permits the next request
+		 */
+		unsigned long _ms_until_dispatch() const
+		{
+			if (_tokens >= 1000)
+				return 0;
+
+			return (1000 - _tokens + _params.iops_limit - 1) / _params.iops_limit;
+		}
+
+		/**
+		 * Account dispatched request
+		 */
+		void _charge(Packet_descriptor const &p)
+		{
+			if (_params.iops_limit)
+				_tokens -= 1000;
+
+			Genode::uint64_t const cost = max(p.block_count(), (size_t)1);
+			_vtime += cost*VTIME_SCALE / _params.weight;
+		}
+
+		/**
+		 * Acknowledge request completed by the driver
+		 */
+		void _complete(Packet_descriptor &packet, bool success,
+		               unsigned long latency_ms, bool deadline_missed)
+		{
+			_stats.record(packet, success, latency_ms, deadline_missed);
+
+			packet.succeeded(success);
+			tx_sink()->acknowledge_packet(packet);
+			_in_flight--;
+		}
+
+		char *_content(Packet_descriptor const &p) {
+			return tx_sink()->packet_content(p); }
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param ep           entrypoint handling this session component
+		 * \param scheduler    scheduler of the requests of all sessions
+		 * \param label        session label
+		 * \param params       scheduling parameters of the session
+		 * \param tx_buf_size  size of the packet-stream buffer
+		 */
+		Multi_session_component(Entrypoint &ep, Scheduler &scheduler,
+		                        Session_label const &label,
+		                        Session_params const &params,
+		                        size_t tx_buf_size)
+		:
+			Multi_session_component_base(scheduler, tx_buf_size),
+			Session_rpc_object(_rq_ds, ep.rpc_ep()),
+			_label(label), _params(params),
+			_rq_phys(Dataspace_client(_rq_ds).phys_addr()),
+			_packet_avail(ep, *this, &Multi_session_component::_handle_packet_stream),
+			_ready_to_ack(ep, *this, &Multi_session_component::_handle_packet_stream)
+		{
+			_tx.sigh_packet_avail(_packet_avail);
+			_tx.sigh_ready_to_ack(_ready_to_ack);
+
+			_scheduler.add(*this);
+		}
+
+		~Multi_session_component() { _scheduler.remove(*this); }
+
+		Session_label  const &label()  const { return _label;  }
+		Session_params const &params() const { return _params; }
+		Session_stats  const &stats()  const { return _stats;  }
+
+
+		/*******************************
+		 **  Block session interface  **
+		 *******************************/
+
+		void info(sector_t *blk_count, size_t *blk_size,
+		          Operations *ops) override
+		{
+			Driver &driver = _scheduler.driver();
+
+			*blk_count = driver.block_count();
+			*blk_size  = driver.block_size();
+			*ops       = driver.ops();
+
+			/* sync packets are supported for all drivers */
+			ops->set_operation(Packet_descriptor::SYNC);
+		}
+
+		void sync() override { _scheduler.driver().sync(); }
+};
+
+
+/**
+ * Root component, creating a session per client
+ */
+class Block::Multi_root : public Root_component<Multi_session_component>
+{
+	private:
+
+		Entrypoint &_ep;
+		Xml_node    _config;
+		Scheduler   _scheduler;
+
+	protected:
+
+		Multi_session_component *_create_session(const char *args) override
+		{
+			size_t ram_quota =
+				Arg_string::find_arg(args, "ram_quota"  ).ulong_value(0);
+			size_t tx_buf_size =
+				Arg_string::find_arg(args, "tx_buf_size").ulong_value(0);
+
+			if (!tx_buf_size)
+				throw Root::Invalid_args();
+
+			/* deplete ram quota by the memory needed for the session */
+			size_t session_size = max((size_t)4096,
+			                          sizeof(Multi_session_component)
+			                          + sizeof(Allocator_avl));
+			if (ram_quota < session_size)
+				throw Root::Quota_exceeded();
+
+			if (tx_buf_size > ram_quota - session_size) {
+				error("insufficient 'ram_quota', got ", ram_quota, ", need ",
+				      tx_buf_size + session_size);
+				throw Root::Quota_exceeded();
+			}
+
+			Session_label const label = label_from_args(args);
+
+			Session_params params;
+			try { params = Session_params(Session_policy(label, _config)); }
+			catch (Session_policy::No_policy_defined) { }
+
+			return new (md_alloc())
+				Multi_session_component(_ep, _scheduler, label, params,
+				                        tx_buf_size);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param md_alloc        allocator to allocate session components
+		 * \param driver_factory  factory to create and destroy the driver
+		 * \param config          configuration containing the session
+		 *                        policies
+		 */
+		Multi_root(Env &env, Allocator &md_alloc,
+		           Driver_factory &driver_factory, Xml_node config)
+		:
+			Root_component(env.ep(), md_alloc),
+			_ep(env.ep()), _config(config), _scheduler(env, driver_factory)
+		{ }
+
+		/**
+		 * Generate report of the statistics of all sessions
+		 */
+		void generate_stats(Xml_generator &xml) const
+		{
+			_scheduler.for_each_session([&] (Multi_session_component const &s) {
+				xml.node("session", [&] () {
+					xml.attribute("label",  s.label().string());
+					xml.attribute("weight", s.params().weight);
+					s.stats().generate(xml);
+				});
+			});
+		}
+};
+
+
+/***************************
+ ** Scheduler definitions **
+ ***************************/
+
+Block::Multi_session_component *Block::Scheduler::_select(unsigned long now)
+{
+	Multi_session_component *fair     = nullptr;
+	Multi_session_component *expired  = nullptr;
+	unsigned long            earliest = 0;
+	unsigned long            wait_ms  = ~0UL;
+
+	for (Multi_session_component *s = _sessions.first(); s; s = s->next()) {
+
+		if (!s->_queue_count)
+			continue;
+
+		Multi_session_component::Queued const &head = s->_head();
+
+		/* a sync request waits for the previous requests of the session */
+		if (head.packet.operation() == Packet_descriptor::SYNC && s->_in_flight)
+			continue;
+
+		if (!s->_may_dispatch(now)) {
+			wait_ms = min(wait_ms, s->_ms_until_dispatch());
+			continue;
+		}
+
+		unsigned long const deadline = head.arrival_ms + s->_params.deadline_ms;
+		if (deadline <= now && (!expired || deadline < earliest)) {
+			expired  = s;
+			earliest = deadline;
+		}
+
+		if (!fair || s->_vtime < fair->_vtime)
+			fair = s;
+	}
+
+	/* wake up when the IOPS limit of a throttled session permits a request */
+	if (!fair && wait_ms != ~0UL)
+		_timer.trigger_once(max(wait_ms, 1UL)*1000);
+
+	return expired ? expired : fair;
+}
+
+
+void Block::Scheduler::_issue(Multi_session_component &s, Request &r,
+                              unsigned long now)
+{
+	Multi_session_component::Queued const queued = s._head();
+	Packet_descriptor const &p = queued.packet;
+
+	Packet_descriptor tagged(Packet_descriptor(&r - _requests, p.size()),
+	                         p.operation(), p.block_number(), p.block_count());
+	tagged.fua(p.fua());
+
+	r.used            = true;
+	r.session         = &s;
+	r.packet          = p;
+	r.arrival_ms      = queued.arrival_ms;
+	r.deadline_missed = now > queued.arrival_ms + s._params.deadline_ms;
+
+	s._pop();
+	s._in_flight++;
+
+	_vtime = s._vtime;
+	s._charge(p);
+
+	Driver &driver = *_driver;
+
+	try {
+		switch (p.operation()) {
+
+		case Packet_descriptor::READ:
+			if (driver.dma_enabled())
+				driver.read_dma(p.block_number(), p.block_count(),
+				                s._rq_phys + p.offset(), tagged);
+			else
+				driver.read(p.block_number(), p.block_count(),
+				            s._content(p), tagged);
+			break;
+
+		case Packet_descriptor::WRITE:
+			if (driver.dma_enabled())
+				driver.write_dma(p.block_number(), p.block_count(),
+				                 s._rq_phys + p.offset(), tagged);
+			else
+				driver.write(p.block_number(), p.block_count(),
+				             s._content(p), tagged);
+			break;
+
+		case Packet_descriptor::TRIM:
+			driver.trim(p.block_number(), p.block_count(), tagged);
+			break;
+
+		case Packet_descriptor::SYNC:
+			driver.flush(tagged);
+			break;
+
+		default:
+			throw Driver::Io_error();
+		}
+	} catch (Driver::Request_congestion) {
+
+		/* retry when the driver completed a request */
+		r.used = false;
+		s._in_flight--;
+		s._unpop();
+		_congested = true;
+
+	} catch (Driver::Io_error) {
+		ack_packet(tagged, false);
+	}
+}
+
+
+void Block::Scheduler::_dispatch(unsigned long now)
+{
+	while (!_congested) {
+
+		Request *r = _free_request();
+		if (!r)
+			return;
+
+		Multi_session_component *s = _select(now);
+		if (!s)
+			return;
+
+		_issue(*s, *r, now);
+	}
+}
+
+
+void Block::Scheduler::schedule()
+{
+	/* requests acknowledged while dispatching trigger another round */
+	if (_dispatching) {
+		_again = true;
+		return;
+	}
+
+	_dispatching = true;
+
+	do {
+		_again = false;
+
+		unsigned long const now = _timer.elapsed_ms();
+
+		for (Multi_session_component *s = _sessions.first(); s; s = s->next())
+			s->_fetch(now, _vtime);
+
+		_dispatch(now);
+
+	} while (_again);
+
+	_dispatching = false;
+}
+
+
+template <typename FN>
+void Block::Scheduler::for_each_session(FN const &fn) const
+{
+	for (Multi_session_component const *s = _sessions.first(); s; s = s->next())
+		fn(*s);
+}
+
+
+void Block::Scheduler::add(Multi_session_component &s)
+{
+	s._last_refill_ms = _timer.elapsed_ms();
+	_sessions.insert(&s);
+}
+
+
+void Block::Scheduler::remove(Multi_session_component &s)
+{
+	_sessions.remove(&s);
+
+	/* requests still processed by the driver are acknowledged to nobody */
+	for (unsigned i = 0; i < MAX_REQUESTS; i++) {
+		Request &r = _requests[i];
+		if (r.used && r.session == &s) {
+			r.session   = nullptr;
+			r.orphan_ds = s._rq_ds;
+		}
+	}
+}
+
+
+void Block::Scheduler::_free_orphan_ds(Ram_dataspace_capability ds)
+{
+	for (unsigned i = 0; i < MAX_REQUESTS; i++)
+		if (_requests[i].used && _requests[i].orphan_ds == ds)
+			return;
+
+	_driver->free_dma_buffer(ds);
+}
+
+
+void Block::Scheduler::release_buffer(Ram_dataspace_capability ds)
+{
+	_free_orphan_ds(ds);
+}
+
+
+void Block::Scheduler::ack_packet(Packet_descriptor &packet, bool success)
+{
+	unsigned const index = packet.offset();
+
+	if (index >= MAX_REQUESTS || !_requests[index].used) {
+		error("driver acknowledged unknown request");
+		return;
+	}
+
+	Request &r = _requests[index];
+
+	/* emulate FUA for drivers that do not honor the flag */
+	if (success && packet.fua() && !_driver->fua_supported()
+	 && packet.operation() == Packet_descriptor::WRITE)
+		_driver->sync();
+
+	r.used = false;
+
+	if (r.session) {
+		unsigned long const latency_ms = _timer.elapsed_ms() - r.arrival_ms;
+		r.session->_complete(r.packet, success, latency_ms, r.deadline_missed);
+	} else {
+		Ram_dataspace_capability const ds = r.orphan_ds;
+		r.orphan_ds = Ram_dataspace_capability();
+		_free_orphan_ds(ds);
+	}
+
+	_congested = false;
+	schedule();
+}
+
+#endif /* _INCLUDE__BLOCK__MULTI_COMPONENT_H_ */
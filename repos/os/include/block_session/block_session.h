@@ -36,12 +36,28 @@ namespace Block {
  * The data associated with the 'Packet_descriptor' is either
  * the data read from or written to the block indicated by
  * its number.
+ *
+ * Besides reading and writing, a packet may request the following
+ * operations, which carry no payload but must nevertheless refer to a
+ * packet allocated from the packet-stream buffer:
+ *
+ * SYNC  flushes all data written by requests submitted before the packet
+ *       to stable storage. The packet is acknowledged not before all
+ *       previously submitted requests are completed. It thereby replaces
+ *       the blocking 'Session::sync' RPC without stalling the request
+ *       queue.
+ *
+ * TRIM  discards the content of the given block range. Afterwards, the
+ *       content of the blocks is undefined until written again.
+ *
+ * A WRITE packet flagged as FUA (force unit access) is acknowledged not
+ * before its data reached stable storage.
  */
 class Block::Packet_descriptor : public Genode::Packet_descriptor
 {
 	public:
 
-		enum Opcode    { READ, WRITE, END };
+		enum Opcode    { READ, WRITE, SYNC, TRIM, END };
 		enum Alignment { PACKET_ALIGNMENT = 11 };
 
 	private:
@@ -50,6 +66,7 @@ class Block::Packet_descriptor : public Genode::Packet_descriptor
 		sector_t        _block_number; /* requested block number */
 		Genode::size_t  _block_count;  /* number of blocks to transfer */
 		unsigned        _success :1;   /* indicates success of operation */
+		unsigned        _fua     :1;   /* force unit access on write    */
 
 	public:
 
@@ -59,7 +76,8 @@ class Block::Packet_descriptor : public Genode::Packet_descriptor
 		Packet_descriptor(Genode::off_t offset=0, Genode::size_t size = 0)
 		:
 			Genode::Packet_descriptor(offset, size),
-			_op(READ), _block_number(0), _block_count(0), _success(false)
+			_op(READ), _block_number(0), _block_count(0), _success(false),
+			_fua(false)
 		{ }
 
 		/**
@@ -70,15 +88,17 @@ class Block::Packet_descriptor : public Genode::Packet_descriptor
 		:
 			Genode::Packet_descriptor(p.offset(), p.size()),
 			_op(op), _block_number(blk_nr),
-			_block_count(blk_count), _success(false)
+			_block_count(blk_count), _success(false), _fua(false)
 		{ }
 
 		Opcode         operation()    const { return _op;           }
 		sector_t       block_number() const { return _block_number; }
 		Genode::size_t block_count()  const { return _block_count;  }
 		bool           succeeded()    const { return _success;      }
+		bool           fua()          const { return _fua;          }
 
 		void succeeded(bool b) { _success = b ? 1 : 0; }
+		void fua(bool b)       { _fua     = b ? 1 : 0; }
 };
 
 
@@ -144,6 +164,9 @@ struct Block::Session : public Genode::Session
 
 	/**
 	 * Synchronize with block device, like ensuring data to be written
+	 *
+	 * If the session supports the 'SYNC' operation, clients should submit
+	 * a 'SYNC' packet instead, which does not block the client.
 	 */
 	virtual void sync() = 0;
 
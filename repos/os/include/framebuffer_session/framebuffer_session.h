@@ -35,11 +35,12 @@ struct Framebuffer::Mode
 		/**
 		 * Pixel formats
 		 */
-		enum Format { INVALID, RGB565 };
+		enum Format { INVALID, RGB565, XRGB8888 };
 
 		static Genode::size_t bytes_per_pixel(Format format)
 		{
-			if (format == RGB565) return 2;
+			if (format == RGB565)   return 2;
+			if (format == XRGB8888) return 4;
 			return 0;
 		}
 
@@ -15,6 +15,7 @@
 #define _INCLUDE__NITPICKER_GFX__BOX_PAINTER_H_
 
 #include <os/surface.h>
+#include <blit/painter.h>
 
 
 struct Box_painter
@@ -37,19 +38,16 @@ struct Box_painter
 		if (!clipped.valid()) return;
 
 		PT pix(color.r, color.g, color.b);
-		PT *dst, *dst_line = surface.addr() + surface.size().w()*clipped.y1() + clipped.x1();
+		PT *dst_line = surface.addr() + surface.size().w()*clipped.y1() + clipped.x1();
 
 		int const alpha = color.a;
 
 		if (color.opaque())
-			for (int w, h = clipped.h() ; h--; dst_line += surface.size().w())
-				for (dst = dst_line, w = clipped.w(); w--; dst++)
-					*dst = pix;
+			Blit::fill(dst_line, surface.size().w(), pix, clipped.w(), clipped.h());
 
 		else if (!color.transparent())
-			for (int w, h = clipped.h() ; h--; dst_line += surface.size().w())
-				for (dst = dst_line, w = clipped.w(); w--; dst++)
-					*dst = PT::mix(*dst, pix, alpha);
+			Blit::mix(dst_line, surface.size().w(), pix, alpha,
+			          clipped.w(), clipped.h());
 
 		surface.flush_pixels(clipped);
 	}
@@ -14,7 +14,7 @@
 #ifndef _INCLUDE__NITPICKER_GFX__TEXTURE_PAINTER_H_
 #define _INCLUDE__NITPICKER_GFX__TEXTURE_PAINTER_H_
 
-#include <blit/blit.h>
+#include <blit/painter.h>
 #include <os/texture.h>
 
 
@@ -77,7 +77,6 @@ struct Texture_painter
 		int i, j;
 		PT            const *s;
 		PT                  *d;
-		unsigned char const *a;
 
 		switch (mode) {
 
@@ -97,10 +96,7 @@ struct Texture_painter
 			/*
 			 * Copy texture with alpha blending
 			 */
-			for (j = clipped.h(); j--; src += src_w, alpha += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, a = alpha, d = dst; i--; s++, d++, a++)
-					if (*a)
-						*d = PT::mix(*d, *s, *a);
+			Blit::blend(src, src_w, alpha, dst, dst_w, clipped.w(), clipped.h());
 			break;
 
 		case MIXED:
@@ -120,6 +116,73 @@ struct Texture_painter
 
 		surface.flush_pixels(clipped);
 	}
+
+
+	/**
+	 * Paint texture of a pixel format different from the surface
+	 *
+	 * Each pixel is converted individually, which is slower than painting
+	 * a texture of the surface's own pixel format.
+	 */
+	template <typename DST_PT, typename SRC_PT>
+	static inline void paint(Genode::Surface<DST_PT>       &surface,
+	                         Genode::Texture<SRC_PT> const &texture,
+	                         Genode::Color                  mix_color,
+	                         Point                          position,
+	                         Mode                           mode,
+	                         bool                           allow_alpha)
+	{
+		Rect clipped = Rect::intersect(Rect(position, texture.size()),
+		                               surface.clip());
+
+		if (!clipped.valid()) return;
+
+		int const src_w = texture.size().w();
+		int const dst_w = surface.size().w();
+
+		/* calculate offset of first texture pixel to copy */
+		unsigned long tex_start_offset = (clipped.y1() - position.y())*src_w
+		                               +  clipped.x1() - position.x();
+
+		/* start address of source pixels */
+		SRC_PT const *src = texture.pixel() + tex_start_offset;
+
+		/* start address of source alpha values, used in solid mode only */
+		unsigned char const *alpha = (texture.alpha() && allow_alpha)
+		                           ? texture.alpha() + tex_start_offset : 0;
+
+		/* start address of destination pixels */
+		DST_PT *dst = surface.addr() + clipped.y1()*dst_w + clipped.x1();
+
+		DST_PT const mix_pixel(mix_color.r, mix_color.g, mix_color.b);
+
+		for (int j = clipped.h(); j--; src += src_w, dst += dst_w) {
+
+			SRC_PT        const *s = src;
+			DST_PT              *d = dst;
+			unsigned char const *a = alpha;
+
+			for (int i = clipped.w(); i--; s++, d++) {
+
+				DST_PT const pixel(s->r(), s->g(), s->b());
+
+				switch (mode) {
+				case SOLID:
+					if (!a)       *d = pixel;
+					else if (*a)  *d = DST_PT::mix(*d, pixel, *a);
+					break;
+				case MIXED:  *d = DST_PT::avr(mix_pixel, pixel); break;
+				case MASKED: if (s->pixel) *d = pixel;           break;
+				}
+
+				if (a) a++;
+			}
+
+			if (alpha) alpha += src_w;
+		}
+
+		surface.flush_pixels(clipped);
+	}
 };
 
 #endif /* _INCLUDE__NITPICKER_GFX__TEXTURE_PAINTER_H_ */
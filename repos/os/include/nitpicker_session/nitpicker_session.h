@@ -256,6 +256,11 @@ struct Nitpicker::Session : Genode::Session
 
 	/**
 	 * Return physical screen mode
+	 *
+	 * The format of the returned mode is the pixel format of the physical
+	 * framebuffer. A client that supports this format may request it for
+	 * its virtual framebuffer to avoid the conversion of its pixels by
+	 * nitpicker.
 	 */
 	virtual Framebuffer::Mode mode() = 0;
 
@@ -265,7 +270,10 @@ struct Nitpicker::Session : Genode::Session
 	virtual void mode_sigh(Genode::Signal_context_capability) = 0;
 
 	/**
-	 * Define dimensions of virtual framebuffer
+	 * Define dimensions and pixel format of virtual framebuffer
+	 *
+	 * The buffer has the pixel format specified in 'mode', which is either
+	 * RGB565 or XRGB8888. Any other format is treated as RGB565.
 	 *
 	 * \throw Out_of_metadata  session quota does not suffice for specified
 	 *                         buffer dimensions
@@ -0,0 +1,368 @@
+/*
+ * \brief  Seekable, block-compressed archive with lazy decompression
+ * \author Genode Labs
+ * \date   2016-06-20
+ *
+ * A compressed archive is a byte stream (usually a TAR archive) that is split
+ * into blocks of equal size, each compressed independently using LZ4. An
+ * index at the beginning of the archive locates each block, which allows for
+ * random access without decompressing the whole content. Such archives are
+ * created with the host tool 'tool/ctar'.
+ *
+ * Blocks are decompressed on first access and kept in a cache of limited
+ * size. Reads that cover several blocks not present in the cache are
+ * decompressed in parallel by a pool of worker threads.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__COMPRESSED_ARCHIVE_H_
+#define _INCLUDE__OS__COMPRESSED_ARCHIVE_H_
+
+#include <base/allocator.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <base/lock.h>
+#include <base/printf.h>
+#include <util/lz4.h>
+
+namespace Genode { class Compressed_archive; }
+
+
+class Genode::Compressed_archive
+{
+	public:
+
+		/**
+		 * On-disk format, all values are stored in little endian
+		 */
+		struct Header
+		{
+			enum { MAGIC_LEN = 8 };
+
+			char     magic[MAGIC_LEN];
+			uint32_t block_size;
+			uint32_t block_count;
+			uint64_t size;         /* size of uncompressed content */
+		} __attribute__((packed));
+
+		struct Index_entry
+		{
+			enum { FLAG_STORED = 1 };  /* block is stored uncompressed */
+
+			uint64_t offset;       /* position of block within archive */
+			uint32_t length;       /* size of compressed block */
+			uint32_t flags;
+		} __attribute__((packed));
+
+		static char const *magic() { return "GCTAR001"; }
+
+		class Invalid_archive : public Exception { };
+
+		enum { MAX_WORKERS = 8 };
+
+	private:
+
+		/**
+		 * Decompression of one block into a cache slot
+		 */
+		struct Job
+		{
+			Compressed_archive const *archive = nullptr;
+			unsigned long             block   = 0;
+			char                     *dst     = nullptr;
+			bool                      ok      = false;
+
+			void execute() { ok = archive->_decompress(block, dst); }
+		};
+
+		struct Worker : Thread_deprecated<16*1024>
+		{
+			Semaphore  _job_sem;
+			Semaphore &_done_sem;
+			Job       *_job = nullptr;
+
+			Worker(Semaphore &done_sem)
+			: Thread_deprecated("ctar_worker"), _done_sem(done_sem) { start(); }
+
+			void submit(Job &job) { _job = &job; _job_sem.up(); }
+
+			void entry() override
+			{
+				for (;;) {
+					_job_sem.down();
+					_job->execute();
+					_done_sem.up();
+				}
+			}
+		};
+
+		struct Slot
+		{
+			enum { EMPTY = ~0UL };
+
+			unsigned long block    = EMPTY;
+			unsigned long last_use = 0;
+			char         *data     = nullptr;
+		};
+
+		Allocator         &_alloc;
+		char const * const _base;
+		size_t       const _size;
+
+		Header      const &_header;
+		Index_entry const *_index;
+
+		Lock _lock;
+
+		unsigned long _clock  = 0;
+		unsigned long _hits   = 0;
+		unsigned long _misses = 0;
+
+		unsigned    _num_slots;
+		Slot       *_slots;
+
+		Semaphore _done_sem;
+		unsigned  _num_workers;
+		Worker   *_workers[MAX_WORKERS];
+
+		static Header const &_checked_header(char const *base, size_t size)
+		{
+			if (!probe(base, size))
+				throw Invalid_archive();
+
+			Header const &header = *(Header const *)base;
+
+			size_t const index_size = header.block_count*sizeof(Index_entry);
+			if (header.block_size == 0
+			 || index_size > size - sizeof(Header)
+			 || (uint64_t)header.block_count*header.block_size < header.size)
+				throw Invalid_archive();
+
+			return header;
+		}
+
+		size_t _block_len(unsigned long block) const
+		{
+			uint64_t const start = (uint64_t)block*_header.block_size;
+			return min((uint64_t)_header.block_size, _header.size - start);
+		}
+
+		/**
+		 * Decompress block into buffer of 'block_size' bytes
+		 *
+		 * This method does not access mutable state and is thereby safe to
+		 * be called by several worker threads concurrently.
+		 */
+		bool _decompress(unsigned long block, char *dst) const
+		{
+			Index_entry const &entry = _index[block];
+			size_t const len = _block_len(block);
+
+			if (entry.offset > _size || entry.length > _size - entry.offset)
+				return false;
+
+			char const *src = _base + entry.offset;
+
+			if (entry.flags & Index_entry::FLAG_STORED) {
+				if (entry.length != len)
+					return false;
+				memcpy(dst, src, len);
+				return true;
+			}
+
+			try {
+				return Lz4::decompress(src, entry.length, dst, len) == len; }
+			catch (Lz4::Malformed_input) { return false; }
+		}
+
+		Slot *_lookup(unsigned long block)
+		{
+			for (unsigned i = 0; i < _num_slots; i++)
+				if (_slots[i].block == block)
+					return &_slots[i];
+			return nullptr;
+		}
+
+		/**
+		 * Return least-recently used slot that is not pinned by the current
+		 * batch
+		 */
+		Slot *_victim(unsigned long batch_start)
+		{
+			Slot *victim = nullptr;
+			for (unsigned i = 0; i < _num_slots; i++) {
+				Slot &slot = _slots[i];
+				if (slot.block != Slot::EMPTY && slot.last_use >= batch_start)
+					continue;
+				if (!victim || slot.block == Slot::EMPTY
+				 || slot.last_use < victim->last_use)
+					victim = &slot;
+				if (slot.block == Slot::EMPTY)
+					break;
+			}
+			return victim;
+		}
+
+		/**
+		 * Make blocks 'first' ... 'first + count - 1' present in the cache
+		 *
+		 * The number of blocks must not exceed the number of cache slots.
+		 * Missing blocks are distributed among the worker threads and the
+		 * calling thread.
+		 */
+		void _fetch(unsigned long first, unsigned long count)
+		{
+			unsigned long const batch_start = ++_clock;
+
+			Job jobs[MAX_WORKERS + 1];
+			unsigned num_jobs = 0;
+
+			auto execute_jobs = [&] ()
+			{
+				/* hand out all but the first job to the workers */
+				for (unsigned i = 1; i < num_jobs; i++)
+					_workers[i - 1]->submit(jobs[i]);
+
+				if (num_jobs)
+					jobs[0].execute();
+
+				for (unsigned i = 1; i < num_jobs; i++)
+					_done_sem.down();
+
+				for (unsigned i = 0; i < num_jobs; i++) {
+					if (!jobs[i].ok) {
+						PERR("corrupt block %lu in compressed archive",
+						     jobs[i].block);
+						_lookup(jobs[i].block)->block = Slot::EMPTY;
+						throw Invalid_archive();
+					}
+				}
+				num_jobs = 0;
+			};
+
+			for (unsigned long block = first; block < first + count; block++) {
+
+				Slot *slot = _lookup(block);
+				if (slot) {
+					slot->last_use = batch_start;
+					_hits++;
+					continue;
+				}
+
+				_misses++;
+				slot = _victim(batch_start);
+				slot->block    = block;
+				slot->last_use = batch_start;
+
+				Job &job = jobs[num_jobs];
+				job.archive = this;
+				job.block   = block;
+				job.dst     = slot->data;
+				job.ok      = false;
+
+				if (++num_jobs == _num_workers + 1)
+					execute_jobs();
+			}
+			execute_jobs();
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc        allocator for cache and worker threads
+		 * \param base         local address of compressed archive
+		 * \param size         size of compressed archive
+		 * \param cache_size   upper bound of memory used for caching
+		 *                     decompressed blocks
+		 * \param num_workers  number of additional threads used for
+		 *                     decompressing large reads
+		 *
+		 * \throw Invalid_archive
+		 */
+		Compressed_archive(Allocator &alloc, char const *base, size_t size,
+		                   size_t cache_size, unsigned num_workers)
+		:
+			_alloc(alloc), _base(base), _size(size),
+			_header(_checked_header(base, size)),
+			_index((Index_entry const *)(base + sizeof(Header))),
+			_num_slots(max((unsigned long)(cache_size/_header.block_size),
+			               num_workers + 1UL)),
+			_slots(new (alloc) Slot[_num_slots]),
+			_num_workers(min(num_workers, (unsigned)MAX_WORKERS))
+		{
+			for (unsigned i = 0; i < _num_slots; i++)
+				_slots[i].data = (char *)_alloc.alloc(_header.block_size);
+
+			for (unsigned i = 0; i < _num_workers; i++)
+				_workers[i] = new (alloc) Worker(_done_sem);
+		}
+
+		/*
+		 * The worker threads are never joined, hence a compressed archive
+		 * must stay in place for the lifetime of the component.
+		 */
+
+		/**
+		 * Return true if buffer starts with a compressed-archive header
+		 */
+		static bool probe(char const *base, size_t size)
+		{
+			return size >= sizeof(Header)
+			    && memcmp(base, magic(), Header::MAGIC_LEN) == 0;
+		}
+
+		/**
+		 * Return size of the uncompressed content
+		 */
+		size_t size() const { return _header.size; }
+
+		unsigned long cache_hits()   const { return _hits; }
+		unsigned long cache_misses() const { return _misses; }
+
+		/**
+		 * Copy uncompressed content at 'offset' to 'dst'
+		 *
+		 * \throw Invalid_archive  archive content is corrupt
+		 */
+		void read(size_t offset, char *dst, size_t len)
+		{
+			Lock::Guard guard(_lock);
+
+			if (offset >= size()) return;
+			len = min(len, size() - offset);
+
+			size_t const block_size = _header.block_size;
+
+			while (len > 0) {
+
+				unsigned long const first = offset / block_size;
+				unsigned long const last  = (offset + len - 1) / block_size;
+				unsigned long const count = min(last - first + 1,
+				                                (unsigned long)_num_slots);
+
+				_fetch(first, count);
+
+				for (unsigned long block = first; block < first + count; block++) {
+
+					size_t const block_offset = offset % block_size;
+					size_t const curr_len     = min(len, block_size - block_offset);
+
+					memcpy(dst, _lookup(block)->data + block_offset, curr_len);
+
+					dst    += curr_len;
+					offset += curr_len;
+					len    -= curr_len;
+				}
+			}
+		}
+};
+
+#endif /* _INCLUDE__OS__COMPRESSED_ARCHIVE_H_ */
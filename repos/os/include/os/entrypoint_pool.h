@@ -0,0 +1,195 @@
+/*
+ * \brief  Pool of entrypoints for serving RPCs and signals on several CPUs
+ * \author Genode Labs
+ * \date   2016-07-01
+ *
+ * An entrypoint serves its RPC objects and signal handlers by one thread.
+ * Hence, a server with many clients cannot use more than one CPU. The
+ * entrypoint pool distributes the objects of a server among several
+ * entrypoints, each running on a distinct CPU of the pool's affinity
+ * location.
+ *
+ * Each object is served by exactly one entrypoint of the pool, which
+ * serializes the requests for the object and thereby preserves their order.
+ * Objects are assigned to the entrypoints in a round-robin fashion unless
+ * pinned to a particular entrypoint explicitly. Because each entrypoint
+ * looks up the invoked objects in its own object pool, the dispatching of
+ * requests does not contend for a lock shared by all threads.
+ *
+ * The objects of the pool are served concurrently. The server must
+ * synchronize state shared between objects by itself.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__ENTRYPOINT_POOL_H_
+#define _INCLUDE__OS__ENTRYPOINT_POOL_H_
+
+#include <base/env.h>
+#include <base/entrypoint.h>
+#include <base/snprintf.h>
+#include <base/lock.h>
+#include <util/volatile_object.h>
+#include <util/noncopyable.h>
+#include <util/misc_math.h>
+
+namespace Genode { class Entrypoint_pool; }
+
+
+class Genode::Entrypoint_pool : Noncopyable
+{
+	public:
+
+		enum { MAX_ENTRYPOINTS = 32 };
+
+		class Invalid_entrypoint : public Exception { };
+
+	private:
+
+		Lazy_volatile_object<Entrypoint> _eps[MAX_ENTRYPOINTS];
+
+		unsigned const _count;
+
+		Lock     _lock;
+		unsigned _next = 0;
+
+		static Affinity::Location _pool_location(Env &env,
+		                                         Affinity::Location location)
+		{
+			if (location.valid())
+				return location;
+
+			Affinity::Space const space = env.cpu().affinity_space();
+			return Affinity::Location(0, 0, max(space.width(),  1U),
+			                                max(space.height(), 1U));
+		}
+
+		static unsigned _init_count(unsigned count, Affinity::Location location)
+		{
+			if (count == 0)
+				count = location.width()*location.height();
+
+			return min(max(count, 1U), (unsigned)MAX_ENTRYPOINTS);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param count       number of entrypoints, or 0 for creating one
+		 *                    entrypoint per CPU of 'location'
+		 * \param stack_size  stack size of each entrypoint thread
+		 * \param name        name prefix of the entrypoint threads
+		 * \param location    CPUs used by the pool, by default all CPUs of
+		 *                    the component's affinity space
+		 *
+		 * The entrypoints are placed on the CPUs of 'location' in a
+		 * round-robin fashion.
+		 */
+		Entrypoint_pool(Env &env, unsigned count, size_t stack_size,
+		                char const *name,
+		                Affinity::Location location = Affinity::Location())
+		:
+			_count(_init_count(count, _pool_location(env, location)))
+		{
+			Affinity::Location const pool_location = _pool_location(env, location);
+			Affinity::Space    const pool_space(pool_location.width(),
+			                                    pool_location.height());
+
+			for (unsigned i = 0; i < _count; i++) {
+
+				char ep_name[32];
+				snprintf(ep_name, sizeof(ep_name), "%s.%u", name, i);
+
+				Affinity::Location const ep_location =
+					pool_space.location_of_index(i)
+					          .transpose(pool_location.xpos(),
+					                     pool_location.ypos());
+
+				_eps[i].construct(env, stack_size, ep_name, ep_location);
+			}
+		}
+
+		/**
+		 * Return number of entrypoints
+		 */
+		unsigned count() const { return _count; }
+
+		/**
+		 * Return entrypoint with the specified index
+		 *
+		 * \throw Invalid_entrypoint
+		 *
+		 * The returned entrypoint may be used for pinning RPC objects or
+		 * signal handlers to a particular thread, e.g., all objects
+		 * belonging to the same client.
+		 */
+		Entrypoint &ep(unsigned index)
+		{
+			if (index >= _count)
+				throw Invalid_entrypoint();
+
+			return *_eps[index];
+		}
+
+		/**
+		 * Return entrypoint to be used for the next unpinned object
+		 */
+		Entrypoint &next()
+		{
+			Lock::Guard guard(_lock);
+
+			unsigned const index = _next;
+			_next = (_next + 1) % _count;
+
+			return *_eps[index];
+		}
+
+		/**
+		 * Associate RPC object with the next entrypoint of the pool
+		 */
+		template <typename RPC_INTERFACE, typename RPC_SERVER>
+		Capability<RPC_INTERFACE>
+		manage(Rpc_object<RPC_INTERFACE, RPC_SERVER> &obj)
+		{
+			return next().manage(obj);
+		}
+
+		/**
+		 * Associate RPC object with the entrypoint at 'index'
+		 *
+		 * \throw Invalid_entrypoint
+		 */
+		template <typename RPC_INTERFACE, typename RPC_SERVER>
+		Capability<RPC_INTERFACE>
+		manage(Rpc_object<RPC_INTERFACE, RPC_SERVER> &obj, unsigned index)
+		{
+			return ep(index).manage(obj);
+		}
+
+		/**
+		 * Dissolve RPC object from the entrypoint that serves it
+		 */
+		template <typename RPC_INTERFACE, typename RPC_SERVER>
+		void dissolve(Rpc_object<RPC_INTERFACE, RPC_SERVER> &obj)
+		{
+			for (unsigned i = 0; i < _count; i++) {
+
+				bool const served_by_ep = _eps[i]->rpc_ep().apply(obj.cap(),
+					[&] (Rpc_object_base *o) { return o == &obj; });
+
+				if (served_by_ep) {
+					_eps[i]->dissolve(obj);
+					return;
+				}
+			}
+		}
+};
+
+#endif /* _INCLUDE__OS__ENTRYPOINT_POOL_H_ */
@@ -0,0 +1,107 @@
+/*
+ * \brief  Reporter that generates its report periodically
+ * \author Genode Labs
+ * \date   2016-07-22
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__PERIODIC_REPORTER_H_
+#define _INCLUDE__OS__PERIODIC_REPORTER_H_
+
+#include <base/env.h>
+#include <base/signal.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
+#include <util/volatile_object.h>
+#include <util/xml_node.h>
+
+namespace Genode { template <typename> class Periodic_reporter; }
+
+
+/**
+ * Reporter that periodically calls a generate method of an object
+ *
+ * The period is configured by the 'interval_ms' attribute of a '<report>'
+ * node. Without such a node, the reporter is disabled and no timer session
+ * is opened.
+ *
+ * \param T  type of the object that generates the report content
+ */
+template <typename T>
+class Genode::Periodic_reporter
+{
+	public:
+
+		typedef void (T::*Generate_method)(Xml_generator &);
+
+	private:
+
+		Env                   &_env;
+		T                     &_obj;
+		Generate_method const  _generate;
+
+		Reporter _reporter;
+
+		Lazy_volatile_object<Timer::Connection> _timer;
+
+		Signal_handler<Periodic_reporter> _timeout_handler {
+			_env.ep(), *this, &Periodic_reporter::_handle_timeout };
+
+		void _handle_timeout()
+		{
+			Reporter::Xml_generator xml(_reporter, [&] () {
+				(_obj.*_generate)(xml); });
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param name         name of the report and its top-level node
+		 * \param obj          object that generates the report content
+		 * \param generate     method of 'obj' called for each report
+		 * \param buffer_size  size of the report buffer
+		 */
+		Periodic_reporter(Env &env, char const *name, T &obj,
+		                  Generate_method generate,
+		                  size_t buffer_size = 4096)
+		:
+			_env(env), _obj(obj), _generate(generate),
+			_reporter(name, nullptr, buffer_size)
+		{ }
+
+		/**
+		 * Apply the '<report>' sub node of the component configuration
+		 */
+		void configure(Xml_node config)
+		{
+			unsigned long interval_ms = 0;
+			try {
+				config.sub_node("report").attribute("interval_ms").value(&interval_ms);
+			} catch (...) { }
+
+			_reporter.enabled(interval_ms > 0);
+
+			if (!interval_ms) {
+				_timer.destruct();
+				return;
+			}
+
+			if (!_timer.constructed()) {
+				_timer.construct(_env);
+				_timer->sigh(_timeout_handler);
+			}
+			_timer->trigger_periodic(interval_ms*1000);
+		}
+
+		bool enabled() const { return _reporter.enabled(); }
+};
+
+#endif /* _INCLUDE__OS__PERIODIC_REPORTER_H_ */
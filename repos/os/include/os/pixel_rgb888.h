@@ -22,6 +22,15 @@ namespace Genode {
 	                  0xff0000, 16, 0xff00, 8, 0xff, 0, 0, 0>
 	        Pixel_rgb888;
 
+	template <>
+	inline Pixel_rgb888 Pixel_rgb888::avr(Pixel_rgb888 p1, Pixel_rgb888 p2)
+	{
+		Pixel_rgb888 res;
+		res.pixel = ((p1.pixel&0xfefefe)>>1) + ((p2.pixel&0xfefefe)>>1);
+		return res;
+	}
+
+
 	template <>
 	inline Pixel_rgb888 Pixel_rgb888::blend(Pixel_rgb888 src, int alpha)
 	{
@@ -0,0 +1,106 @@
+/*
+ * \brief  Report of the aggregated RPC statistics of a component
+ * \author Genode Labs
+ * \date   2016-07-20
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__RPC_STATS_REPORTER_H_
+#define _INCLUDE__OS__RPC_STATS_REPORTER_H_
+
+#include <base/trace/rpc_stats.h>
+#include <os/reporter.h>
+
+namespace Genode { class Rpc_stats_reporter; }
+
+
+/**
+ * Reporter of 'Trace::Rpc_stats'
+ *
+ * The report has the following form:
+ *
+ * ! <rpc_stats>
+ * !   <rpc interface="Block::Session" function="info" opcode="0"
+ * !        side="server" calls="12">
+ * !     <latency log2="7" count="10"/>
+ * !     <latency log2="8" count="2"/>
+ * !   </rpc>
+ * ! </rpc_stats>
+ *
+ * Each '<latency>' node counts the calls with a latency between 2^log2 and
+ * 2^(log2+1) timestamp units (CPU cycles on most platforms). Only RPC
+ * functions that were called at least once are reported. The counters are
+ * cumulative.
+ */
+class Genode::Rpc_stats_reporter
+{
+	private:
+
+		Reporter _reporter;
+
+	public:
+
+		Rpc_stats_reporter(char const *label = "rpc_stats",
+		                   size_t buffer_size = 16*1024)
+		: _reporter("rpc_stats", label, buffer_size) { }
+
+		/**
+		 * Enable or disable the recording and reporting of RPC statistics
+		 */
+		void enabled(bool enabled)
+		{
+			_reporter.enabled(enabled);
+			Trace::Rpc_stats::enable(enabled);
+		}
+
+		bool enabled() const { return _reporter.enabled(); }
+
+		/**
+		 * Generate '<rpc>' nodes for all RPC functions called so far
+		 */
+		static void generate(Xml_generator &xml)
+		{
+			typedef Trace::Rpc_stats Rpc_stats;
+
+			Rpc_stats::for_each([&] (Rpc_stats::Function const &f) {
+
+				if (!f.calls)
+					return;
+
+				xml.node("rpc", [&] () {
+					xml.attribute("interface", f.interface_name());
+					xml.attribute("function",  f.function_name());
+					xml.attribute("opcode",    f.opcode);
+					xml.attribute("side",      f.side == Rpc_stats::CLIENT
+					                           ? "client" : "server");
+					xml.attribute("calls",     f.calls);
+
+					for (unsigned i = 0; i < Rpc_stats::BUCKETS; i++) {
+						if (!f.histogram[i])
+							continue;
+
+						xml.node("latency", [&] () {
+							xml.attribute("log2",  i);
+							xml.attribute("count", f.histogram[i]);
+						});
+					}
+				});
+			});
+		}
+
+		void report()
+		{
+			if (!_reporter.enabled())
+				return;
+
+			Reporter::Xml_generator xml(_reporter, [&] () { generate(xml); });
+		}
+};
+
+#endif /* _INCLUDE__OS__RPC_STATS_REPORTER_H_ */
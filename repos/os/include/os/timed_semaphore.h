@@ -38,19 +38,30 @@ namespace Genode {
 
 
 /**
- * Alarm thread, which counts jiffies and triggers timeout events.
+ * Alarm thread, which triggers timeout events
+ *
+ * The thread programs a one-shot timeout for the earliest deadline of all
+ * scheduled alarms only. Hence, a component without pending timeouts is
+ * never woken up by the alarm thread.
  */
 class Genode::Timeout_thread : public Thread_deprecated<4096>,
                                public Alarm_scheduler
 {
 	private:
 
-		enum { JIFFIES_STEP_MS = 10 };
-
 		Timer::Connection   _timer;    /* timer session   */
 		Signal_context      _context;
 		Signal_receiver     _receiver;
 
+		Lock                _program_lock;
+		bool                _programmed = false;  /* one-shot timeout armed */
+		Alarm::Time         _programmed_deadline = 0;
+
+		/**
+		 * Arm one-shot timeout for the earliest deadline if needed
+		 */
+		void _program();
+
 		void entry(void);
 
 	public:
@@ -58,12 +69,23 @@ class Genode::Timeout_thread : public Thread_deprecated<4096>,
 		Timeout_thread() : Thread_deprecated<4096>("alarm-timer")
 		{
 			_timer.sigh(_receiver.manage(&_context));
-			_timer.trigger_periodic(JIFFIES_STEP_MS*1000);
 			start();
 		}
 
 		Genode::Alarm::Time time(void) { return _timer.elapsed_ms(); }
 
+		/**
+		 * Schedule absolute timeout
+		 *
+		 * In contrast to 'Alarm_scheduler::schedule_absolute', the timer
+		 * is reprogrammed if the alarm becomes the earliest deadline.
+		 */
+		void schedule_absolute(Alarm *alarm, Alarm::Time timeout)
+		{
+			Alarm_scheduler::schedule_absolute(alarm, timeout);
+			_program();
+		}
+
 		/*
 		 * Returns the singleton timeout-thread used for all timeouts.
 		 */
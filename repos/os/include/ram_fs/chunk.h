@@ -96,6 +96,11 @@ class File_system::Chunk_base : Noncopyable
 
 /**
  * Chunk of bytes used as leaf in hierarchy of chunk indices
+ *
+ * Only the bytes below 'used_size' hold defined content. The remainder of
+ * the chunk is not initialized but reads as zeros. This way, allocating a
+ * chunk does not require clearing the whole chunk. Holes are zeroed only
+ * when data is written beyond the used part of the chunk.
  */
 template <unsigned CHUNK_SIZE>
 class File_system::Chunk : public Chunk_base
@@ -120,9 +125,7 @@ class File_system::Chunk : public Chunk_base
 		Chunk(Allocator &, seek_off_t base_offset)
 		:
 			Chunk_base(base_offset)
-		{
-			memset(_data, 0, CHUNK_SIZE);
-		}
+		{ }
 
 		/**
 		 * Construct zero chunk
@@ -145,6 +148,10 @@ class File_system::Chunk : public Chunk_base
 			/* offset relative to this chunk */
 			seek_off_t const local_offset = seek_offset - base_offset();
 
+			/* zero the hole between the used part and the written range */
+			if (local_offset > _num_entries)
+				memset(&_data[_num_entries], 0, local_offset - _num_entries);
+
 			memcpy(&_data[local_offset], src, len);
 
 			_num_entries = max(_num_entries, local_offset + len);
@@ -154,7 +161,14 @@ class File_system::Chunk : public Chunk_base
 		{
 			assert_valid_range(seek_offset, len, SIZE);
 
-			memcpy(dst, &_data[seek_offset - base_offset()], len);
+			seek_off_t const local_offset = seek_offset - base_offset();
+
+			/* bytes beyond the used part of the chunk read as zeros */
+			size_t const used_len = local_offset < _num_entries
+			                      ? min(len, (size_t)(_num_entries - local_offset)) : 0;
+
+			memcpy(dst, &_data[local_offset], used_len);
+			memset(dst + used_len, 0, len - used_len);
 		}
 
 		void truncate(file_size_t size)
@@ -170,8 +184,6 @@ class File_system::Chunk : public Chunk_base
 			if (local_offset >= _num_entries)
 				return;
 
-			memset(&_data[local_offset], 0, _num_entries - local_offset);
-
 			_num_entries = local_offset;
 		}
 };
@@ -0,0 +1,178 @@
+/*
+ * \brief  Slab-backed allocator for chunks of the RAM file system
+ * \author Genode Labs
+ * \date   2016-06-22
+ *
+ * Chunks and chunk indices are allocated in large numbers but come in a few
+ * distinct sizes only. Allocating each of them individually from a heap
+ * incurs meta data per allocation and fragments the heap. The chunk
+ * allocator instead maintains one slab per object size. Each slab obtains
+ * its backing store in page-granular blocks that host several chunks.
+ *
+ * Chunks are freed via 'Genode::destroy', which does not supply the size of
+ * the object. Hence, each allocation is preceded by a header that records
+ * its origin.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__RAM_FS__CHUNK_ALLOCATOR_H_
+#define _INCLUDE__RAM_FS__CHUNK_ALLOCATOR_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/slab.h>
+#include <base/lock.h>
+#include <util/misc_math.h>
+#include <util/noncopyable.h>
+
+namespace File_system {
+
+	using namespace Genode;
+
+	class Chunk_allocator;
+}
+
+
+class File_system::Chunk_allocator : public Allocator, Noncopyable
+{
+	public:
+
+		enum {
+			MAX_SIZE_CLASSES  = 16,
+			ENTRIES_PER_BLOCK = 16,
+			PAGE_SIZE_LOG2    = 12,
+
+			/* head room for the slab-block meta data */
+			BLOCK_META_DATA   = 256,
+		};
+
+	private:
+
+		struct Size_class
+		{
+			size_t size = 0;
+			Slab  *slab = nullptr;
+		};
+
+		/**
+		 * Header preceding each allocation
+		 */
+		struct Header
+		{
+			Slab   *slab;  /* originating slab, or 0 for the backing store */
+			size_t  size;  /* size of the allocation including the header */
+		};
+
+		Allocator &_backing_store;
+
+		Lock _lock;
+
+		Size_class _classes[MAX_SIZE_CLASSES];
+		unsigned   _num_classes = 0;
+
+		/**
+		 * Return slab for allocations of 'size' bytes
+		 *
+		 * \param create  create slab on demand
+		 *
+		 * \return  slab, or 0 if the size is not served by any slab
+		 */
+		Slab *_slab(size_t size, bool create)
+		{
+			for (unsigned i = 0; i < _num_classes; i++)
+				if (_classes[i].size == size)
+					return _classes[i].slab;
+
+			if (!create || _num_classes == MAX_SIZE_CLASSES)
+				return nullptr;
+
+			/* dimension slab block to host several entries, rounded to pages */
+			size_t const entry_size = size + 2*sizeof(addr_t);
+			size_t const block_size =
+				align_addr(ENTRIES_PER_BLOCK*entry_size + BLOCK_META_DATA,
+				           PAGE_SIZE_LOG2);
+
+			Size_class &size_class = _classes[_num_classes++];
+			size_class.size = size;
+			size_class.slab = new (&_backing_store)
+				Slab(size, block_size, nullptr, &_backing_store);
+
+			return size_class.slab;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param backing_store  allocator used for obtaining slab blocks
+		 */
+		Chunk_allocator(Allocator &backing_store)
+		: _backing_store(backing_store) { }
+
+		~Chunk_allocator()
+		{
+			for (unsigned i = 0; i < _num_classes; i++)
+				destroy(&_backing_store, _classes[i].slab);
+		}
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		bool alloc(size_t size, void **out_addr) override
+		{
+			Lock::Guard guard(_lock);
+
+			size = size + sizeof(Header);
+
+			Slab *slab = _slab(size, true);
+
+			void *addr = nullptr;
+			if (!(slab ? slab->alloc(size, &addr)
+			           : _backing_store.alloc(size, &addr)))
+				return false;
+
+			Header *header = (Header *)addr;
+			header->slab = slab;
+			header->size = size;
+
+			*out_addr = header + 1;
+			return true;
+		}
+
+		void free(void *addr, size_t) override
+		{
+			Lock::Guard guard(_lock);
+
+			Header *header = (Header *)addr - 1;
+			if (header->slab)
+				header->slab->free(header, header->size);
+			else
+				_backing_store.free(header, header->size);
+		}
+
+		size_t consumed() const override
+		{
+			size_t result = 0;
+			for (unsigned i = 0; i < _num_classes; i++)
+				result += _classes[i].slab->consumed();
+			return result;
+		}
+
+		size_t overhead(size_t size) const override
+		{
+			return 2*sizeof(addr_t) + sizeof(Header);
+		}
+
+		bool need_size_for_free() const override { return false; }
+};
+
+#endif /* _INCLUDE__RAM_FS__CHUNK_ALLOCATOR_H_ */
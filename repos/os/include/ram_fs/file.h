@@ -27,21 +27,99 @@ namespace File_system { class File; }
 
 class File_system::File : public Node
 {
+	public:
+
+		/*
+		 * Supported sizes of leaf chunks
+		 *
+		 * Small chunks keep the memory overhead of small or sparse files
+		 * low whereas large chunks reduce the number of allocations and
+		 * index lookups for large files. Each geometry supports files of
+		 * up to 2 GiB.
+		 */
+		enum { DEFAULT_CHUNK_SIZE = 4096 };
+
+		static bool valid_chunk_size(size_t chunk_size)
+		{
+			return chunk_size == 1024  || chunk_size == 4096
+			    || chunk_size == 16384 || chunk_size == 65536;
+		}
+
 	private:
 
-		typedef Chunk<4096>                     Chunk_level_3;
-		typedef Chunk_index<128, Chunk_level_3> Chunk_level_2;
-		typedef Chunk_index<64,  Chunk_level_2> Chunk_level_1;
-		typedef Chunk_index<64,  Chunk_level_1> Chunk_level_0;
+		/**
+		 * Interface of the chunk hierarchy holding the file content
+		 */
+		struct Chunks
+		{
+			virtual ~Chunks() { }
+
+			virtual file_size_t used_size() const = 0;
+			virtual file_size_t max_size() const = 0;
+			virtual void write(char const *src, size_t len, seek_off_t) = 0;
+			virtual void read(char *dst, size_t len, seek_off_t) const = 0;
+			virtual void truncate(file_size_t size) = 0;
+		};
+
+		template <unsigned CHUNK_SIZE, unsigned N2, unsigned N1, unsigned N0>
+		struct Chunk_tree : Chunks
+		{
+			typedef Chunk<CHUNK_SIZE>              Chunk_level_3;
+			typedef Chunk_index<N2, Chunk_level_3> Chunk_level_2;
+			typedef Chunk_index<N1, Chunk_level_2> Chunk_level_1;
+			typedef Chunk_index<N0, Chunk_level_1> Chunk_level_0;
+
+			Chunk_level_0 chunk;
+
+			Chunk_tree(Allocator &alloc) : chunk(alloc, 0) { }
+
+			file_size_t used_size() const override { return chunk.used_size(); }
+			file_size_t max_size()  const override { return Chunk_level_0::SIZE; }
 
-		Chunk_level_0 _chunk;
+			void write(char const *src, size_t len, seek_off_t seek_offset) override {
+				chunk.write(src, len, seek_offset); }
+
+			void read(char *dst, size_t len, seek_off_t seek_offset) const override {
+				chunk.read(dst, len, seek_offset); }
+
+			void truncate(file_size_t size) override { chunk.truncate(size); }
+		};
+
+		static Chunks &_create_chunks(Allocator &alloc, size_t chunk_size)
+		{
+			switch (chunk_size) {
+			case 1024:  return *new (&alloc) Chunk_tree<1024,  128, 128, 128>(alloc);
+			case 16384: return *new (&alloc) Chunk_tree<16384,  64,  64,  32>(alloc);
+			case 65536: return *new (&alloc) Chunk_tree<65536,  32,  32,  32>(alloc);
+			default:    return *new (&alloc) Chunk_tree<4096,  128,  64,  64>(alloc);
+			}
+		}
+
+		Allocator &_alloc;
+
+		Chunks &_chunk;
 
 		file_size_t _length;
 
 	public:
 
-		File(Allocator &alloc, char const *name)
-		: _chunk(alloc, 0), _length(0) { Node::name(name); }
+		/**
+		 * Constructor
+		 *
+		 * \param alloc       allocator used for the file content
+		 * \param name        file name
+		 * \param chunk_size  size of leaf chunks, must be one of the
+		 *                    sizes accepted by 'valid_chunk_size'
+		 */
+		File(Allocator &alloc, char const *name,
+		     size_t chunk_size = DEFAULT_CHUNK_SIZE)
+		:
+			_alloc(alloc), _chunk(_create_chunks(alloc, chunk_size)), _length(0)
+		{
+			Node::name(name);
+		}
+
+		~File() { destroy(&_alloc, &_chunk); }
 
 		size_t read(char *dst, size_t len, seek_off_t seek_offset)
 		{
@@ -84,9 +162,11 @@ class File_system::File : public Node
 			if (seek_offset == SEEK_TAIL)
 				seek_offset = _length;
 
-			if (seek_offset + len >= Chunk_level_0::SIZE) {
-				len = (Chunk_level_0::SIZE-1) - seek_offset;
-				PERR("%s: size limit %d reached", name(), Chunk_level_0::SIZE);
+			file_size_t const max_size = _chunk.max_size();
+
+			if (seek_offset + len >= max_size) {
+				len = (max_size-1) - seek_offset;
+				PERR("%s: size limit %llu reached", name(), max_size);
 			}
 
 			_chunk.write(src, len, (size_t)seek_offset);
@@ -0,0 +1,111 @@
+/*
+ * \brief  Decoder for the LZ4 block format
+ * \author Genode Labs
+ * \date   2016-06-20
+ *
+ * The decoder handles raw LZ4 blocks as produced by 'LZ4_compress' (not the
+ * LZ4 frame format). It operates on memory only and checks all bounds, so it
+ * can safely be applied to untrusted input.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__UTIL__LZ4_H_
+#define _INCLUDE__UTIL__LZ4_H_
+
+#include <base/exception.h>
+#include <base/stdint.h>
+#include <util/string.h>
+
+namespace Genode { namespace Lz4 {
+
+	class Malformed_input : public Exception { };
+
+	inline size_t decompress(char const *src, size_t src_len,
+	                         char *dst, size_t dst_len);
+} }
+
+
+/**
+ * Decompress LZ4 block
+ *
+ * \param src      compressed block
+ * \param src_len  size of compressed block in bytes
+ * \param dst      destination buffer
+ * \param dst_len  capacity of destination buffer in bytes
+ *
+ * \return  number of decompressed bytes
+ *
+ * \throw Malformed_input  block is corrupt or does not fit into 'dst'
+ */
+Genode::size_t Genode::Lz4::decompress(char const *src, size_t src_len,
+                                       char *dst, size_t dst_len)
+{
+	uint8_t const *ip     = (uint8_t const *)src;
+	uint8_t const *ip_end = ip + src_len;
+	uint8_t       *op     = (uint8_t *)dst;
+	uint8_t       *op_end = op + dst_len;
+
+	enum { MIN_MATCH = 4 };
+
+	/* read length extension bytes following a nibble of value 15 */
+	auto read_length = [&] (size_t len)
+	{
+		if (len != 15) return len;
+
+		for (uint8_t b = 255; b == 255; ) {
+			if (ip >= ip_end) throw Malformed_input();
+			b = *ip++;
+			len += b;
+		}
+		return len;
+	};
+
+	while (ip < ip_end) {
+
+		unsigned const token = *ip++;
+
+		/* copy literals */
+		size_t const literals = read_length(token >> 4);
+
+		if (literals > (size_t)(ip_end - ip) || literals > (size_t)(op_end - op))
+			throw Malformed_input();
+
+		memcpy(op, ip, literals);
+		ip += literals;
+		op += literals;
+
+		/* the last sequence consists of literals only */
+		if (ip == ip_end)
+			break;
+
+		/* copy match */
+		if (ip_end - ip < 2)
+			throw Malformed_input();
+
+		size_t const offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+
+		if (offset == 0 || offset > (size_t)(op - (uint8_t *)dst))
+			throw Malformed_input();
+
+		size_t const match_len = read_length(token & 0xf) + MIN_MATCH;
+
+		if (match_len > (size_t)(op_end - op))
+			throw Malformed_input();
+
+		/* byte-wise copy because source and destination may overlap */
+		uint8_t const *match = op - offset;
+		for (size_t i = 0; i < match_len; i++)
+			*op++ = *match++;
+	}
+
+	return op - (uint8_t *)dst;
+}
+
+#endif /* _INCLUDE__UTIL__LZ4_H_ */
@@ -15,6 +15,7 @@
 #define _INCLUDE__VFS__TAR_FILE_SYSTEM_H_
 
 #include <rom_session/connection.h>
+#include <os/compressed_archive.h>
 #include <vfs/file_system.h>
 #include <vfs/vfs_handle.h>
 
@@ -41,6 +42,65 @@ class Vfs::Tar_file_system : public File_system
 	char                         *_tar_base;
 	file_size                     _tar_size;
 
+	/*
+	 * Block-compressed archive, or 0 if the archive is stored uncompressed
+	 */
+	Genode::Compressed_archive   *_compressed;
+
+	static Genode::Compressed_archive *_init_compressed(Xml_node config,
+	                                                    char const *base,
+	                                                    file_size size)
+	{
+		if (!Genode::Compressed_archive::probe(base, size))
+			return 0;
+
+		Genode::size_t const cache_size =
+			config.attribute_value("cache", Genode::Number_of_bytes(1024*1024));
+		unsigned const threads =
+			config.attribute_value("threads", 0U);
+
+		try {
+			return new (env()->heap())
+				Genode::Compressed_archive(*env()->heap(), base, size,
+				                           cache_size, threads);
+		}
+		catch (Genode::Compressed_archive::Invalid_archive) {
+			PERR("compressed tar archive is corrupt");
+			return 0;
+		}
+	}
+
+	/**
+	 * Copy uncompressed archive content at 'offset' to 'dst'
+	 *
+	 * \return  false if the content could not be decompressed
+	 */
+	bool _read(file_size offset, char *dst, file_size count)
+	{
+		if (_compressed) {
+			try { _compressed->read(offset, dst, count); }
+			catch (Genode::Compressed_archive::Invalid_archive) {
+				PERR("corrupt block in compressed tar archive at offset %llu",
+				     offset);
+				return false;
+			}
+			return true;
+		}
+
+		if (offset < _tar_size)
+			memcpy(dst, _tar_base + offset, min(count, _tar_size - offset));
+
+		return true;
+	}
+
+	/**
+	 * Return size of the uncompressed archive content
+	 */
+	file_size _content_size() const
+	{
+		return _compressed ? _compressed->size() : _tar_size;
+	}
+
 	class Record
 	{
 		private:
@@ -89,24 +149,24 @@ class Vfs::Tar_file_system : public File_system
 			unsigned           type() const { return _read(_type); }
 			char const        *name() const { return _name;        }
 			char const *linked_name() const { return _linked_name; }
-
-			void *data() const { return (char *)this + BLOCK_LEN; }
 	};
 
 
+	struct Node;
+
 	class Tar_vfs_handle : public Vfs_handle
 	{
 		private:
 
-			Record const *_record;
+			Node const *_node;
 
 		public:
 
-			Tar_vfs_handle(File_system &fs, Allocator &alloc, int status_flags, Record const *record)
-			: Vfs_handle(fs, fs, alloc, status_flags), _record(record)
+			Tar_vfs_handle(File_system &fs, Allocator &alloc, int status_flags, Node const *node)
+			: Vfs_handle(fs, fs, alloc, status_flags), _node(node)
 			{ }
 
-			Record const *record() const { return _record; }
+			Node const *node() const { return _node; }
 	};
 
 
@@ -126,8 +186,10 @@ class Vfs::Tar_file_system : public File_system
 	{
 		char const *name;
 		Record const *record;
+		file_size data_offset;  /* position of file content within archive */
 
-		Node(char const *name, Record const *record) : name(name), record(record) { }
+		Node(char const *name, Record const *record, file_size data_offset)
+		: name(name), record(record), data_offset(data_offset) { }
 
 		Node *lookup(char const *name)
 		{
@@ -210,7 +272,7 @@ class Vfs::Tar_file_system : public File_system
 
 			Add_node_action(Node &root_node) : _root_node(root_node) { }
 
-			void operator()(Record const *record)
+			void operator()(Record const *record, file_size data_offset)
 			{
 				Absolute_path current_path(record->name());
 
@@ -249,7 +311,8 @@ class Vfs::Tar_file_system : public File_system
 							/* Found a node for the record to be inserted.
 							 * This is usually a directory node without
 							 * record. */
-							child_node->record = record;
+							child_node->record      = record;
+							child_node->data_offset = data_offset;
 						}
 					} else {
 						if (remaining_path.has_single_element()) {
@@ -265,7 +328,7 @@ class Vfs::Tar_file_system : public File_system
 							Genode::size_t name_size = strlen(path_element) + 1;
 							char *name = (char*)env()->heap()->alloc(name_size);
 							strncpy(name, path_element, name_size);
-							child_node = new (env()->heap()) Node(name, record);
+							child_node = new (env()->heap()) Node(name, record, data_offset);
 						} else {
 
 							if (verbose)
@@ -275,7 +338,7 @@ class Vfs::Tar_file_system : public File_system
 							Genode::size_t name_size = strlen(path_element) + 1;
 							char *name = (char*)env()->heap()->alloc(name_size);
 							strncpy(name, path_element, name_size);
-							child_node = new (env()->heap()) Node(name, 0);
+							child_node = new (env()->heap()) Node(name, 0, 0);
 						}
 						parent_node->insert(child_node);
 					}
@@ -290,15 +353,30 @@ class Vfs::Tar_file_system : public File_system
 	template <typename Tar_record_action>
 	void _for_each_tar_record_do(Tar_record_action tar_record_action)
 	{
+		file_size const content_size = _content_size();
+
 		/* measure size of archive in blocks */
-		unsigned block_id = 0, block_cnt = _tar_size/Record::BLOCK_LEN;
+		unsigned block_id = 0, block_cnt = content_size/Record::BLOCK_LEN;
 
 		/* scan metablocks of archive */
 		while (block_id < block_cnt) {
 
-			Record *record = (Record *)(_tar_base + block_id*Record::BLOCK_LEN);
+			file_size const record_offset = (file_size)block_id*Record::BLOCK_LEN;
+
+			/*
+			 * Records of a compressed archive are not accessible in place.
+			 * Hence, we keep a copy of each metablock.
+			 */
+			Record *record = (Record *)(_tar_base + record_offset);
+			if (_compressed) {
+				record = (Record *)env()->heap()->alloc(sizeof(Record));
+				if (!_read(record_offset, (char *)record, sizeof(Record))) {
+					env()->heap()->free(record, sizeof(Record));
+					break;
+				}
+			}
 
-			tar_record_action(record);
+			tar_record_action(record, record_offset + Record::BLOCK_LEN);
 
 			file_size size = record->size();
 
@@ -309,13 +387,15 @@ class Vfs::Tar_file_system : public File_system
 			if (size % Record::BLOCK_LEN != 0) block_id++;
 
 			/* check for end of tar archive */
-			if (block_id*Record::BLOCK_LEN >= _tar_size)
+			if (block_id*Record::BLOCK_LEN >= content_size)
 				break;
 
 			/* lookout for empty eof-blocks */
-			if (*(_tar_base + (block_id*Record::BLOCK_LEN)) == 0x00)
-				if (*(_tar_base + (block_id*Record::BLOCK_LEN + 1)) == 0x00)
-					break;
+			char eof_marker[2];
+			if (!_read(block_id*Record::BLOCK_LEN, eof_marker, sizeof(eof_marker)))
+				break;
+			if (eof_marker[0] == 0x00 && eof_marker[1] == 0x00)
+				break;
 		}
 	}
 
@@ -373,12 +453,21 @@ class Vfs::Tar_file_system : public File_system
 			_tar_ds(_rom.dataspace()),
 			_tar_base(env()->rm_session()->attach(_tar_ds)),
 			_tar_size(Dataspace_client(_tar_ds).size()),
-			_root_node("", 0),
+			_compressed(_init_compressed(config, _tar_base, _tar_size)),
+			_root_node("", 0, 0),
 			_cached_num_dirent(_root_node)
 		{
 			PINF("tar archive '%s' local at %p, size is %llu",
 			     _rom_name.name, _tar_base, _tar_size);
 
+			if (_compressed)
+				PINF("tar archive is compressed, uncompressed size is %llu",
+				     _content_size());
+
+			/* provide an empty file system if the archive is unusable */
+			if (!_compressed && Genode::Compressed_archive::probe(_tar_base, _tar_size))
+				return;
+
 			_for_each_tar_record_do(Add_node_action(_root_node));
 		}
 
@@ -404,11 +493,14 @@ class Vfs::Tar_file_system : public File_system
 				Ram_dataspace_capability ds_cap =
 					env()->ram_session()->alloc(record->size());
 
-				void *local_addr = env()->rm_session()->attach(ds_cap);
-				memcpy(local_addr, record->data(), record->size());
+				char *local_addr = env()->rm_session()->attach(ds_cap);
+				bool const ok = _read(node->data_offset, local_addr, record->size());
 				env()->rm_session()->detach(local_addr);
 
-				return ds_cap;
+				if (ok)
+					return ds_cap;
+
+				env()->ram_session()->free(ds_cap);
 			}
 			catch (...) { PDBG("Could not create new dataspace"); }
 
@@ -586,7 +678,7 @@ class Vfs::Tar_file_system : public File_system
 			if (!node || !node->record || node->record->type() != Record::TYPE_FILE)
 				return OPEN_ERR_UNACCESSIBLE;
 
-			*out_handle = new (alloc) Tar_vfs_handle(*this, alloc, 0, node->record);
+			*out_handle = new (alloc) Tar_vfs_handle(*this, alloc, 0, node);
 
 			return OPEN_OK;
 		}
@@ -624,16 +716,15 @@ class Vfs::Tar_file_system : public File_system
 		{
 			Tar_vfs_handle const *handle = static_cast<Tar_vfs_handle *>(vfs_handle);
 
-			file_size const record_size = handle->record()->size();
+			file_size const record_size = handle->node()->record->size();
 
 			file_size const record_bytes_left = record_size >= handle->seek()
 			                                  ? record_size  - handle->seek() : 0;
 
 			count = min(record_bytes_left, count);
 
-			char const *data = (char *)handle->record()->data() + handle->seek();
-
-			memcpy(dst, data, count);
+			if (!_read(handle->node()->data_offset + handle->seek(), dst, count))
+				return READ_ERR_IO;
 
 			out_count = count;
 			return READ_OK;
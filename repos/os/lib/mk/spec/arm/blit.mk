@@ -1,5 +1,15 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc kernels.cc
 REQUIRES = arm 32bit
-INC_DIR += $(REP_DIR)/src/lib/blit/spec/arm
+INC_DIR += $(REP_DIR)/src/lib/blit/spec/arm \
+           $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+#
+# NEON is optional for ARMv7 CPUs and cannot be probed at runtime, so the
+# NEON kernels must be enabled explicitly via the 'neon' spec value.
+#
+ifneq ($(filter neon,$(SPECS)),)
+CC_OPT_kernels += -mfpu=neon
+endif
+
+vpath blit.cc    $(REP_DIR)/src/lib/blit
+vpath kernels.cc $(REP_DIR)/src/lib/blit/spec/arm
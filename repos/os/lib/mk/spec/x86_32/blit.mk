@@ -1,6 +1,11 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc kernels.cc
 REQUIRES = x86 32bit
 INC_DIR += $(REP_DIR)/src/lib/blit/spec/x86_32 \
-           $(REP_DIR)/src/lib/blit/spec/x86
+           $(REP_DIR)/src/lib/blit/spec/x86 \
+           $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+# 32-byte vectors are used only within the AVX2 kernels
+CC_OPT_kernels += -Wno-psabi
+
+vpath blit.cc    $(REP_DIR)/src/lib/blit
+vpath kernels.cc $(REP_DIR)/src/lib/blit/spec/x86
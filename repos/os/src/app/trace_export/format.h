@@ -0,0 +1,411 @@
+/*
+ * \brief  Trace-export formats
+ * \author Genode Labs
+ * \date   2016-07-15
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _FORMAT_H_
+#define _FORMAT_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/fixed_stdint.h>
+#include <util/list.h>
+
+/* local includes */
+#include <output.h>
+
+namespace Trace_export {
+
+	struct Format;
+	class  Chrome_format;
+	class  Ctf_format;
+}
+
+
+/**
+ * Interface of the export formats
+ *
+ * Processes are identified by 'pid', which refers to a session label, and
+ * threads by 'tid', which is the ID of the trace subject.
+ */
+struct Trace_export::Format
+{
+	virtual ~Format() { }
+
+	/**
+	 * Announce traced thread
+	 */
+	virtual void thread(unsigned pid, char const *label,
+	                    unsigned tid, char const *name) = 0;
+
+	/**
+	 * Export trace event
+	 *
+	 * \param cycles  timestamp in cycles
+	 * \param seq     sequence number of the event within the thread
+	 */
+	virtual void event(unsigned pid, unsigned tid, uint64_t cycles,
+	                   unsigned long seq, char const *data, size_t len) = 0;
+
+	/**
+	 * Report events that were overwritten before being exported
+	 */
+	virtual void lost(unsigned pid, unsigned tid, uint64_t cycles,
+	                  unsigned long count) = 0;
+
+	/**
+	 * Complete export of a thread that is no longer traced
+	 */
+	virtual void thread_released(unsigned pid, unsigned tid) = 0;
+
+	/**
+	 * Write buffered events
+	 */
+	virtual void flush() = 0;
+
+	/**
+	 * Complete export
+	 */
+	virtual void finish() = 0;
+};
+
+
+/**
+ * JSON trace-event format as understood by Chrome's 'about:tracing'
+ *
+ * Trace events are exported as instant events. The timestamps are
+ * converted to microseconds relative to the start of the export.
+ */
+class Trace_export::Chrome_format : public Format
+{
+	private:
+
+		Output &_out;
+
+		uint64_t      const _base_cycles;
+		unsigned long const _cycles_per_us;
+
+		bool _first = true;
+
+		void _begin_event()
+		{
+			_out.append(_first ? "\n" : ",\n");
+			_first = false;
+		}
+
+		void _string(char const *str, size_t len)
+		{
+			_out.append("\"");
+			for (size_t i = 0; i < len && str[i]; i++) {
+				char const c = str[i];
+				if (c == '"' || c == '\\') {
+					char const esc[2] = { '\\', c };
+					_out.append(esc, 2);
+				} else if ((unsigned char)c < 0x20) {
+					_out.printf("\\u%04x", (unsigned)c);
+				} else {
+					_out.append(&c, 1);
+				}
+			}
+			_out.append("\"");
+		}
+
+		void _string(char const *str) { _string(str, strlen(str)); }
+
+		void _timestamp(uint64_t cycles)
+		{
+			uint64_t const ns = cycles > _base_cycles
+			                  ? (cycles - _base_cycles)*1000/_cycles_per_us : 0;
+
+			_out.printf("\"ts\":%llu.%03llu", (unsigned long long)(ns/1000),
+			            (unsigned long long)(ns%1000));
+		}
+
+	public:
+
+		Chrome_format(Output &out, uint64_t base_cycles,
+		              unsigned long cycles_per_us)
+		:
+			_out(out), _base_cycles(base_cycles),
+			_cycles_per_us(max(cycles_per_us, 1UL))
+		{
+			_out.append("[");
+		}
+
+		void thread(unsigned pid, char const *label,
+		            unsigned tid, char const *name) override
+		{
+			_begin_event();
+			_out.printf("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,"
+			            "\"args\":{\"name\":", pid);
+			_string(label);
+			_out.append("}}");
+
+			_begin_event();
+			_out.printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,"
+			            "\"tid\":%u,\"args\":{\"name\":", pid, tid);
+			_string(name);
+			_out.append("}}");
+		}
+
+		void event(unsigned pid, unsigned tid, uint64_t cycles,
+		           unsigned long seq, char const *data, size_t len) override
+		{
+			/* strip trailing line breaks */
+			while (len && (data[len - 1] == '\n' || data[len - 1] == 0))
+				len--;
+
+			_begin_event();
+			_out.append("{\"name\":");
+			_string(data, len);
+			_out.printf(",\"ph\":\"i\",\"s\":\"t\",\"pid\":%u,\"tid\":%u,",
+			            pid, tid);
+			_timestamp(cycles);
+			_out.printf(",\"args\":{\"seq\":%lu}}", seq);
+		}
+
+		void lost(unsigned pid, unsigned tid, uint64_t cycles,
+		          unsigned long count) override
+		{
+			_begin_event();
+			_out.printf("{\"name\":\"lost events\",\"ph\":\"i\",\"s\":\"t\","
+			            "\"pid\":%u,\"tid\":%u,", pid, tid);
+			_timestamp(cycles);
+			_out.printf(",\"args\":{\"count\":%lu}}", count);
+		}
+
+		void thread_released(unsigned, unsigned) override { }
+
+		void flush() override { _out.flush(); }
+
+		void finish() override
+		{
+			_out.append("\n]\n");
+			_out.flush();
+		}
+};
+
+
+/**
+ * Common Trace Format (CTF 1.8)
+ *
+ * The export consists of the 'metadata' file describing the event layout
+ * and one stream file per traced thread containing its events in binary
+ * form. CTF requires the timestamps within a stream to increase
+ * monotonically, which holds for the events of a single thread. Each
+ * stream starts with the 'thread' event that names the thread. The
+ * timestamps are the raw cycle counts of the traced threads.
+ */
+class Trace_export::Ctf_format : public Format
+{
+	private:
+
+		enum Event_id { EVENT = 0, LOST = 1, THREAD = 2 };
+
+		struct Stream : List<Stream>::Element
+		{
+			unsigned const tid;
+			Output         out;
+
+			Stream(File_system::Session &fs, char const *dir,
+			       char const *name, unsigned tid)
+			: tid(tid), out(fs, dir, name) { }
+
+			void header(uint64_t cycles, Event_id id)
+			{
+				out.append_binary(cycles);
+				out.append_binary((uint32_t)id);
+			}
+		};
+
+		File_system::Session &_fs;
+		char const           *_dir;
+
+		List<Stream> _streams;
+
+		/* streams are numbered because subject IDs may be reused */
+		unsigned _num_streams = 0;
+
+		Stream *_stream(unsigned tid)
+		{
+			for (Stream *s = _streams.first(); s; s = s->next())
+				if (s->tid == tid)
+					return s;
+			return nullptr;
+		}
+
+		void _destroy(Stream *s)
+		{
+			_streams.remove(s);
+			destroy(env()->heap(), s);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param dir  directory of the stream files, must stay valid
+		 *
+		 * 	hrow File_system::Exception
+		 */
+		Ctf_format(File_system::Session &fs, char const *dir,
+		           Output &metadata, unsigned long cycles_per_us)
+		:
+			_fs(fs), _dir(dir)
+		{
+			metadata.append(
+				"/* CTF 1.8 */\n"
+				"typealias integer { size = 32; align = 8; signed = false; } := uint32_t;\n"
+				"typealias integer { size = 64; align = 8; signed = false; } := uint64_t;\n"
+				"\n"
+				"trace {\n"
+				"\tmajor = 1;\n"
+				"\tminor = 8;\n"
+				"\tbyte_order = le;\n"
+				"};\n"
+				"\n"
+				"clock {\n"
+				"\tname = cycles;\n");
+
+			metadata.printf("\tfreq = %llu;\n",
+			                (unsigned long long)max(cycles_per_us, 1UL)*1000*1000);
+
+			metadata.append(
+				"};\n"
+				"\n"
+				"typealias integer {\n"
+				"\tsize = 64; align = 8; signed = false;\n"
+				"\tmap = clock.cycles.value;\n"
+				"} := cycles_t;\n"
+				"\n"
+				"stream {\n"
+				"\tevent.header := struct {\n"
+				"\t\tcycles_t timestamp;\n"
+				"\t\tuint32_t id;\n"
+				"\t};\n"
+				"};\n"
+				"\n"
+				"event {\n"
+				"\tname = \"trace\";\n"
+				"\tid = 0;\n"
+				"\tfields := struct {\n"
+				"\t\tuint32_t pid;\n"
+				"\t\tuint32_t tid;\n"
+				"\t\tuint64_t seq;\n"
+				"\t\tstring   msg;\n"
+				"\t};\n"
+				"};\n"
+				"\n"
+				"event {\n"
+				"\tname = \"lost\";\n"
+				"\tid = 1;\n"
+				"\tfields := struct {\n"
+				"\t\tuint32_t pid;\n"
+				"\t\tuint32_t tid;\n"
+				"\t\tuint64_t count;\n"
+				"\t};\n"
+				"};\n"
+				"\n"
+				"event {\n"
+				"\tname = \"thread\";\n"
+				"\tid = 2;\n"
+				"\tfields := struct {\n"
+				"\t\tuint32_t pid;\n"
+				"\t\tuint32_t tid;\n"
+				"\t\tstring   label;\n"
+				"\t\tstring   name;\n"
+				"\t};\n"
+				"};\n");
+
+			metadata.flush();
+		}
+
+		~Ctf_format()
+		{
+			while (Stream *s = _streams.first())
+				_destroy(s);
+		}
+
+		void thread(unsigned pid, char const *label,
+		            unsigned tid, char const *name) override
+		{
+			char file_name[32];
+			snprintf(file_name, sizeof(file_name), "stream_%u", _num_streams++);
+
+			Stream *s = nullptr;
+			try {
+				s = new (env()->heap()) Stream(_fs, _dir, file_name, tid);
+			} catch (...) {
+				PERR("could not create CTF stream '%s'", file_name);
+				return;
+			}
+			_streams.insert(s);
+
+			/* precedes all events of the thread */
+			s->header(0, THREAD);
+			s->out.append_binary((uint32_t)pid);
+			s->out.append_binary((uint32_t)tid);
+			s->out.append_cstring(label, strlen(label));
+			s->out.append_cstring(name, strlen(name));
+		}
+
+		void event(unsigned pid, unsigned tid, uint64_t cycles,
+		           unsigned long seq, char const *data, size_t len) override
+		{
+			Stream *s = _stream(tid);
+			if (!s)
+				return;
+
+			/* the message must not contain the string terminator */
+			size_t n = 0;
+			while (n < len && data[n]) n++;
+
+			s->header(cycles, EVENT);
+			s->out.append_binary((uint32_t)pid);
+			s->out.append_binary((uint32_t)tid);
+			s->out.append_binary((uint64_t)seq);
+			s->out.append_cstring(data, n);
+		}
+
+		void lost(unsigned pid, unsigned tid, uint64_t cycles,
+		          unsigned long count) override
+		{
+			Stream *s = _stream(tid);
+			if (!s)
+				return;
+
+			s->header(cycles, LOST);
+			s->out.append_binary((uint32_t)pid);
+			s->out.append_binary((uint32_t)tid);
+			s->out.append_binary((uint64_t)count);
+		}
+
+		void thread_released(unsigned, unsigned tid) override
+		{
+			if (Stream *s = _stream(tid))
+				_destroy(s);
+		}
+
+		void flush() override
+		{
+			for (Stream *s = _streams.first(); s; s = s->next())
+				s->out.flush();
+		}
+
+		void finish() override
+		{
+			while (Stream *s = _streams.first())
+				_destroy(s);
+		}
+};
+
+#endif /* _FORMAT_H_ */
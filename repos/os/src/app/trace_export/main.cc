@@ -0,0 +1,527 @@
+/*
+ * \brief  Export of trace events to a file system
+ * \author Genode Labs
+ * \date   2016-07-15
+ *
+ * The component enables tracing for the threads matching the configured
+ * policies, periodically collects the events of all traced threads, and
+ * writes them to a file system in the Chrome trace-event JSON format or
+ * the Common Trace Format (CTF). In addition, it lets core sample the
+ * execution state of threads and exports the samples for the
+ * 'trace_profile' host tool.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/env.h>
+#include <base/trace/buffer.h>
+#include <dataspace/client.h>
+#include <os/config.h>
+#include <os/path.h>
+#include <os/server.h>
+#include <rom_session/connection.h>
+#include <timer_session/connection.h>
+#include <trace_session/connection.h>
+#include <util/list.h>
+#include <util/volatile_object.h>
+
+/* local includes */
+#include <format.h>
+#include <sample_file.h>
+
+namespace Trace_export {
+
+	struct Selector;
+	struct Policy;
+	struct Sample_policy;
+	struct Process;
+	struct Subject;
+	struct Main;
+
+	enum {
+		BLOCK_SIZE  = 512,
+		QUEUE_SIZE  = File_system::Session::TX_QUEUE_SIZE,
+		TX_BUF_SIZE = BLOCK_SIZE*(QUEUE_SIZE*2 + 1),
+	};
+}
+
+
+/**
+ * Selection of the threads matching a session-label prefix and,
+ * optionally, a thread name
+ */
+struct Trace_export::Selector
+{
+	typedef String<Session_label::capacity()> Label;
+
+	Label              const label;
+	Trace::Thread_name const thread;
+
+	Selector(Xml_node node)
+	:
+		label (node.attribute_value("label",  Label())),
+		thread(node.attribute_value("thread", Trace::Thread_name()))
+	{ }
+
+	bool matches(Trace::Subject_info const &info) const
+	{
+		size_t const len = strlen(label.string());
+
+		if (strcmp(info.session_label().string(), label.string(), len))
+			return false;
+
+		return !thread.valid() || thread == info.thread_name();
+	}
+};
+
+
+/**
+ * Trace policy for the selected threads
+ */
+struct Trace_export::Policy : Selector, List<Policy>::Element
+{
+	typedef String<64> Module_name;
+
+	Module_name const module;
+
+	Trace::Policy_id id;
+
+	Policy(Xml_node node)
+	:
+		Selector(node),
+		module(node.attribute_value("module", Module_name()))
+	{ }
+
+	/**
+	 * Load policy module into the TRACE session
+	 *
+	 * \throw Rom_connection::Rom_connection_failed
+	 */
+	void load(Trace::Connection &trace)
+	{
+		Rom_connection rom(module.string());
+		Dataspace_capability const rom_ds = rom.dataspace();
+		size_t const size = Dataspace_client(rom_ds).size();
+
+		id = trace.alloc_policy(size);
+		Dataspace_capability const ds = trace.policy(id);
+
+		void *dst = env()->rm_session()->attach(ds);
+		void *src = env()->rm_session()->attach(rom_ds);
+		memcpy(dst, src, size);
+		env()->rm_session()->detach(dst);
+		env()->rm_session()->detach(src);
+	}
+};
+
+
+/**
+ * Sampling of the execution state of the selected threads
+ */
+struct Trace_export::Sample_policy : Selector, List<Sample_policy>::Element
+{
+	unsigned        const depth;
+	Number_of_bytes const buffer_size;
+
+	Sample_policy(Xml_node node)
+	:
+		Selector(node),
+		depth(node.attribute_value("depth", 16U)),
+		buffer_size(node.attribute_value("buffer_size", Number_of_bytes(16*1024)))
+	{ }
+};
+
+
+/**
+ * Session label of traced threads, exported as process
+ */
+struct Trace_export::Process : List<Process>::Element
+{
+	Session_label const label;
+	unsigned      const pid;
+
+	Process(Session_label const &label, unsigned pid) : label(label), pid(pid) { }
+};
+
+
+/**
+ * Traced or sampled thread
+ */
+struct Trace_export::Subject : List<Subject>::Element
+{
+	Trace::Subject_id const id;
+	unsigned          const pid;
+
+	/* trace events, or nullptr if the thread is not traced */
+	Trace::Buffer        *buffer = nullptr;
+	Trace::Buffer::Cursor cursor;
+	unsigned long         exported_lost = 0;
+
+	/* execution samples, or nullptr if the thread is not sampled */
+	Trace::Buffer        *samples = nullptr;
+	Trace::Buffer::Cursor sample_cursor;
+	unsigned long         exported_sample_lost = 0;
+
+	Subject(Trace::Subject_id id, unsigned pid) : id(id), pid(pid) { }
+
+	~Subject()
+	{
+		if (buffer)  env()->rm_session()->detach(buffer);
+		if (samples) env()->rm_session()->detach(samples);
+	}
+};
+
+
+struct Trace_export::Main
+{
+	Server::Entrypoint &ep;
+
+	Xml_node const config = Genode::config()->xml_node();
+
+	enum { MAX_SUBJECTS = 512, MAX_EVENT_SIZE = 1024 };
+
+	Number_of_bytes const trace_quota =
+		config.attribute_value("trace_quota", Number_of_bytes(4*1024*1024));
+
+	Number_of_bytes const buffer_size =
+		config.attribute_value("buffer_size", Number_of_bytes(64*1024));
+
+	unsigned long const period_ms     = config.attribute_value("period_ms",     1000UL);
+	unsigned long const duration_ms   = config.attribute_value("duration_ms",   0UL);
+	unsigned long const cycles_per_us = config.attribute_value("cycles_per_us", 1000UL);
+
+	typedef String<16> Format_name;
+	Format_name const format_name =
+		config.attribute_value("format", Format_name("chrome"));
+
+	bool const ctf = (format_name == "ctf");
+
+	typedef String<64> File_name;
+	File_name const file_name =
+		config.attribute_value("file", File_name(ctf ? "trace.ctf" : "trace.json"));
+
+	File_name const sample_file_name =
+		config.attribute_value("sample_file", File_name("samples"));
+
+	unsigned long const sample_period_ms =
+		config.attribute_value("sample_period_ms", 10UL);
+
+	Trace::Connection trace {
+		trace_quota, 64*1024,
+		config.attribute_value("parent_levels", 0U) };
+
+	Timer::Connection timer;
+	Timer::Connection sample_timer;
+
+	unsigned long const start_ms = timer.elapsed_ms();
+
+	Allocator_avl           fs_alloc { env()->heap() };
+	File_system::Connection fs       { fs_alloc, TX_BUF_SIZE };
+
+	/* output of the Chrome format, or the CTF metadata */
+	Lazy_volatile_object<Output> output;
+
+	Path<256> const ctf_dir { file_name.string(), "/" };
+
+	Lazy_volatile_object<Chrome_format> chrome;
+	Lazy_volatile_object<Ctf_format>    ctf_format;
+
+	Lazy_volatile_object<Output>      sample_output;
+	Lazy_volatile_object<Sample_file> sample_file;
+
+	Format *format = nullptr;
+
+	List<Policy>        policies;
+	List<Sample_policy> sample_policies;
+	List<Process>       processes;
+	List<Subject>       subjects;
+
+	unsigned next_pid = 1;
+
+	unsigned long num_events  = 0;
+	unsigned long num_lost    = 0;
+	unsigned long num_samples = 0;
+
+	bool finished = false;
+
+	Trace::Subject_id subject_ids[MAX_SUBJECTS];
+
+	char event_buf[MAX_EVENT_SIZE];
+
+	unsigned pid(Session_label const &label)
+	{
+		for (Process *p = processes.first(); p; p = p->next())
+			if (p->label == label)
+				return p->pid;
+
+		Process *p = new (env()->heap()) Process(label, next_pid++);
+		processes.insert(p);
+		return p->pid;
+	}
+
+	Subject *lookup(Trace::Subject_id id)
+	{
+		for (Subject *s = subjects.first(); s; s = s->next())
+			if (s->id == id)
+				return s;
+		return nullptr;
+	}
+
+	template <typename T>
+	static T *selected(List<T> &list, Trace::Subject_info const &info)
+	{
+		for (T *p = list.first(); p; p = p->next())
+			if (p->matches(info))
+				return p;
+		return nullptr;
+	}
+
+	void collect_samples(Subject &s)
+	{
+		Trace::Buffer::Entry_info info;
+		Trace::Sample sample;
+
+		while (s.samples->read(s.sample_cursor, info, (char *)&sample,
+		                       sizeof(sample))) {
+
+			if (s.sample_cursor.lost != s.exported_sample_lost) {
+				sample_file->lost(s.id.id, s.sample_cursor.lost - s.exported_sample_lost);
+				s.exported_sample_lost = s.sample_cursor.lost;
+			}
+
+			/* ignore truncated entries */
+			if (info.length < sample.size() || info.length > sizeof(sample))
+				continue;
+
+			sample_file->sample(s.id.id, info.timestamp, sample);
+			num_samples++;
+		}
+	}
+
+	void collect(Subject &s)
+	{
+		if (s.samples)
+			collect_samples(s);
+
+		if (!s.buffer)
+			return;
+
+		Trace::Buffer::Entry_info info;
+
+		while (s.buffer->read(s.cursor, info, event_buf, sizeof(event_buf))) {
+
+			if (s.cursor.lost != s.exported_lost) {
+				format->lost(s.pid, s.id.id, info.timestamp,
+				             s.cursor.lost - s.exported_lost);
+				num_lost       += s.cursor.lost - s.exported_lost;
+				s.exported_lost = s.cursor.lost;
+			}
+
+			format->event(s.pid, s.id.id, info.timestamp, info.seq, event_buf,
+			              min(info.length, sizeof(event_buf)));
+			num_events++;
+		}
+	}
+
+	void release(Subject &s)
+	{
+		collect(s);
+		if (s.buffer)
+			format->thread_released(s.pid, s.id.id);
+		subjects.remove(&s);
+
+		Trace::Subject_id const id = s.id;
+		destroy(env()->heap(), &s);
+		trace.free(id);
+	}
+
+	/**
+	 * Enable tracing and sampling of a new subject
+	 *
+	 * \return true if the subject is traced or sampled
+	 */
+	bool enable(Subject &s, Trace::Subject_info const &info,
+	            Policy *policy, Sample_policy *sample_policy)
+	{
+		try {
+			if (policy) {
+				trace.trace(s.id, policy->id, buffer_size);
+				s.buffer = env()->rm_session()->attach(trace.buffer(s.id));
+			}
+
+			if (sample_policy) {
+				trace.sample(s.id, sample_policy->buffer_size,
+				             sample_policy->depth);
+				s.samples = env()->rm_session()->attach(trace.sample_buffer(s.id));
+			}
+		}
+		catch (Trace::Source_is_dead)          { }
+		catch (Trace::Already_traced)          { }
+		catch (Trace::Traced_by_other_session) { }
+		catch (Trace::Out_of_metadata) {
+			PWRN("trace quota exceeded, cannot trace \"%s\" %s",
+			     info.session_label().string(), info.thread_name().string());
+		}
+		return s.buffer || s.samples;
+	}
+
+	/**
+	 * Enable tracing for new subjects that match a policy
+	 */
+	void update_subjects()
+	{
+		size_t const num = trace.subjects(subject_ids, MAX_SUBJECTS);
+
+		for (size_t i = 0; i < num; i++) {
+
+			Trace::Subject_id const id = subject_ids[i];
+			Trace::Subject_info const info = trace.subject_info(id);
+
+			Subject *s = lookup(id);
+
+			if (s && info.state() == Trace::Subject_info::DEAD) {
+				release(*s);
+				continue;
+			}
+
+			if (s || info.state() != Trace::Subject_info::UNTRACED)
+				continue;
+
+			Policy        *p  = selected(policies, info);
+			Sample_policy *sp = selected(sample_policies, info);
+			if (!p && !sp)
+				continue;
+
+			s = new (env()->heap()) Subject(id, pid(info.session_label()));
+
+			if (!enable(*s, info, p, sp)) {
+				destroy(env()->heap(), s);
+				trace.free(id);
+				continue;
+			}
+
+			subjects.insert(s);
+
+			if (s->buffer)
+				format->thread(s->pid, info.session_label().string(),
+				               id.id, info.thread_name().string());
+			if (s->samples)
+				sample_file->thread(id.id, info.session_label().string(),
+				                    info.thread_name().string());
+		}
+	}
+
+	void finish()
+	{
+		while (Subject *s = subjects.first())
+			release(*s);
+
+		format->finish();
+		if (sample_file.constructed())
+			sample_file->flush();
+
+		finished = true;
+
+		PINF("trace export finished: %lu events, %lu lost, %lu samples",
+		     num_events, num_lost, num_samples);
+	}
+
+	void handle_period(unsigned)
+	{
+		if (finished)
+			return;
+
+		update_subjects();
+
+		for (Subject *s = subjects.first(); s; s = s->next())
+			collect(*s);
+
+		format->flush();
+		if (sample_file.constructed())
+			sample_file->flush();
+
+		if (duration_ms && timer.elapsed_ms() - start_ms >= duration_ms) {
+			timer.trigger_periodic(0);
+			sample_timer.trigger_periodic(0);
+			finish();
+		}
+	}
+
+	void handle_sample(unsigned)
+	{
+		if (!finished)
+			trace.take_samples();
+	}
+
+	Signal_rpc_member<Main> period_dispatcher = {
+		ep, *this, &Main::handle_period };
+
+	Signal_rpc_member<Main> sample_dispatcher = {
+		ep, *this, &Main::handle_sample };
+
+	Main(Server::Entrypoint &ep) : ep(ep)
+	{
+		/* open output files */
+		if (ctf) {
+			output.construct(fs, ctf_dir.base(), "metadata");
+
+			ctf_format.construct(fs, ctf_dir.base(), *output, cycles_per_us);
+			format = &*ctf_format;
+		} else {
+			output.construct(fs, "/", file_name.string());
+
+			chrome.construct(*output, Trace::timestamp(), cycles_per_us);
+			format = &*chrome;
+		}
+
+		/* load policies */
+		config.for_each_sub_node("trace_policy", [&] (Xml_node node) {
+			Policy *p = new (env()->heap()) Policy(node);
+			try {
+				p->load(trace);
+				policies.insert(p);
+			} catch (...) {
+				PERR("could not load module '%s' for label '%s'",
+				     p->module.string(), p->label.string());
+				destroy(env()->heap(), p);
+			}
+		});
+
+		config.for_each_sub_node("sample", [&] (Xml_node node) {
+			sample_policies.insert(new (env()->heap()) Sample_policy(node)); });
+
+		if (sample_policies.first()) {
+			sample_output.construct(fs, "/", sample_file_name.string());
+			sample_file.construct(*sample_output);
+
+			sample_timer.sigh(sample_dispatcher);
+			sample_timer.trigger_periodic(1000*max(sample_period_ms, 1UL));
+		}
+
+		timer.sigh(period_dispatcher);
+		timer.trigger_periodic(1000*period_ms);
+
+		PINF("exporting trace in %s format to '%s'",
+		     ctf ? "CTF" : "Chrome JSON", file_name.string());
+	}
+};
+
+
+namespace Server {
+
+	char const *name() { return "trace_export_ep"; }
+
+	size_t stack_size() { return 4*1024*sizeof(long); }
+
+	void construct(Entrypoint &ep)
+	{
+		static Trace_export::Main main(ep);
+	}
+}
@@ -0,0 +1,132 @@
+/*
+ * \brief  Buffered output to a file of a file-system session
+ * \author Genode Labs
+ * \date   2016-07-15
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _OUTPUT_H_
+#define _OUTPUT_H_
+
+/* Genode includes */
+#include <file_system_session/connection.h>
+#include <file_system/util.h>
+#include <base/snprintf.h>
+#include <util/string.h>
+
+namespace Trace_export {
+
+	using namespace Genode;
+
+	class Output;
+}
+
+
+class Trace_export::Output
+{
+	private:
+
+		enum { BUFFER_SIZE = 16*1024 };
+
+		File_system::Session     &_fs;
+		File_system::File_handle  _handle;
+		File_system::seek_off_t   _offset = 0;
+
+		char   _buf[BUFFER_SIZE];
+		size_t _buf_len = 0;
+
+		static File_system::File_handle _open(File_system::Session &fs,
+		                                      char const *dir_path,
+		                                      char const *name)
+		{
+			using namespace File_system;
+
+			Dir_handle   dir_handle = ensure_dir(fs, dir_path);
+			Handle_guard dir_guard(fs, dir_handle);
+
+			File_handle handle = fs.file(dir_handle, name, WRITE_ONLY, true);
+			fs.truncate(handle, 0);
+			return handle;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * Creates the file 'name' within the directory 'dir_path', or
+		 * truncates the file if it already exists.
+		 *
+		 * \throw File_system::Exception
+		 */
+		Output(File_system::Session &fs, char const *dir_path, char const *name)
+		: _fs(fs), _handle(_open(fs, dir_path, name)) { }
+
+		~Output()
+		{
+			flush();
+			_fs.close(_handle);
+		}
+
+		void flush()
+		{
+			if (!_buf_len)
+				return;
+
+			size_t const written = File_system::write(_fs, _handle, _buf,
+			                                          _buf_len, _offset);
+			if (written < _buf_len)
+				PWRN("%zu of %zu bytes have been written", written, _buf_len);
+
+			_offset += written;
+			_buf_len = 0;
+		}
+
+		void append(void const *src, size_t len)
+		{
+			while (len) {
+				if (_buf_len == BUFFER_SIZE)
+					flush();
+
+				size_t const n = min(len, BUFFER_SIZE - _buf_len);
+				memcpy(_buf + _buf_len, src, n);
+
+				_buf_len += n;
+				src       = (char const *)src + n;
+				len      -= n;
+			}
+		}
+
+		void append(char const *str) { append(str, strlen(str)); }
+
+		template <typename T>
+		void append_binary(T const &value) { append(&value, sizeof(value)); }
+
+		/**
+		 * Append null-terminated string
+		 */
+		void append_cstring(char const *str, size_t len)
+		{
+			append(str, len);
+			append("", 1);
+		}
+
+		/**
+		 * Append formatted string
+		 */
+		template <typename... ARGS>
+		void printf(char const *format, ARGS... args)
+		{
+			char buf[256];
+			snprintf(buf, sizeof(buf), format, args...);
+			append(buf);
+		}
+};
+
+#endif /* _OUTPUT_H_ */
@@ -0,0 +1,89 @@
+/*
+ * \brief  Export of execution samples
+ * \author Genode Labs
+ * \date   2016-07-18
+ *
+ * The sample file is processed by the 'trace_profile' host tool. It starts
+ * with the 8-byte magic "GSAMPLE1" followed by a sequence of records in
+ * the byte order of the target. Each record starts with a 32-bit type
+ * and a 32-bit thread ID:
+ *
+ * THREAD  32-bit label length, label, 32-bit name length, name
+ * SAMPLE  64-bit timestamp, 32-bit depth, 'depth' 64-bit addresses
+ * LOST    32-bit count of samples lost
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _SAMPLE_FILE_H_
+#define _SAMPLE_FILE_H_
+
+/* Genode includes */
+#include <base/trace/sample.h>
+
+/* local includes */
+#include <output.h>
+
+namespace Trace_export { class Sample_file; }
+
+
+class Trace_export::Sample_file
+{
+	private:
+
+		enum Type { THREAD = 1, SAMPLE = 2, LOST = 3 };
+
+		Output &_out;
+
+		void _header(Type type, unsigned tid)
+		{
+			_out.append_binary((uint32_t)type);
+			_out.append_binary((uint32_t)tid);
+		}
+
+		void _string(char const *str)
+		{
+			uint32_t const len = strlen(str);
+			_out.append_binary(len);
+			_out.append(str, len);
+		}
+
+	public:
+
+		Sample_file(Output &out) : _out(out) { _out.append("GSAMPLE1", 8); }
+
+		/**
+		 * Announce sampled thread
+		 */
+		void thread(unsigned tid, char const *label, char const *name)
+		{
+			_header(THREAD, tid);
+			_string(label);
+			_string(name);
+		}
+
+		void sample(unsigned tid, uint64_t cycles, Trace::Sample const &sample)
+		{
+			uint32_t const depth = min(sample.depth,
+			                           (uint32_t)Trace::Sample::MAX_DEPTH);
+			_header(SAMPLE, tid);
+			_out.append_binary(cycles);
+			_out.append_binary(depth);
+			_out.append(sample.ip, depth*sizeof(sample.ip[0]));
+		}
+
+		void lost(unsigned tid, unsigned long count)
+		{
+			_header(LOST, tid);
+			_out.append_binary((uint32_t)count);
+		}
+
+		void flush() { _out.flush(); }
+};
+
+#endif /* _SAMPLE_FILE_H_ */
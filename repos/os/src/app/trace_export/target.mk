@@ -0,0 +1,4 @@
+TARGET = trace_export
+SRC_CC = main.cc
+LIBS  += base server config
+INC_DIR += $(PRG_DIR)
@@ -171,6 +171,7 @@ struct Command_fis : Genode::Mmio
 	struct Device   : Register<0x7, 8>
 	{
 		struct Lba   : Bitfield<6, 1> { }; /* enable LBA mode */
+		struct Fua   : Bitfield<7, 1> { }; /* force unit access (NCQ) */
 	};
 
 	/* big endian */
@@ -214,21 +215,23 @@ struct Command_fis : Genode::Mmio
 		write<Command>(0xec);
 	}
 
-	void dma_ext(bool read, Block::sector_t block_number, Genode::size_t block_count)
+	void dma_ext(bool read, Block::sector_t block_number, Genode::size_t block_count,
+	             bool fua)
 	{
 		write<Bits::C>(1);
 		write<Device::Lba>(1);
-		/* read_dma_ext : write_dma_ext */
-		write<Command>(read ? 0x25 : 0x35);
+		/* read_dma_ext : write_dma_fua_ext : write_dma_ext */
+		write<Command>(read ? 0x25 : fua ? 0x3d : 0x35);
 		write<Lba>(block_number);
 		write<Sector>(block_count);
 	}
 
 	void fpdma(bool read, Block::sector_t block_number, Genode::size_t block_count,
-	           unsigned slot)
+	           unsigned slot, bool fua)
 	{
 		write<Bits::C>(1);
 		write<Device::Lba>(1);
+		write<Device::Fua>(fua ? 1 : 0);
 		/* read_fpdma : write_fpdma */
 		write<Command>(read ? 0x60 : 0x61);
 		write<Lba>(block_number);
@@ -236,6 +239,26 @@ struct Command_fis : Genode::Mmio
 		write<Sector0_7::Tag>(slot);
 	}
 
+	void flush_cache_ext()
+	{
+		write<Bits::C>(1);
+		write<Command>(0xea);
+	}
+
+	/**
+	 * Data-set management command with TRIM bit set
+	 *
+	 * \param blocks  number of 512-byte blocks of LBA range entries
+	 */
+	void trim(Genode::size_t blocks)
+	{
+		write<Bits::C>(1);
+		write<Device::Lba>(1);
+		write<Command>(0x06);
+		write<Features>(1);
+		write<Sector>(blocks);
+	}
+
 	void atapi()
 	{
 		write<Bits::C>(1);
@@ -39,6 +39,16 @@ struct Identity : Genode::Mmio
 		struct Ncq_support : Bitfield<8, 1> { };
 	};
 
+	struct Command_set_ext : Register<0xa8, 16>
+	{
+		struct Write_dma_fua_ext : Bitfield<6, 1> { };
+	};
+
+	struct Data_set_mgmt : Register<0x152, 16>
+	{
+		struct Trim : Bitfield<0, 1> { };
+	};
+
 	struct Sector_count : Register<0xc8, 64> { };
 
 	struct Logical_block  : Register<0xd4, 16>
@@ -118,7 +128,8 @@ struct Io_command
 	                     bool            read,
 	                     Block::sector_t block_number,
 	                     size_t          count,
-	                     unsigned        slot) = 0;
+	                     unsigned        slot,
+	                     bool            fua) = 0;
 
 	virtual void handle_irq(Port &port, Port::Is::access_t status) = 0;
 };
@@ -130,9 +141,10 @@ struct Ncq_command : Io_command
 	             bool            read,
 	             Block::sector_t block_number,
 	             size_t          count,
-	             unsigned        slot) override
+	             unsigned        slot,
+	             bool            fua) override
 	{
-		table.fis.fpdma(read, block_number, count, slot);
+		table.fis.fpdma(read, block_number, count, slot, fua);
 		/* set pending */
 		port.write<Port::Sact>(1U << slot);
 	}
@@ -154,9 +166,10 @@ struct Dma_ext_command : Io_command
 	             bool            read,
 	             Block::sector_t block_number,
 	             size_t          count,
-	             unsigned     /* slot */) override
+	             unsigned     /* slot */,
+	             bool            fua) override
 	{
-		table.fis.dma_ext(read, block_number, count);
+		table.fis.dma_ext(read, block_number, count, fua);
 	}
 
 	void handle_irq(Port &port, Port::Is::access_t status) override
@@ -184,6 +197,15 @@ struct Ata_driver : Port_driver
 	Io_command                               *io_cmd = nullptr;
 	Block::Packet_descriptor                  pending[32];
 
+	/* true while a FUA write is completed by a cache flush */
+	bool fua_flush = false;
+
+	/* buffer for the LBA range entries of TRIM commands */
+	enum { TRIM_BUF_SIZE = 0x1000 };
+
+	Genode::Ram_dataspace_capability trim_ds;
+	Genode::addr_t                   trim_buf = 0;
+
 	Ata_driver(Genode::Allocator &alloc,
 	           Port &port, Signal_context_capability state_change)
 	: Port_driver(port, state_change), alloc(alloc)
@@ -196,6 +218,11 @@ struct Ata_driver : Port_driver
 	{
 		if (io_cmd)
 			destroy(&alloc, io_cmd);
+
+		if (trim_ds.valid()) {
+			rm.detach((void *)trim_buf);
+			platform_hba.free_dma_buffer(trim_ds);
+		}
 	}
 
 	unsigned find_free_cmd_slot()
@@ -207,6 +234,31 @@ struct Ata_driver : Port_driver
 		throw Block::Driver::Request_congestion();
 	}
 
+	/**
+	 * Throw 'Request_congestion' if any command is in progress
+	 *
+	 * Non-queued commands must not be issued while queued commands are
+	 * outstanding.
+	 */
+	void idle_check()
+	{
+		for (unsigned slot = 0; slot < cmd_slots; slot++)
+			if (pending[slot].size())
+				throw Block::Driver::Request_congestion();
+	}
+
+	void flush_cache(unsigned slot)
+	{
+		Command_table table(command_table_addr(slot), 0, 0);
+		table.fis.flush_cache_ext();
+
+		Command_header header(command_header_addr(slot));
+		header.write<Command_header::Bits::W>(0);
+		header.clear_byte_count();
+
+		execute(slot);
+	}
+
 	void ack_packets()
 	{
 		unsigned slots =  Port::read<Ci>() | Port::read<Sact>();
@@ -216,6 +268,20 @@ struct Ata_driver : Port_driver
 				continue;
 
 			Block::Packet_descriptor p = pending[slot];
+
+			/*
+			 * Without native FUA support, there is only a single command
+			 * slot. So the FUA write can be completed by a cache flush
+			 * using the same slot.
+			 */
+			if (p.operation() == Block::Packet_descriptor::WRITE && p.fua()
+			    && !fua_command() && !fua_flush) {
+				fua_flush = true;
+				flush_cache(slot);
+				continue;
+			}
+
+			fua_flush     = false;
 			pending[slot] = Block::Packet_descriptor();
 			ack_packet(p, true);
 		}
@@ -260,7 +326,8 @@ struct Ata_driver : Port_driver
 		Command_table table(command_table_addr(slot), phys, count * block_size());
 
 		/* set ATA command */
-		io_cmd->command(*this, table, read, block_number, count, slot);
+		bool const fua = !read && packet.fua() && fua_command();
+		io_cmd->command(*this, table, read, block_number, count, slot, fua);
 
 		/* set or clear write flag in command header */
 		Command_header header(command_header_addr(slot));
@@ -312,6 +379,11 @@ struct Ata_driver : Port_driver
 		case READY:
 
 			io_cmd->handle_irq(*this, status);
+
+			/* completion of a non-queued command in NCQ mode */
+			if (Port::Is::Dhrs::get(Port::read<Is>()))
+				ack_irq();
+
 			ack_packets();
 
 		default:
@@ -326,6 +398,20 @@ struct Ata_driver : Port_driver
 		return info->read<Identity::Sata_caps::Ncq_support>() && hba.ncq();
 	}
 
+	/**
+	 * Return true if writes can be issued with the FUA bit set
+	 */
+	bool fua_command()
+	{
+		return ncq_support()
+		    || info->read<Identity::Command_set_ext::Write_dma_fua_ext>();
+	}
+
+	bool trim_support()
+	{
+		return info->read<Identity::Data_set_mgmt::Trim>();
+	}
+
 	void check_device()
 	{
 		cmd_slots = min((int)cmd_slots,
@@ -335,6 +421,11 @@ struct Ata_driver : Port_driver
 		if (!ncq_support())
 			cmd_slots = 1;
 
+		if (trim_support()) {
+			trim_ds  = platform_hba.alloc_dma_buffer(TRIM_BUF_SIZE);
+			trim_buf = rm.attach(trim_ds);
+		}
+
 		state = READY;
 		state_change();
 	}
@@ -361,9 +452,15 @@ struct Ata_driver : Port_driver
 		Block::Session::Operations o;
 		o.set_operation(Block::Packet_descriptor::READ);
 		o.set_operation(Block::Packet_descriptor::WRITE);
+
+		if (trim_support())
+			o.set_operation(Block::Packet_descriptor::TRIM);
+
 		return o;
 	}
 
+	bool fua_supported() override { return true; }
+
 	void read_dma(Block::sector_t           block_number,
 	              size_t                    block_count,
 	              addr_t                    phys,
@@ -380,6 +477,61 @@ struct Ata_driver : Port_driver
 		io(false, block_number, block_count, phys, packet);
 	}
 
+	void flush(Block::Packet_descriptor &packet) override
+	{
+		idle_check();
+
+		pending[0] = packet;
+		flush_cache(0);
+	}
+
+	void trim(Block::sector_t           block_number,
+	          size_t                    count,
+	          Block::Packet_descriptor &packet) override
+	{
+		if (!trim_support())
+			throw Io_error();
+
+		if (block_number + count > block_count()) {
+			PERR("error: requested blocks are outside of device");
+			throw Io_error();
+		}
+
+		idle_check();
+
+		/*
+		 * Each LBA range entry covers up to 65535 blocks. Because TRIM is
+		 * merely a hint to the device, ranges not fitting into the buffer
+		 * are left untouched.
+		 */
+		enum { MAX_RANGE = 0xffff, ENTRIES = TRIM_BUF_SIZE / 8 };
+
+		Genode::uint64_t *entry = (Genode::uint64_t *)trim_buf;
+		Genode::memset(entry, 0, TRIM_BUF_SIZE);
+
+		unsigned n = 0;
+		for (; count && n < ENTRIES; n++) {
+			size_t const range = min(count, (size_t)MAX_RANGE);
+			entry[n] = block_number | ((Genode::uint64_t)range << 48);
+			block_number += range;
+			count        -= range;
+		}
+
+		size_t const blocks = align_addr(n * 8, 9) / 512;
+		addr_t const phys   = (addr_t)Dataspace_client(trim_ds).phys_addr();
+
+		pending[0] = packet;
+
+		Command_table table(command_table_addr(0), phys, blocks * 512);
+		table.fis.trim(blocks);
+
+		Command_header header(command_header_addr(0));
+		header.write<Command_header::Bits::W>(1);
+		header.clear_byte_count();
+
+		execute(0);
+	}
+
 	Genode::size_t block_size() override
 	{
 		Genode::size_t size = 512;
@@ -156,8 +156,18 @@ struct Main
 
 	int fb_width  { config_arg("width",  1024) };
 	int fb_height { config_arg("height", 768) };
+	int fb_depth  { config_arg("depth",  16) };
 
-	Framebuffer::Mode fb_mode { fb_width, fb_height, Framebuffer::Mode::RGB565 };
+	/*
+	 * A depth of 32 bits selects the XRGB8888 format, which matches the
+	 * native layout of 32-bit X11 visuals. Hence, the pixels can be copied
+	 * to the SDL surface without conversion.
+	 */
+	Framebuffer::Mode::Format fb_format { fb_depth == 32
+	                                      ? Framebuffer::Mode::XRGB8888
+	                                      : Framebuffer::Mode::RGB565 };
+
+	Framebuffer::Mode fb_mode { fb_width, fb_height, fb_format };
 
 	Attached_ram_dataspace fb_ds { &env.ram(),
 	                               fb_mode.width()*fb_mode.height()*fb_mode.bytes_per_pixel() };
@@ -199,6 +209,11 @@ struct Main
 			PERR("SDL_SetVideoMode failed (%s)", SDL_GetError());
 			throw Sdl_setvideomode_failed();
 		}
+		if (screen->format->BitsPerPixel != fb_mode.bytes_per_pixel()*8
+		 || screen->pitch != fb_mode.bytes_per_pixel()*fb_mode.width()) {
+			PERR("SDL surface does not match requested mode");
+			throw Sdl_setvideomode_failed();
+		}
 		fb_session.screen(screen);
 
 		SDL_ShowCursor(0);
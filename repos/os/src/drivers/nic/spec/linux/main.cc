@@ -25,6 +25,7 @@
 
 /* Genode */
 #include <base/thread.h>
+#include <base/semaphore.h>
 #include <nic/root.h>
 #include <nic/xml_node.h>
 #include <os/config.h>
@@ -44,14 +45,39 @@ class Linux_session_component : public Nic::Session_component
 {
 	private:
 
+		/*
+		 * The RX signal thread announces the arrival of packets at the TAP
+		 * device once per batch. After signalling, it waits until the
+		 * entrypoint drained the device before observing it again.
+		 * Otherwise, the thread would submit signals in a tight loop for as
+		 * long as packets are pending.
+		 */
 		struct Rx_signal_thread : Genode::Thread_deprecated<0x1000>
 		{
 			int                               fd;
 			Genode::Signal_context_capability sigh;
 
+			Genode::Lock      lock;
+			bool              waiting = false;  /* waits for drained device */
+			Genode::Semaphore drained;
+
 			Rx_signal_thread(int fd, Genode::Signal_context_capability sigh)
 			: Genode::Thread_deprecated<0x1000>("rx_signal"), fd(fd), sigh(sigh) { }
 
+			/**
+			 * Called by the entrypoint when a read would block
+			 */
+			void device_drained()
+			{
+				Genode::Lock::Guard guard(lock);
+
+				if (!waiting)
+					return;
+
+				waiting = false;
+				drained.up();
+			}
+
 			void entry()
 			{
 				while (true) {
@@ -63,8 +89,15 @@ class Linux_session_component : public Nic::Session_component
 					FD_SET(fd, &rfds);
 					do { ret = select(fd + 1, &rfds, 0, 0, 0); } while (ret < 0);
 
-					/* signal incoming packet */
+					{
+						Genode::Lock::Guard guard(lock);
+						waiting = true;
+					}
+
+					/* signal incoming packets */
 					Genode::Signal_transmitter(sigh).submit();
+
+					drained.down();
 				}
 			}
 		};
@@ -165,6 +198,10 @@ class Linux_session_component : public Nic::Session_component
 			int size = read(_tap_fd, _rx.source()->packet_content(p), max_size);
 			if (size <= 0) {
 				_rx.source()->release_packet(p);
+
+				/* let the RX signal thread observe the device again */
+				_rx_thread.device_drained();
+
 				return false;
 			}
 
@@ -183,6 +220,8 @@ class Linux_session_component : public Nic::Session_component
 				_rx.source()->release_packet(_rx.source()->get_acked_packet());
 
 			while (_send()) ;
+
+			/* drain all packets pending at the device */
 			while (_receive()) ;
 		}
 
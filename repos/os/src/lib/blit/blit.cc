@@ -1,5 +1,5 @@
 /*
- * \brief  Generic blitting function
+ * \brief  Generic blitting function and kernel selection
  * \author Norman Feske
  * \date   2007-10-10
  */
@@ -13,11 +13,12 @@
 
 #include <blit/blit.h>
 #include <blit_helper.h>
+#include <blit_kernels.h>
 
 
-extern "C" void blit(void const *s, unsigned src_w,
-                     void *d, unsigned dst_w,
-                     int w, int h)
+static void generic_copy(void const *s, unsigned src_w,
+                         void *d, unsigned dst_w,
+                         int w, int h)
 {
 	char const *src = (char const *)s;
 	char       *dst = (char       *)d;
@@ -54,3 +55,79 @@ extern "C" void blit(void const *s, unsigned src_w,
 	/* handle trailing row */
 	if (w >> 1) copy_16bit_column(src, src_w, dst, dst_w, h);
 }
+
+
+/*
+ * The generic kernels process one pixel at a time using the functions of
+ * the pixel types.
+ */
+
+static void generic_fill_16bit(void *dst, unsigned dst_w,
+                               Blit::uint16_t value, int w, int h)
+{
+	Blit::Pixel_rgb565 p; p.pixel = value;
+	Blit::Generic::fill((Blit::Pixel_rgb565 *)dst, dst_w, p, w, h);
+}
+
+
+static void generic_fill_32bit(void *dst, unsigned dst_w,
+                               Blit::uint32_t value, int w, int h)
+{
+	Blit::Pixel_rgb888 p; p.pixel = value;
+	Blit::Generic::fill((Blit::Pixel_rgb888 *)dst, dst_w, p, w, h);
+}
+
+
+static void generic_mix_rgb565(void *dst, unsigned dst_w,
+                               Blit::uint16_t color, int alpha, int w, int h)
+{
+	Blit::Pixel_rgb565 c; c.pixel = color;
+	Blit::Generic::mix((Blit::Pixel_rgb565 *)dst, dst_w, c, alpha, w, h);
+}
+
+
+static void generic_mix_xrgb8888(void *dst, unsigned dst_w,
+                                 Blit::uint32_t color, int alpha, int w, int h)
+{
+	Blit::Pixel_rgb888 c; c.pixel = color;
+	Blit::Generic::mix((Blit::Pixel_rgb888 *)dst, dst_w, c, alpha, w, h);
+}
+
+
+static void generic_blend_rgb565(void const *src, unsigned src_w,
+                                 unsigned char const *alpha,
+                                 void *dst, unsigned dst_w, int w, int h)
+{
+	Blit::Generic::blend((Blit::Pixel_rgb565 const *)src, src_w, alpha,
+	                     (Blit::Pixel_rgb565 *)dst, dst_w, w, h);
+}
+
+
+static void generic_blend_xrgb8888(void const *src, unsigned src_w,
+                                   unsigned char const *alpha,
+                                   void *dst, unsigned dst_w, int w, int h)
+{
+	Blit::Generic::blend((Blit::Pixel_rgb888 const *)src, src_w, alpha,
+	                     (Blit::Pixel_rgb888 *)dst, dst_w, w, h);
+}
+
+
+Blit::Kernels const Blit::generic_kernels = {
+	"generic", generic_copy, generic_fill_16bit, generic_fill_32bit,
+	generic_mix_rgb565, generic_mix_xrgb8888,
+	generic_blend_rgb565, generic_blend_xrgb8888 };
+
+
+Blit::Kernels const &Blit::kernels()
+{
+	static Kernels const &selected = *kernels(0);
+	return selected;
+}
+
+
+extern "C" void blit(void const *src, unsigned src_w,
+                     void *dst, unsigned dst_w,
+                     int w, int h)
+{
+	Blit::kernels().copy(src, src_w, dst, dst_w, w, h);
+}
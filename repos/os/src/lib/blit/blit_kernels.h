@@ -0,0 +1,358 @@
+/*
+ * \brief  Building blocks for the pixel kernels of the blit library
+ * \author Genode Labs
+ * \date   2016-06-27
+ *
+ * The SIMD kernels are expressed via the vector extension of GCC. They are
+ * instantiated for different vector widths and compiled for different
+ * instruction-set extensions by the CPU-specific 'kernels.cc' files.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LIB__BLIT__BLIT_KERNELS_H_
+#define _LIB__BLIT__BLIT_KERNELS_H_
+
+#include <blit/painter.h>
+
+#define BLIT_INLINE inline __attribute__((always_inline))
+
+namespace Blit {
+
+	using Genode::uint8_t;
+	using Genode::uint64_t;
+
+	/**
+	 * Kernels implemented without SIMD instructions
+	 */
+	extern Kernels const generic_kernels;
+
+	template <unsigned> struct Vector;
+	template <typename> struct Simd;
+}
+
+
+template <>
+struct Blit::Vector<16>
+{
+	typedef uint8_t  u8  __attribute__((vector_size(16)));
+	typedef uint16_t u16 __attribute__((vector_size(16)));
+	typedef uint32_t u32 __attribute__((vector_size(16)));
+	typedef uint64_t u64 __attribute__((vector_size(16)));
+};
+
+
+template <>
+struct Blit::Vector<32>
+{
+	typedef uint8_t  u8  __attribute__((vector_size(32)));
+	typedef uint16_t u16 __attribute__((vector_size(32)));
+	typedef uint32_t u32 __attribute__((vector_size(32)));
+	typedef uint64_t u64 __attribute__((vector_size(32)));
+};
+
+
+/**
+ * Pixel kernels for the vector type 'V'
+ *
+ * All functions are forcibly inlined into the entry points of the
+ * CPU-specific kernels so that they get compiled for the instruction set
+ * of the respective entry point.
+ */
+template <typename V>
+struct Blit::Simd
+{
+	typedef typename V::u8  u8;
+	typedef typename V::u16 u16;
+	typedef typename V::u32 u32;
+	typedef typename V::u64 u64;
+
+	enum { BYTES = sizeof(u16), N16 = BYTES/2, N32 = BYTES/4 };
+
+	template <typename VT>
+	static BLIT_INLINE VT load(void const *src)
+	{
+		VT v;
+		__builtin_memcpy(&v, src, sizeof(v));
+		return v;
+	}
+
+	template <typename VT>
+	static BLIT_INLINE void store(void *dst, VT v) {
+		__builtin_memcpy(dst, &v, sizeof(v)); }
+
+	template <typename VT, typename T>
+	static BLIT_INLINE VT splat(T value)
+	{
+		T values[sizeof(VT)/sizeof(T)];
+		for (unsigned i = 0; i < sizeof(VT)/sizeof(T); i++)
+			values[i] = value;
+		return load<VT>(values);
+	}
+
+	/**
+	 * Load 'N' bytes (at most 16) into the lower part of a vector
+	 *
+	 * Going through general-purpose registers avoids a partial store to
+	 * the stack followed by a vector load, which would stall the pipeline.
+	 */
+	template <unsigned N>
+	static BLIT_INLINE u8 load_low(unsigned char const *src)
+	{
+		uint64_t values[2] = { 0, 0 };
+		__builtin_memcpy(values, src, N);
+
+		u64 const v = { values[0], values[1] };
+		return (u8)v;
+	}
+
+	/**
+	 * Interleave the bytes of the lower halves of 'a' and 'b'
+	 *
+	 * The selector is constant, which allows the compiler to use the
+	 * unpack instruction of the target.
+	 */
+	static BLIT_INLINE u8 interleave_low(u8 a, u8 b)
+	{
+		uint8_t indices[BYTES];
+		for (unsigned i = 0; i < BYTES; i++)
+			indices[i] = i/2 + ((i & 1) ? BYTES : 0);
+
+		return __builtin_shuffle(a, b, load<u8>(indices));
+	}
+
+	/**
+	 * Vector of per-pixel alpha values, one 16-bit lane per RGB565 pixel
+	 */
+	static BLIT_INLINE u16 alpha_rgb565(unsigned char const *alpha)
+	{
+		u8 const zero = { };
+		return (u16)interleave_low(load_low<N16>(alpha), zero);
+	}
+
+	/**
+	 * Vector of per-pixel alpha values, two 16-bit lanes per XRGB8888 pixel
+	 */
+	static BLIT_INLINE u16 alpha_xrgb8888(unsigned char const *alpha)
+	{
+		u8 const zero = { };
+		u8 const a    = load_low<N32>(alpha);
+		return (u16)interleave_low(interleave_low(a, a), zero);
+	}
+
+	/**
+	 * Return true if all 'N' alpha values are zero
+	 */
+	template <unsigned N>
+	static BLIT_INLINE bool transparent(unsigned char const *alpha)
+	{
+		uint32_t values[N/4];
+		__builtin_memcpy(values, alpha, N);
+
+		uint32_t acc = 0;
+		for (unsigned i = 0; i < N/4; i++)
+			acc |= values[i];
+		return acc == 0;
+	}
+
+	/**
+	 * Counterpart of 'Pixel_rgb565::blend'
+	 *
+	 * The channels are processed separately, which keeps all intermediate
+	 * values within 16 bits while producing the same result as the scalar
+	 * version.
+	 */
+	static BLIT_INLINE u16 rgb565_blend(u16 p, u16 alpha)
+	{
+		u16 const alpha_3 = alpha >> 3;
+
+		return (((alpha_3 * (p >> 11))       >> 5) << 11)
+		     | (((alpha   * ((p >> 6) & 31)) >> 8) << 6)
+		     |  ((alpha_3 * (p & 31))        >> 5);
+	}
+
+	/**
+	 * Counterpart of 'Pixel_rgb888::blend'
+	 *
+	 * Red and blue are multiplied in the 16-bit halves of each pixel,
+	 * green is moved to the lower half beforehand.
+	 */
+	static BLIT_INLINE u32 xrgb8888_blend(u32 p, u16 alpha)
+	{
+		u16 const rb = (u16)(p & 0xff00ff);
+		u16 const g  = (u16)((p >> 8) & 0xff);
+
+		return  (u32)((rb * alpha) >> 8)
+		     | ((u32)((g  * alpha) >> 8) << 8);
+	}
+
+	static BLIT_INLINE void copy(void const *s, unsigned src_w,
+	                             void *d, unsigned dst_w, int w, int h)
+	{
+		char const *src = (char const *)s;
+		char       *dst = (char       *)d;
+
+		w &= ~1;
+
+		for (; h-- > 0; src += src_w, dst += dst_w) {
+			int i = 0;
+			for (; i + BYTES <= w; i += BYTES)
+				store(dst + i, load<u16>(src + i));
+			for (; i < w; i += 2)
+				__builtin_memcpy(dst + i, src + i, 2);
+		}
+	}
+
+	template <typename T>
+	static BLIT_INLINE void fill(void *d, unsigned dst_w, T value, int w, int h)
+	{
+		enum { N = BYTES/sizeof(T) };
+
+		T        *dst = (T *)d;
+		u16 const v   = splat<u16>(value);
+
+		for (; h-- > 0; dst += dst_w) {
+			int i = 0;
+			for (; i + N <= w; i += N)
+				store(dst + i, v);
+			for (; i < w; i++)
+				dst[i] = value;
+		}
+	}
+
+	static BLIT_INLINE void mix_rgb565(void *d, unsigned dst_w, uint16_t color,
+	                                   int alpha, int w, int h)
+	{
+		Pixel_rgb565 c; c.pixel = color;
+
+		Pixel_rgb565 *dst  = (Pixel_rgb565 *)d;
+		u16 const     src  = splat<u16>(Pixel_rgb565::blend(c, alpha).pixel);
+		u16 const     rest = splat<u16>((uint16_t)(264 - alpha));
+
+		for (; h-- > 0; dst += dst_w) {
+			int i = 0;
+			for (; i + N16 <= w; i += N16)
+				store(dst + i, rgb565_blend(load<u16>(dst + i), rest) + src);
+
+			Generic::mix(dst + i, dst_w, c, alpha, w - i, 1);
+		}
+	}
+
+	static BLIT_INLINE void mix_xrgb8888(void *d, unsigned dst_w, uint32_t color,
+	                                     int alpha, int w, int h)
+	{
+		Pixel_rgb888 c; c.pixel = color;
+
+		Pixel_rgb888 *dst  = (Pixel_rgb888 *)d;
+		u32 const     src  = splat<u32>(Pixel_rgb888::blend(c, alpha).pixel);
+		u16 const     rest = splat<u16>((uint16_t)(255 - alpha));
+
+		for (; h-- > 0; dst += dst_w) {
+			int i = 0;
+			for (; i + N32 <= w; i += N32)
+				store(dst + i, xrgb8888_blend(load<u32>(dst + i), rest) + src);
+
+			Generic::mix(dst + i, dst_w, c, alpha, w - i, 1);
+		}
+	}
+
+	static BLIT_INLINE void blend_rgb565(void const *s, unsigned src_w,
+	                                     unsigned char const *alpha,
+	                                     void *d, unsigned dst_w, int w, int h)
+	{
+		Pixel_rgb565 const *src = (Pixel_rgb565 const *)s;
+		Pixel_rgb565       *dst = (Pixel_rgb565       *)d;
+
+		u16 const max  = splat<u16>((uint16_t)264);
+		u16 const zero = splat<u16>((uint16_t)0);
+
+		for (; h-- > 0; src += src_w, alpha += src_w, dst += dst_w) {
+			int i = 0;
+			for (; i + N16 <= w; i += N16) {
+
+				if (transparent<N16>(alpha + i))
+					continue;
+
+				u16 const a     = alpha_rgb565(alpha + i);
+				u16 const p     = load<u16>(dst + i);
+				u16 const mixed = rgb565_blend(p, max - a)
+				                + rgb565_blend(load<u16>(src + i), a);
+				u16 const keep  = (u16)(a == zero);
+
+				store(dst + i, (mixed & ~keep) | (p & keep));
+			}
+
+			Generic::blend(src + i, src_w, alpha + i, dst + i, dst_w, w - i, 1);
+		}
+	}
+
+	static BLIT_INLINE void blend_xrgb8888(void const *s, unsigned src_w,
+	                                       unsigned char const *alpha,
+	                                       void *d, unsigned dst_w, int w, int h)
+	{
+		Pixel_rgb888 const *src = (Pixel_rgb888 const *)s;
+		Pixel_rgb888       *dst = (Pixel_rgb888       *)d;
+
+		u16 const max  = splat<u16>((uint16_t)255);
+		u16 const zero = splat<u16>((uint16_t)0);
+
+		for (; h-- > 0; src += src_w, alpha += src_w, dst += dst_w) {
+			int i = 0;
+			for (; i + N32 <= w; i += N32) {
+
+				if (transparent<N32>(alpha + i))
+					continue;
+
+				u16 const a     = alpha_xrgb8888(alpha + i);
+				u32 const p     = load<u32>(dst + i);
+				u32 const mixed = xrgb8888_blend(p, max - a)
+				                + xrgb8888_blend(load<u32>(src + i), a);
+				u32 const keep  = (u32)(a == zero);
+
+				store(dst + i, (mixed & ~keep) | (p & keep));
+			}
+
+			Generic::blend(src + i, src_w, alpha + i, dst + i, dst_w, w - i, 1);
+		}
+	}
+};
+
+
+
+/**
+ * Define kernel entry points named 'NAME'_* for the SIMD implementation
+ * 'SIMD' and the function attributes 'ATTR', and the kernel table
+ * 'NAME'_kernels using 'COPY' for copying pixels
+ */
+#define BLIT_SIMD_KERNELS(NAME, SIMD, ATTR, COPY) \
+	ATTR static void NAME##_fill_16bit(void *dst, unsigned dst_w, \
+	                                   Blit::uint16_t value, int w, int h) { \
+		SIMD::fill(dst, dst_w, value, w, h); } \
+	ATTR static void NAME##_fill_32bit(void *dst, unsigned dst_w, \
+	                                   Blit::uint32_t value, int w, int h) { \
+		SIMD::fill(dst, dst_w, value, w, h); } \
+	ATTR static void NAME##_mix_rgb565(void *dst, unsigned dst_w, \
+	                                   Blit::uint16_t color, int alpha, int w, int h) { \
+		SIMD::mix_rgb565(dst, dst_w, color, alpha, w, h); } \
+	ATTR static void NAME##_mix_xrgb8888(void *dst, unsigned dst_w, \
+	                                     Blit::uint32_t color, int alpha, int w, int h) { \
+		SIMD::mix_xrgb8888(dst, dst_w, color, alpha, w, h); } \
+	ATTR static void NAME##_blend_rgb565(void const *src, unsigned src_w, \
+	                                     unsigned char const *alpha, \
+	                                     void *dst, unsigned dst_w, int w, int h) { \
+		SIMD::blend_rgb565(src, src_w, alpha, dst, dst_w, w, h); } \
+	ATTR static void NAME##_blend_xrgb8888(void const *src, unsigned src_w, \
+	                                       unsigned char const *alpha, \
+	                                       void *dst, unsigned dst_w, int w, int h) { \
+		SIMD::blend_xrgb8888(src, src_w, alpha, dst, dst_w, w, h); } \
+	static Blit::Kernels const NAME##_kernels = { \
+		#NAME, COPY, NAME##_fill_16bit, NAME##_fill_32bit, \
+		NAME##_mix_rgb565, NAME##_mix_xrgb8888, \
+		NAME##_blend_rgb565, NAME##_blend_xrgb8888 };
+
+#endif /* _LIB__BLIT__BLIT_KERNELS_H_ */
@@ -0,0 +1,20 @@
+/*
+ * \brief  Kernel selection for CPUs without SIMD support
+ * \author Genode Labs
+ * \date   2016-06-27
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <blit_kernels.h>
+
+
+Blit::Kernels const *Blit::kernels(unsigned i)
+{
+	return i == 0 ? &generic_kernels : 0;
+}
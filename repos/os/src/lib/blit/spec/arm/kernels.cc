@@ -0,0 +1,50 @@
+/*
+ * \brief  NEON pixel kernels for ARM
+ * \author Genode Labs
+ * \date   2016-06-27
+ *
+ * The presence of NEON cannot be detected at user level on ARM. Hence, the
+ * NEON kernels are only built if the blit library is compiled with NEON
+ * support, which is the case for the 'neon' spec value.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <blit_kernels.h>
+
+#ifdef __ARM_NEON__
+
+typedef Blit::Simd<Blit::Vector<16> > Neon;
+
+
+static void neon_copy(void const *src, unsigned src_w,
+                      void *dst, unsigned dst_w, int w, int h)
+{
+	Neon::copy(src, src_w, dst, dst_w, w, h);
+}
+
+
+BLIT_SIMD_KERNELS(neon, Neon, , neon_copy)
+
+#endif /* __ARM_NEON__ */
+
+
+Blit::Kernels const *Blit::kernels(unsigned i)
+{
+	Kernels const * const variants[] = {
+#ifdef __ARM_NEON__
+		&neon_kernels,
+#endif
+		&generic_kernels };
+
+	for (Kernels const *k : variants)
+		if (i-- == 0)
+			return k;
+
+	return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * \brief  SSE2 and AVX2 pixel kernels for x86
+ * \author Genode Labs
+ * \date   2016-06-27
+ *
+ * The kernels are compiled for the respective instruction-set extension via
+ * function attributes. Which of them are used is decided at runtime based
+ * on the features reported by the 'cpuid' instruction.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* compiler includes */
+#include <cpuid.h>
+
+/* local includes */
+#include <blit_kernels.h>
+
+
+namespace {
+
+	typedef long long v2di __attribute__((vector_size(16)));
+	typedef long long v4di __attribute__((vector_size(32)));
+
+	struct Cpu_features
+	{
+		bool sse2 = false;
+		bool avx2 = false;
+
+		static unsigned long long _xgetbv(unsigned index)
+		{
+			unsigned lo, hi;
+			asm volatile (".byte 0x0f, 0x01, 0xd0" /* xgetbv */
+			              : "=a" (lo), "=d" (hi) : "c" (index));
+			return ((unsigned long long)hi << 32) | lo;
+		}
+
+		Cpu_features()
+		{
+			unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+			if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+				return;
+
+			sse2 = edx & bit_SSE2;
+
+			/* the kernel must save the AVX register state on context switches */
+			bool const avx_usable = (ecx & bit_OSXSAVE) && (ecx & bit_AVX)
+			                     && (_xgetbv(0) & 6) == 6;
+
+			if (!avx_usable || __get_cpuid_max(0, 0) < 7)
+				return;
+
+			__cpuid_count(7, 0, eax, ebx, ecx, edx);
+			avx2 = ebx & bit_AVX2;
+		}
+	};
+
+	/*
+	 * Non-temporal stores bypass the cache, which avoids polluting the cache
+	 * with framebuffer content. They require an aligned destination.
+	 */
+
+	struct Sse2_nt
+	{
+		enum { BYTES = 16 };
+
+		__attribute__((target("sse2")))
+		static void copy(char const *src, char *dst, int n)
+		{
+			for (; n > 0; n -= BYTES, src += BYTES, dst += BYTES) {
+				v2di v;
+				__builtin_memcpy(&v, src, BYTES);
+				__builtin_ia32_movntdq((v2di *)dst, v);
+			}
+		}
+	};
+
+	struct Avx_nt
+	{
+		enum { BYTES = 32 };
+
+		__attribute__((target("avx")))
+		static void copy(char const *src, char *dst, int n)
+		{
+			for (; n > 0; n -= BYTES, src += BYTES, dst += BYTES) {
+				v4di v;
+				__builtin_memcpy(&v, src, BYTES);
+				__builtin_ia32_movntdq256((v4di *)dst, v);
+			}
+		}
+	};
+
+	template <typename NT>
+	void copy_nt(void const *s, unsigned src_w,
+	             void *d, unsigned dst_w, int w, int h)
+	{
+		enum { BYTES = NT::BYTES };
+
+		char const *src = (char const *)s;
+		char       *dst = (char       *)d;
+
+		w &= ~1;
+
+		for (; h-- > 0; src += src_w, dst += dst_w) {
+			int i = 0;
+
+			/* copy leading 16-bit units until the destination is aligned */
+			for (; i + 2 <= w && ((Genode::addr_t)(dst + i) & (BYTES - 1)); i += 2)
+				__builtin_memcpy(dst + i, src + i, 2);
+
+			int const n = (w - i) & ~(BYTES - 1);
+			NT::copy(src + i, dst + i, n);
+
+			for (i += n; i < w; i += 2)
+				__builtin_memcpy(dst + i, src + i, 2);
+		}
+
+		asm volatile ("sfence" : : : "memory");
+	}
+}
+
+
+typedef Blit::Simd<Blit::Vector<16> > Sse2;
+typedef Blit::Simd<Blit::Vector<32> > Avx2;
+
+
+static void sse2_copy(void const *src, unsigned src_w,
+                      void *dst, unsigned dst_w, int w, int h)
+{
+	copy_nt<Sse2_nt>(src, src_w, dst, dst_w, w, h);
+}
+
+
+static void avx2_copy(void const *src, unsigned src_w,
+                      void *dst, unsigned dst_w, int w, int h)
+{
+	copy_nt<Avx_nt>(src, src_w, dst, dst_w, w, h);
+}
+
+
+BLIT_SIMD_KERNELS(sse2, Sse2, __attribute__((target("sse2"))), sse2_copy)
+BLIT_SIMD_KERNELS(avx2, Avx2, __attribute__((target("avx2"))), avx2_copy)
+
+
+Blit::Kernels const *Blit::kernels(unsigned i)
+{
+	static Cpu_features const cpu;
+
+	Kernels const * const variants[] = {
+		cpu.avx2 ? &avx2_kernels : 0,
+		cpu.sse2 ? &sse2_kernels : 0,
+		&generic_kernels };
+
+	for (Kernels const *k : variants)
+		if (k && i-- == 0)
+			return k;
+
+	return 0;
+}
@@ -14,13 +14,42 @@
 #include <os/timed_semaphore.h>
 
 
+void Genode::Timeout_thread::_program()
+{
+	Lock::Guard lock_guard(_program_lock);
+
+	Alarm::Time deadline;
+	if (!next_deadline(&deadline))
+		return;
+
+	/* the armed timeout triggers early enough */
+	if (_programmed && deadline >= _programmed_deadline)
+		return;
+
+	Alarm::Time const now = _timer.elapsed_ms();
+	Alarm::Time const ms  = deadline > now ? deadline - now : 1;
+
+	_timer.trigger_once(ms*1000);
+	_programmed          = true;
+	_programmed_deadline = deadline;
+}
+
+
 void Genode::Timeout_thread::entry()
 {
 	while (true) {
 		Signal s = _receiver.wait_for_signal();
 
+		{
+			Lock::Guard lock_guard(_program_lock);
+			_programmed = false;
+		}
+
 		/* handle timouts of this point in time */
 		Genode::Alarm_scheduler::handle(_timer.elapsed_ms());
+
+		/* arm timeout for the next deadline, if any */
+		_program();
 	}
 }
 
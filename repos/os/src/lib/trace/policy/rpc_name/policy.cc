@@ -51,3 +51,27 @@ size_t signal_receive(char *dst, Signal_context const &, unsigned)
 {
 	return 0;
 }
+
+size_t checkpoint(char *dst, char const *name, unsigned long data, void const *)
+{
+	size_t len = strlen(name);
+
+	memcpy(dst, (void*)name, len);
+
+	/* append data value in decimal notation */
+	char digits[24];
+	size_t num_digits = 0;
+	do {
+		digits[num_digits++] = '0' + data % 10;
+		data /= 10;
+	} while (data);
+
+	if (len + 1 + num_digits > MAX_EVENT_SIZE)
+		return len;
+
+	dst[len++] = ' ';
+	while (num_digits)
+		dst[len++] = digits[--num_digits];
+
+	return len;
+}
@@ -49,7 +49,8 @@ class Driver : public Block::Driver
 			 */
 			bool match(const Block::Packet_descriptor& reply) const
 			{
-				return reply.operation()    == srv.operation()  &&
+				return reply.offset()       == srv.offset()     &&
+				       reply.operation()    == srv.operation()  &&
 				       reply.block_number() == srv.block_number() &&
 				       reply.block_count()  == srv.block_count();
 			}
@@ -158,6 +159,12 @@ class Driver : public Block::Driver
 		 */
 		inline void _handle_reply(Block::Packet_descriptor &srv, Request *r)
 		{
+			/* sync and trim requests are forwarded to the device as is */
+			if (srv.operation() != Block::Packet_descriptor::READ) {
+				ack_packet(r->cli, srv.succeeded());
+				return;
+			}
+
 			try {
 			if (r->cli.operation() == Block::Packet_descriptor::READ)
 				read(r->cli.block_number(), r->cli.block_count(),
@@ -260,6 +267,34 @@ class Driver : public Block::Driver
 			}
 		}
 
+		/*
+		 * Forward a request without payload to the backend device
+		 *
+		 * \param op      operation of the request
+		 * \param nr      block number offset
+		 * \param cnt     number of blocks
+		 * \param packet  original packet request received from the client,
+		 *                acknowledged when the backend device completed
+		 *                the request
+		 */
+		void _forward(Block::Packet_descriptor::Opcode op,
+		              Block::sector_t                  nr,
+		              Genode::size_t                   cnt,
+		              Block::Packet_descriptor        &packet)
+		{
+			if (!_blk.tx()->ready_to_submit())
+				throw Request_congestion();
+
+			try {
+				Block::Packet_descriptor p(_blk.dma_alloc_packet(_blk_sz),
+				                           op, nr, cnt);
+				_r_list.insert(new (&_r_slab) Request(p, packet, 0));
+				_blk.tx()->submit_packet(p);
+			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
+				throw Request_congestion();
+			}
+		}
+
 		/*
 		 * Synchronize dirty chunks with backend device
 		 */
@@ -426,8 +461,45 @@ class Driver : public Block::Driver
 
 			_cache.write(buffer, block_count * _blk_sz,
 			             block_number * _blk_sz);
+
+			/* write through to the device */
+			if (packet.fua()) {
+				flush(packet);
+				return;
+			}
+
 			ack_packet(packet);
 		}
 
+		void trim(Block::sector_t           block_number,
+		          Genode::size_t            block_count,
+		          Block::Packet_descriptor &packet)
+		{
+			if (!_ops.supported(Block::Packet_descriptor::TRIM))
+				throw Io_error();
+
+			/*
+			 * Cached blocks of the range are kept, the content of discarded
+			 * blocks is undefined anyway.
+			 */
+			_forward(Block::Packet_descriptor::TRIM, block_number,
+			         block_count, packet);
+		}
+
+		void flush(Block::Packet_descriptor &packet)
+		{
+			_sync();
+
+			if (_ops.supported(Block::Packet_descriptor::SYNC)) {
+				_forward(Block::Packet_descriptor::SYNC, 0, 0, packet);
+				return;
+			}
+
+			_blk.sync();
+			ack_packet(packet);
+		}
+
+		bool fua_supported() { return true; }
+
 		void sync() { _sync(); }
 };
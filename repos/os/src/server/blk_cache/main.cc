@@ -24,7 +24,7 @@ template <typename POLICY> Driver<POLICY>* Driver<POLICY>::_instance = 0;
  * Synchronize a chunk with the backend device
  */
 template <typename POLICY>
-void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
+void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *src)
 {
 	Cache::offset_t off =
 		static_cast<const Driver<POLICY>::Chunk_level_4*>(e)->base_offset();
@@ -37,6 +37,8 @@ void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
 		      Block::Packet_descriptor::WRITE,
 		      off / Driver::instance()->blk_sz(),
 		      Driver::CACHE_BLK_SIZE / Driver::instance()->blk_sz());
+		Genode::memcpy(Driver::instance()->blk()->tx()->packet_content(p),
+		               src, Driver::CACHE_BLK_SIZE);
 		Driver::instance()->blk()->tx()->submit_packet(p);
 	} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
 		throw Write_failed(off);
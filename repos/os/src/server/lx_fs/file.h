@@ -117,6 +117,30 @@ class File_system::File : public Node
 			return ret == -1 ? 0 : ret;
 		}
 
+		/**
+		 * Read into several buffers with a single system call
+		 *
+		 * \return  total number of bytes read
+		 */
+		size_t read(struct iovec const *iov, int iov_cnt, seek_off_t seek_offset)
+		{
+			ssize_t ret = preadv(_fd, iov, iov_cnt, seek_offset);
+
+			return ret == -1 ? 0 : ret;
+		}
+
+		/**
+		 * Write from several buffers with a single system call
+		 *
+		 * \return  total number of bytes written
+		 */
+		size_t write(struct iovec const *iov, int iov_cnt, seek_off_t seek_offset)
+		{
+			ssize_t ret = pwritev(_fd, iov, iov_cnt, seek_offset);
+
+			return ret == -1 ? 0 : ret;
+		}
+
 		file_size_t length() const
 		{
 			struct stat s;
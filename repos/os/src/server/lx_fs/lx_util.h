@@ -17,6 +17,7 @@
 #include <fcntl.h>
 #include <dirent.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 
 
 namespace File_system {
@@ -20,6 +20,8 @@
 #include <os/server.h>
 #include <os/session_policy.h>
 #include <util/xml_node.h>
+#include <util/volatile_object.h>
+#include <base/thread.h>
 
 /* local includes */
 #include <directory.h>
@@ -27,11 +29,35 @@
 
 namespace File_system {
 	struct Main;
+	struct Io_worker;
 	struct Session_component;
 	struct Root;
 }
 
 
+/**
+ * Thread that processes the packet streams of the sessions assigned to it
+ *
+ * Each session is served by exactly one worker, which preserves the order
+ * of the session's packets. Different sessions assigned to different
+ * workers are processed in parallel.
+ */
+struct File_system::Io_worker : Thread_deprecated<4*4096*sizeof(long)>
+{
+	Signal_receiver sig_rec;
+
+	Io_worker(char const *name) : Thread_deprecated(name) { start(); }
+
+	void entry() override
+	{
+		for (;;) {
+			Signal s = sig_rec.wait_for_signal();
+			static_cast<Signal_dispatcher_base *>(s.context())->dispatch(s.num());
+		}
+	}
+};
+
+
 class File_system::Session_component : public Session_rpc_object
 {
 	private:
@@ -42,7 +68,12 @@ class File_system::Session_component : public Session_rpc_object
 		Node_handle_registry  _handle_registry;
 		bool                  _writable;
 
-		Signal_rpc_member<Session_component> _process_packet_dispatcher;
+		/*
+		 * Packets are processed either by the entrypoint or by an I/O
+		 * worker thread
+		 */
+		Lazy_volatile_object<Signal_rpc_member<Session_component> > _ep_dispatcher;
+		Lazy_volatile_object<Signal_dispatcher<Session_component> > _worker_dispatcher;
 
 
 		/******************************
@@ -83,31 +114,98 @@ class File_system::Session_component : public Session_rpc_object
 			packet.succeeded(res_length > 0);
 		}
 
-		void _process_packet()
+		/*
+		 * Maximum number of packets combined into one vectored I/O operation
+		 */
+		enum { MAX_BATCH = 16 };
+
+		/**
+		 * Return true if 'next' continues the I/O operation of 'prev'
+		 */
+		static bool _contiguous(Packet_descriptor const &prev,
+		                        Packet_descriptor const &next)
+		{
+			return next.handle()       == prev.handle()
+			    && next.operation()    == prev.operation()
+			    && prev.position()     != SEEK_TAIL
+			    && next.position()     == prev.position() + prev.length();
+		}
+
+		/**
+		 * Perform batch of contiguous packet operations on a file
+		 *
+		 * The batch is handled by a single 'preadv' or 'pwritev' call. The
+		 * transferred bytes are attributed to the packets in order.
+		 */
+		void _process_batch_op(Packet_descriptor *batch, unsigned count, File &file)
 		{
-			Packet_descriptor packet = tx_sink()->get_packet();
+			struct iovec iov[MAX_BATCH];
+
+			for (unsigned i = 0; i < count; i++) {
+				Packet_descriptor &packet = batch[i];
+				iov[i].iov_base = tx_sink()->packet_content(packet);
+				iov[i].iov_len  = packet.length();
+
+				if (!iov[i].iov_base || (packet.length() > packet.size())) {
+					for (unsigned j = 0; j < count; j++)
+						_process_packet_op(batch[j], file);
+					return;
+				}
+			}
+
+			seek_off_t const offset = batch[0].position();
+
+			size_t res_length = 0;
 
+			switch (batch[0].operation()) {
+
+			case Packet_descriptor::READ:
+				res_length = file.read(iov, count, offset);
+				break;
+
+			case Packet_descriptor::WRITE:
+				res_length = file.write(iov, count, offset);
+				break;
+			}
+
+			for (unsigned i = 0; i < count; i++) {
+				size_t const length = min(res_length, batch[i].length());
+				batch[i].length(length);
+				batch[i].succeeded(length > 0);
+				res_length -= length;
+			}
+		}
+
+		void _process_batch(Packet_descriptor *batch, unsigned count)
+		{
 			/* assume failure by default */
-			packet.succeeded(false);
+			for (unsigned i = 0; i < count; i++)
+				batch[i].succeeded(false);
 
 			try {
-				Node *node = _handle_registry.lookup_and_lock(packet.handle());
+				Node *node = _handle_registry.lookup_and_lock(batch[0].handle());
 				Node_lock_guard guard(node);
 
-				_process_packet_op(packet, *node);
+				File *file = dynamic_cast<File *>(node);
+				if (file && count > 1)
+					_process_batch_op(batch, count, *file);
+				else
+					for (unsigned i = 0; i < count; i++)
+						_process_packet_op(batch[i], *node);
 			}
 			catch (Invalid_handle)     { PERR("Invalid_handle");     }
 
 			/*
-			 * The 'acknowledge_packet' function cannot block because we
-			 * checked for 'ready_to_ack' in '_process_packets'.
+			 * The 'acknowledge_packet' function cannot block because the
+			 * batch size is limited by the free slots of the ack queue.
 			 */
-			tx_sink()->acknowledge_packet(packet);
+			for (unsigned i = 0; i < count; i++)
+				tx_sink()->acknowledge_packet(batch[i]);
 		}
 
 		/**
 		 * Called by signal dispatcher, executed in the context of the main
-		 * thread (not serialized with the RPC functions)
+		 * thread or the I/O worker (not serialized with the RPC functions)
 		 */
 		void _process_packets(unsigned)
 		{
@@ -125,10 +223,22 @@ class File_system::Session_component : public Session_rpc_object
 				 * of the main thread. The main thread is however needed
 				 * for receiving any subsequent 'ready-to-ack' signals.
 				 */
-				if (!tx_sink()->ready_to_ack())
+				unsigned const ack_slots = min(tx_sink()->ack_slots_free(),
+				                               (unsigned)MAX_BATCH);
+				if (!ack_slots)
 					return;
 
-				_process_packet();
+				/* gather packets that continue the first one */
+				Packet_descriptor batch[MAX_BATCH];
+				unsigned count = 0;
+
+				batch[count++] = tx_sink()->get_packet();
+
+				while (count < ack_slots && tx_sink()->packet_avail()
+				    && _contiguous(batch[count - 1], tx_sink()->peek_packet()))
+					batch[count++] = tx_sink()->get_packet();
+
+				_process_batch(batch, count);
 			}
 		}
 
@@ -152,21 +262,32 @@ class File_system::Session_component : public Session_rpc_object
 		                  Server::Entrypoint &ep,
 		                  char const         *root_dir,
 		                  bool                writable,
-		                  Allocator          &md_alloc)
+		                  Allocator          &md_alloc,
+		                  Io_worker          *worker)
 		:
 			Session_rpc_object(env()->ram_session()->alloc(tx_buf_size), ep.rpc_ep()),
 			_ep(ep),
 			_md_alloc(md_alloc),
 			_root(*new (&_md_alloc) Directory(_md_alloc, root_dir, false)),
-			_writable(writable),
-			_process_packet_dispatcher(ep, *this, &Session_component::_process_packets)
+			_writable(writable)
 		{
 			/*
 			 * Register '_process_packets' dispatch function as signal
 			 * handler for packet-avail and ready-to-ack signals.
 			 */
-			_tx.sigh_packet_avail(_process_packet_dispatcher);
-			_tx.sigh_ready_to_ack(_process_packet_dispatcher);
+			Signal_context_capability sigh;
+			if (worker) {
+				_worker_dispatcher.construct(worker->sig_rec, *this,
+				                             &Session_component::_process_packets);
+				sigh = *_worker_dispatcher;
+			} else {
+				_ep_dispatcher.construct(ep, *this,
+				                         &Session_component::_process_packets);
+				sigh = *_ep_dispatcher;
+			}
+
+			_tx.sigh_packet_avail(sigh);
+			_tx.sigh_ready_to_ack(sigh);
 		}
 
 		/**
@@ -174,6 +295,10 @@ class File_system::Session_component : public Session_rpc_object
 		 */
 		~Session_component()
 		{
+			/* make sure that no packets are processed concurrently */
+			_worker_dispatcher.destruct();
+			_ep_dispatcher.destruct();
+
 			Dataspace_capability ds = tx_sink()->dataspace();
 			env()->ram_session()->free(static_cap_cast<Ram_dataspace>(ds));
 			destroy(&_md_alloc, &_root);
@@ -320,6 +445,25 @@ class File_system::Root : public Root_component<Session_component>
 
 		Server::Entrypoint &_ep;
 
+		enum { MAX_WORKERS = 16 };
+
+		Io_worker *_workers[MAX_WORKERS];
+		unsigned   _num_workers = 0;
+		unsigned   _next_worker = 0;
+
+		/**
+		 * Select I/O worker for a new session in a round-robin fashion
+		 *
+		 * \return  worker, or 0 if packets are processed by the entrypoint
+		 */
+		Io_worker *_select_worker()
+		{
+			if (!_num_workers)
+				return 0;
+
+			return _workers[_next_worker++ % _num_workers];
+		}
+
 	protected:
 
 		Session_component *_create_session(const char *args)
@@ -400,7 +544,8 @@ class File_system::Root : public Root_component<Session_component>
 
 			try {
 				return new (md_alloc())
-				       Session_component(tx_buf_size, _ep, root_dir, writeable, *md_alloc());
+				       Session_component(tx_buf_size, _ep, root_dir, writeable,
+				                         *md_alloc(), _select_worker());
 			} catch (Lookup_failed) {
 				PERR("Session root directory \"%s\" does not exist", root);
 				throw Root::Unavailable();
@@ -416,12 +561,17 @@ class File_system::Root : public Root_component<Session_component>
 		 * \param sig_rec     signal receiver used for handling the
 		 *                    data-flow signals of packet streams
 		 * \param md_alloc    meta-data allocator
+		 * \param threads     number of I/O worker threads, 0 for
+		 *                    processing packets by the entrypoint
 		 */
-		Root(Server::Entrypoint &ep, Allocator &md_alloc)
+		Root(Server::Entrypoint &ep, Allocator &md_alloc, unsigned threads)
 		:
 			Root_component<Session_component>(&ep.rpc_ep(), &md_alloc),
 			_ep(ep)
-		{ }
+		{
+			for (; _num_workers < min(threads, (unsigned)MAX_WORKERS); _num_workers++)
+				_workers[_num_workers] = new (env()->heap()) Io_worker("lx_fs_io");
+		}
 };
 
 
@@ -434,7 +584,8 @@ struct File_system::Main
 	 */
 	Sliced_heap sliced_heap = { env()->ram_session(), env()->rm_session() };
 
-	Root fs_root = { ep, sliced_heap };
+	Root fs_root = { ep, sliced_heap,
+	                 config()->xml_node().attribute_value("threads", 0U) };
 
 	Main(Server::Entrypoint &ep) : ep(ep)
 	{
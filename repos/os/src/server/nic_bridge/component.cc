@@ -38,9 +38,7 @@ bool Session_component::handle_arp(Ethernet_frame *eth, Genode::size_t size)
 		 if (arp->src_ip() == arp->dst_ip())
 			return false;
 
-		Ipv4_address_node *node = vlan().ip_tree.first();
-		if (node)
-			node = node->find_by_address(arp->dst_ip());
+		Ipv4_address_node *node = lookup_ip(arp->dst_ip());
 		if (!node) {
 			arp->src_mac(_nic.mac());
 		}
@@ -74,9 +72,7 @@ bool Session_component::handle_ip(Ethernet_frame *eth, Genode::size_t size)
 void Session_component::finalize_packet(Ethernet_frame *eth,
                                                     Genode::size_t size)
 {
-	Mac_address_node *node = vlan().mac_tree.first();
-	if (node)
-		node = node->find_by_address(eth->dst());
+	Mac_address_node *node = lookup_mac(eth->dst());
 	if (node)
 		node->component().send(eth, size);
 	else {
@@ -91,8 +87,10 @@ void Session_component::_unset_ipv4_node()
 {
 	Ipv4_address_node * first = vlan().ip_tree.first();
 	if (!first) return;
-	if (first->find_by_address(_ipv4_node.addr()))
+	if (first->find_by_address(_ipv4_node.addr())) {
 		vlan().ip_tree.remove(&_ipv4_node);
+		vlan().changed();
+	}
 }
 
 
@@ -104,6 +102,7 @@ void Session_component::set_ipv4_address(Ipv4_packet::Ipv4_address ip_addr)
 	_unset_ipv4_node();
 	_ipv4_node.addr(ip_addr);
 	vlan().ip_tree.insert(&_ipv4_node);
+	vlan().changed();
 }
 
 
@@ -128,6 +127,7 @@ Session_component::Session_component(Genode::Ram_session        &ram,
 {
 	vlan().mac_tree.insert(&_mac_node);
 	vlan().mac_list.insert(&_mac_node);
+	vlan().changed();
 
 	/* static ip parsing */
 	if (ip_addr != 0 && Genode::strlen(ip_addr)) {
@@ -151,5 +151,6 @@ Session_component::Session_component(Genode::Ram_session        &ram,
 Session_component::~Session_component() {
 	vlan().mac_tree.remove(&_mac_node);
 	vlan().mac_list.remove(&_mac_node);
+	vlan().changed();
 	_unset_ipv4_node();
 }
@@ -148,6 +148,8 @@ class Net::Session_component : public  Net::Stream_allocator,
 
 		void set_ipv4_address(Ipv4_packet::Ipv4_address ip_addr);
 
+		Ipv4_packet::Ipv4_address ipv4_address() { return _ipv4_node.addr(); }
+
 
 		/****************************************
 		 ** Nic::Driver notification interface **
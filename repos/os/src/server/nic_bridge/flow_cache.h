@@ -0,0 +1,88 @@
+/*
+ * \brief  Cache of recently used address lookups
+ * \author Genode Labs
+ * \date   2016-07-05
+ *
+ * Frames of a flow usually carry the same destination address. The cache
+ * remembers the result of the most recent lookups in the address trees of
+ * the virtual LAN so that the trees are traversed only for the first frame
+ * of a flow.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _FLOW_CACHE_H_
+#define _FLOW_CACHE_H_
+
+/* Genode */
+#include <util/avl_tree.h>
+
+#include <address_node.h>
+
+namespace Net { template <typename> class Flow_cache; }
+
+
+template <typename ADDRESS>
+class Net::Flow_cache
+{
+	public:
+
+		using Node = Address_node<ADDRESS>;
+		using Tree = Genode::Avl_tree<Node>;
+
+	private:
+
+		enum { SIZE = 16 };
+
+		struct Entry
+		{
+			ADDRESS       addr;
+			Node         *node       = nullptr;
+			unsigned long generation = 0;
+		};
+
+		Entry _entries[SIZE];
+
+		static unsigned _index(ADDRESS const &addr)
+		{
+			unsigned hash = 0;
+			for (unsigned i = 0; i < sizeof(addr.addr); i++)
+				hash ^= addr.addr[i];
+			return hash % SIZE;
+		}
+
+	public:
+
+		/**
+		 * Look up node with the specified address
+		 *
+		 * \param generation  generation of the address tree, entries of
+		 *                    older generations are invalid
+		 *
+		 * \return  node, or 0 if no node has the address
+		 */
+		Node *lookup(Tree &tree, ADDRESS addr, unsigned long generation)
+		{
+			Entry &entry = _entries[_index(addr)];
+
+			if (entry.generation == generation && entry.addr == addr)
+				return entry.node;
+
+			Node *node = tree.first();
+			if (node)
+				node = node->find_by_address(addr);
+
+			entry.addr       = addr;
+			entry.node       = node;
+			entry.generation = generation;
+
+			return node;
+		}
+};
+
+#endif /* _FLOW_CACHE_H_ */
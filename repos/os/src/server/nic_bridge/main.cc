@@ -18,8 +18,10 @@
 #include <base/component.h>
 #include <base/env.h>
 #include <base/log.h>
+#include <base/snprintf.h>
 #include <nic_session/connection.h>
 #include <nic/packet_allocator.h>
+#include <os/periodic_reporter.h>
 
 /* local includes */
 #include <component.h>
@@ -35,6 +37,52 @@ struct Main
 	Net::Nic                        nic    { ep, heap, vlan };
 	Net::Root                       root   { env, nic, heap, config.xml() };
 
+	static void gen_stats(Genode::Xml_generator &xml,
+	                      Net::Packet_handler::Stats const &stats)
+	{
+		xml.attribute("tx_packets", stats.tx_packets);
+		xml.attribute("tx_bytes",   stats.tx_bytes);
+		xml.attribute("rx_packets", stats.rx_packets);
+		xml.attribute("rx_bytes",   stats.rx_bytes);
+		xml.attribute("rx_dropped", stats.rx_dropped);
+	}
+
+	void generate_stats(Genode::Xml_generator &xml)
+	{
+		xml.node("uplink", [&] () { gen_stats(xml, nic.stats()); });
+
+		for (Net::Mac_address_node *node = vlan.mac_list.first(); node;
+		     node = node->next()) {
+
+			Net::Session_component &client = node->component();
+
+			Nic::Mac_address const mac = client.mac_address();
+			char mac_str[18];
+			Genode::snprintf(mac_str, sizeof(mac_str),
+			                 "%02x:%02x:%02x:%02x:%02x:%02x",
+			                 mac.addr[0], mac.addr[1], mac.addr[2],
+			                 mac.addr[3], mac.addr[4], mac.addr[5]);
+
+			Net::Ipv4_packet::Ipv4_address const ip = client.ipv4_address();
+			char ip_str[16];
+			Genode::snprintf(ip_str, sizeof(ip_str), "%d.%d.%d.%d",
+			                 ip.addr[0], ip.addr[1], ip.addr[2], ip.addr[3]);
+
+			xml.node("client", [&] () {
+				xml.attribute("mac", mac_str);
+				xml.attribute("ip",  ip_str);
+				gen_stats(xml, client.stats());
+			});
+		}
+	}
+
+	/*
+	 * Periodic report of the packet counters of the uplink and the clients,
+	 * enabled by a '<report interval_ms="..."/>' config node
+	 */
+	Genode::Periodic_reporter<Main> stats_reporter {
+		env, "nic_bridge_stats", *this, &Main::generate_stats };
+
 	void handle_config()
 	{
 		/* read MAC address prefix from config file */
@@ -44,6 +92,8 @@ struct Main
 			Genode::memcpy(&Net::Mac_allocator::mac_addr_base, &mac,
 			               sizeof(Net::Mac_allocator::mac_addr_base));
 		} catch(...) {}
+
+		stats_reporter.configure(config.xml());
 	}
 
 	Main(Genode::Env &e) : env(e)
@@ -32,9 +32,7 @@ bool Net::Nic::handle_arp(Ethernet_frame *eth, Genode::size_t size) {
 		return true;
 
 	/* look whether the IP address is one of our client's */
-	Ipv4_address_node *node = vlan().ip_tree.first();
-	if (node)
-		node = node->find_by_address(arp->dst_ip());
+	Ipv4_address_node *node = lookup_ip(arp->dst_ip());
 	if (node) {
 		if (arp->opcode() == Arp_packet::REQUEST) {
 			/*
@@ -104,17 +102,14 @@ bool Net::Nic::handle_ip(Ethernet_frame *eth, Genode::size_t size) {
 
 	/* is it an unicast message to one of our clients ? */
 	if (eth->dst() == mac()) {
-		Ipv4_address_node *node = vlan().ip_tree.first();
+		Ipv4_address_node *node = lookup_ip(ip->dst());
 		if (node) {
-			node = node->find_by_address(ip->dst());
-			if (node) {
-				/* overwrite destination MAC */
-				eth->dst(node->component().mac_address().addr);
-
-				/* deliver the packet to the client */
-				node->component().send(eth, size);
-				return false;
-			}
+			/* overwrite destination MAC */
+			eth->dst(node->component().mac_address().addr);
+
+			/* deliver the packet to the client */
+			node->component().send(eth, size);
+			return false;
 		}
 	}
 	return true;
@@ -25,15 +25,16 @@ using namespace Net;
 
 void Packet_handler::_ready_to_submit()
 {
-	/* as long as packets are available, and we can ack them */
-	while (sink()->packet_avail()) {
+	/*
+	 * As long as packets are available, and we can ack them. All packets
+	 * pending at the time of the signal are handled as one batch.
+	 */
+	while (sink()->packet_avail() && sink()->ready_to_ack()) {
 		_packet = sink()->get_packet();
-		if (!_packet.size()) continue;
-		handle_ethernet(sink()->packet_content(_packet), _packet.size());
-
-		if (!sink()->ready_to_ack()) {
-			Genode::warning("ack state FULL");
-			return;
+		if (_packet.size()) {
+			_stats.tx_packets++;
+			_stats.tx_bytes += _packet.size();
+			handle_ethernet(sink()->packet_content(_packet), _packet.size());
 		}
 
 		sink()->acknowledge_packet(_packet);
@@ -109,15 +110,36 @@ void Packet_handler::handle_ethernet(void* src, Genode::size_t size)
 
 void Packet_handler::send(Ethernet_frame *eth, Genode::size_t size)
 {
+	using Source = Packet_stream_source< ::Nic::Session::Policy>;
+
+	if (!source()->ready_to_submit()) {
+		_stats.rx_dropped++;
+		return;
+	}
+
+	Packet_descriptor packet;
 	try {
-		/* copy and submit packet */
-		Packet_descriptor packet  = source()->alloc_packet(size);
-		char             *content = source()->packet_content(packet);
-		Genode::memcpy((void*)content, (void*)eth, size);
-		source()->submit_packet(packet);
-	} catch(Packet_stream_source< ::Nic::Session::Policy>::Packet_alloc_failed) {
-		Genode::warning("Packet dropped");
+		packet = source()->alloc_packet(size);
+	} catch (Source::Packet_alloc_failed) {
+
+		/* release packets acknowledged meanwhile and retry */
+		_ready_to_ack();
+		try {
+			packet = source()->alloc_packet(size);
+		} catch (Source::Packet_alloc_failed) {
+			_stats.rx_dropped++;
+			Genode::warning("Packet dropped");
+			return;
+		}
 	}
+
+	/* copy and submit packet */
+	char *content = source()->packet_content(packet);
+	Genode::memcpy((void*)content, (void*)eth, size);
+	source()->submit_packet(packet);
+
+	_stats.rx_packets++;
+	_stats.rx_bytes += size;
 }
 
 
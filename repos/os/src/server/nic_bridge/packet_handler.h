@@ -22,6 +22,7 @@
 #include <net/ethernet.h>
 #include <net/ipv4.h>
 
+#include <flow_cache.h>
 #include <vlan.h>
 
 namespace Net {
@@ -38,10 +39,28 @@ namespace Net {
  */
 class Net::Packet_handler
 {
+	public:
+
+		/**
+		 * Packet counters of the handler
+		 */
+		struct Stats
+		{
+			unsigned long tx_packets = 0;  /* frames sent into the bridge */
+			unsigned long tx_bytes   = 0;
+			unsigned long rx_packets = 0;  /* frames delivered by the bridge */
+			unsigned long rx_bytes   = 0;
+			unsigned long rx_dropped = 0;  /* frames dropped on delivery */
+		};
+
 	private:
 
 		Packet_descriptor _packet;
 		Net::Vlan        &_vlan;
+		Stats             _stats;
+
+		Flow_cache<Ethernet_frame::Mac_address> _mac_cache;
+		Flow_cache<Ipv4_packet::Ipv4_address>   _ip_cache;
 
 		/**
 		 * submit queue not empty anymore
@@ -51,10 +70,10 @@ class Net::Packet_handler
 		/**
 		 * acknoledgement queue not full anymore
 		 *
-		 * TODO: by now, we assume ACK and SUBMIT queue to be equally
-		 *       dimensioned. That's why we ignore this signal by now.
+		 * '_ready_to_submit' stops processing packets while the
+		 * acknowledgement queue is full. Hence, resume processing.
 		 */
-		void _ack_avail() { }
+		void _ack_avail() { _ready_to_submit(); }
 
 		/**
 		 * acknoledgement queue not empty anymore
@@ -91,6 +110,20 @@ class Net::Packet_handler
 
 		Net::Vlan & vlan() { return _vlan; }
 
+		Stats const & stats() const { return _stats; }
+
+		/**
+		 * Look up client with the specified MAC address
+		 */
+		Mac_address_node *lookup_mac(Ethernet_frame::Mac_address mac) {
+			return _mac_cache.lookup(_vlan.mac_tree, mac, _vlan.generation); }
+
+		/**
+		 * Look up client with the specified IP address
+		 */
+		Ipv4_address_node *lookup_ip(Ipv4_packet::Ipv4_address ip) {
+			return _ip_cache.lookup(_vlan.ip_tree, ip, _vlan.generation); }
+
 		/**
 		 * Broadcasts ethernet frame to all clients,
 		 * as long as its really a broadcast packtet.
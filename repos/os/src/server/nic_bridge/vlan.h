@@ -35,6 +35,14 @@ namespace Net {
 		Mac_address_tree  mac_tree;
 		Mac_address_list  mac_list;
 		Ipv4_address_tree ip_tree;
+
+		/*
+		 * Generation of the address trees, incremented on each change to
+		 * invalidate the flow caches
+		 */
+		unsigned long generation = 1;
+
+		void changed() { generation++; }
 	};
 }
 
@@ -17,6 +17,8 @@
 #include <nitpicker_gfx/box_painter.h>
 #include <nitpicker_gfx/text_painter.h>
 #include <nitpicker_gfx/texture_painter.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
 
 typedef Genode::Surface_base::Area    Area;
 typedef Genode::Surface_base::Point   Point;
@@ -42,8 +44,10 @@ struct Canvas_base
 
 	virtual void draw_box(Rect, Color) = 0;
 
-	virtual void draw_texture(Point, Texture_base const &, Texture_painter::Mode,
-	                          Color mix_color, bool allow_alpha) = 0;
+	virtual void draw_texture(Point, Texture_base const &,
+	                          Genode::Surface_base::Pixel_format,
+	                          Texture_painter::Mode, Color mix_color,
+	                          bool allow_alpha) = 0;
 
 	virtual void draw_text(Point, Text_painter::Font const &, Color,
 	                       char const *string) = 0;
@@ -60,6 +64,16 @@ class Canvas : public Canvas_base, public Genode::Surface_base::Flusher
 
 		Genode::Surface<PT> _surface;
 
+		template <typename TPT>
+		void _draw_texture(Point pos, Texture_base const &texture_base,
+		                   Texture_painter::Mode mode, Color mix_color,
+		                   bool allow_alpha)
+		{
+			Texture<TPT> const &texture = static_cast<Texture<TPT> const &>(texture_base);
+			Texture_painter::paint(_surface, texture, mix_color, pos, mode,
+			                       allow_alpha);
+		}
+
 	public:
 
 		Canvas(PT *base, Area size) : _surface(base, size)
@@ -83,13 +97,27 @@ class Canvas : public Canvas_base, public Genode::Surface_base::Flusher
 			Box_painter::paint(_surface, rect, color);
 		}
 
+		/*
+		 * Textures of a pixel format other than 'PT' are converted while
+		 * drawing.
+		 */
 		void draw_texture(Point pos, Texture_base const &texture_base,
+		                  Genode::Surface_base::Pixel_format format,
 		                  Texture_painter::Mode mode, Color mix_color,
 		                  bool allow_alpha)
 		{
-			Texture<PT> const &texture = static_cast<Texture<PT> const &>(texture_base);
-			Texture_painter::paint(_surface, texture, mix_color, pos, mode,
-			                       allow_alpha);
+			switch (format) {
+			case Genode::Surface_base::RGB565:
+				_draw_texture<Genode::Pixel_rgb565>(pos, texture_base, mode,
+				                                    mix_color, allow_alpha);
+				break;
+			case Genode::Surface_base::RGB888:
+				_draw_texture<Genode::Pixel_rgb888>(pos, texture_base, mode,
+				                                    mix_color, allow_alpha);
+				break;
+			default:
+				break;
+			}
 		}
 
 		void draw_text(Point pos, Text_painter::Font const &font,
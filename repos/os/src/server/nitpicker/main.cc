@@ -29,6 +29,8 @@
 #include <framebuffer_session/connection.h>
 #include <util/color.h>
 #include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+#include <util/volatile_object.h>
 #include <os/session_policy.h>
 #include <os/reporter.h>
 
@@ -44,7 +46,7 @@ namespace Framebuffer { class Session_component; }
 
 namespace Nitpicker {
 	class Session_component;
-	template <typename> class Root;
+	class Root;
 	struct Main;
 }
 
@@ -53,6 +55,7 @@ using Genode::Allocator;
 using Genode::Entrypoint;
 using Genode::List;
 using Genode::Pixel_rgb565;
+using Genode::Pixel_rgb888;
 using Genode::strcmp;
 using Genode::Env;
 using Genode::Arg_string;
@@ -165,8 +168,14 @@ class Chunky_dataspace_texture : public Buffer,
 {
 	private:
 
-		Framebuffer::Mode::Format _format() {
-			return Framebuffer::Mode::RGB565; }
+		Framebuffer::Mode::Format _format()
+		{
+			switch (PT::format()) {
+			case Genode::Surface_base::RGB565: return Framebuffer::Mode::RGB565;
+			case Genode::Surface_base::RGB888: return Framebuffer::Mode::XRGB8888;
+			default:                           return Framebuffer::Mode::INVALID;
+			}
+		}
 
 		/**
 		 * Return base address of alpha channel or 0 if no alpha channel exists
@@ -452,18 +461,22 @@ class Nitpicker::Session_component : public Genode::Rpc_object<Session>,
 
 		Genode::Reporter &_focus_reporter;
 
-		void _release_buffer()
-		{
-			if (!::Session::texture())
-				return;
-
-			typedef Pixel_rgb565 PT;
+		/* pixel format of the currently allocated virtual framebuffer */
+		Framebuffer::Mode::Format _buffer_format = Framebuffer::Mode::INVALID;
 
+		/*
+		 * The pixel format of the virtual framebuffer is requested by the
+		 * client. Only if it corresponds to the format of the physical
+		 * framebuffer, the session's texture is drawn without conversion.
+		 */
+		template <typename PT>
+		void _release_texture()
+		{
 			/* retrieve pointer to texture from session */
 			Chunky_dataspace_texture<PT> const *cdt =
 				static_cast<Chunky_dataspace_texture<PT> const *>(::Session::texture());
 
-			::Session::texture(0, false);
+			::Session::texture(0, Genode::Surface_base::UNKNOWN, false);
 			::Session::input_mask(0);
 
 			destroy(&_session_alloc, const_cast<Chunky_dataspace_texture<PT> *>(cdt));
@@ -472,6 +485,71 @@ class Nitpicker::Session_component : public Genode::Rpc_object<Session>,
 			_buffer_size = 0;
 		}
 
+		void _release_buffer()
+		{
+			if (!::Session::texture())
+				return;
+
+			switch (_buffer_format) {
+			case Framebuffer::Mode::XRGB8888: _release_texture<Pixel_rgb888>(); break;
+			default:                          _release_texture<Pixel_rgb565>(); break;
+			}
+
+			_buffer_format = Framebuffer::Mode::INVALID;
+		}
+
+		template <typename PT>
+		Buffer *_realloc_texture(Framebuffer::Mode mode, bool use_alpha)
+		{
+			Area const size(mode.width(), mode.height());
+
+			_buffer_size =
+				Chunky_dataspace_texture<PT>::calc_num_bytes(size, use_alpha);
+
+			/*
+			 * Preserve the content of the original buffer if nitpicker has
+			 * enough lack memory to temporarily keep the original pixels.
+			 */
+			Texture<PT> const *src_texture = nullptr;
+			if (::Session::texture()) {
+
+				enum { PRESERVED_RAM = 128*1024 };
+				if (_env.ram().avail() > _buffer_size + PRESERVED_RAM) {
+					src_texture = static_cast<Texture<PT> const *>(::Session::texture());
+				} else {
+					Genode::warning("not enough RAM to preserve buffer content during resize");
+					_release_buffer();
+				}
+			}
+
+			Chunky_dataspace_texture<PT> * const texture = new (&_session_alloc)
+				Chunky_dataspace_texture<PT>(_env.ram(), _env.rm(), size, use_alpha);
+
+			/* copy old buffer content into new buffer and release old buffer */
+			if (src_texture) {
+
+				Genode::Surface<PT> surface(texture->pixel(),
+				                            texture->Texture_base::size());
+
+				Texture_painter::paint(surface, *src_texture, Color(), Point(0, 0),
+				                       Texture_painter::SOLID, false);
+				_release_buffer();
+			}
+
+			if (!_session_alloc.withdraw(_buffer_size)) {
+				destroy(&_session_alloc, texture);
+				_buffer_size = 0;
+				return 0;
+			}
+
+			::Session::texture(texture, PT::format(), use_alpha);
+			::Session::input_mask(texture->input_mask_buffer());
+
+			_buffer_format = mode.format();
+
+			return texture;
+		}
+
 		/**
 		 * Helper for performing sanity checks in OP_TO_FRONT and OP_TO_BACK
 		 *
@@ -903,6 +981,14 @@ class Nitpicker::Session_component : public Genode::Rpc_object<Session>,
 
 		void buffer(Framebuffer::Mode mode, bool use_alpha) override
 		{
+			/*
+			 * The client determines the pixel format of its buffer. Textures
+			 * that differ from the physical format are converted when drawn.
+			 */
+			if (mode.format() != Framebuffer::Mode::XRGB8888)
+				mode = Framebuffer::Mode(mode.width(), mode.height(),
+				                         Framebuffer::Mode::RGB565);
+
 			/* check if the session quota suffices for the specified mode */
 			if (_session_alloc.quota() < ram_quota(mode, use_alpha))
 				throw Nitpicker::Session::Out_of_metadata();
@@ -956,58 +1042,20 @@ class Nitpicker::Session_component : public Genode::Rpc_object<Session>,
 
 		Buffer *realloc_buffer(Framebuffer::Mode mode, bool use_alpha)
 		{
-			typedef Pixel_rgb565 PT;
-
-			Area const size(mode.width(), mode.height());
-
-			_buffer_size =
-				Chunky_dataspace_texture<PT>::calc_num_bytes(size, use_alpha);
-
-			/*
-			 * Preserve the content of the original buffer if nitpicker has
-			 * enough lack memory to temporarily keep the original pixels.
-			 */
-			Texture<PT> const *src_texture = nullptr;
-			if (::Session::texture()) {
-
-				enum { PRESERVED_RAM = 128*1024 };
-				if (_env.ram().avail() > _buffer_size + PRESERVED_RAM) {
-					src_texture = static_cast<Texture<PT> const *>(::Session::texture());
-				} else {
-					Genode::warning("not enough RAM to preserve buffer content during resize");
-					_release_buffer();
-				}
-			}
-
-			Chunky_dataspace_texture<PT> * const texture = new (&_session_alloc)
-				Chunky_dataspace_texture<PT>(_env.ram(), _env.rm(), size, use_alpha);
-
-			/* copy old buffer content into new buffer and release old buffer */
-			if (src_texture) {
-
-				Genode::Surface<PT> surface(texture->pixel(),
-				                            texture->Texture_base::size());
-
-				Texture_painter::paint(surface, *src_texture, Color(), Point(0, 0),
-				                       Texture_painter::SOLID, false);
+			/* buffer content cannot be preserved across pixel formats */
+			if (_buffer_format != mode.format())
 				_release_buffer();
-			}
 
-			if (!_session_alloc.withdraw(_buffer_size)) {
-				destroy(&_session_alloc, texture);
-				_buffer_size = 0;
-				return 0;
+			switch (mode.format()) {
+			case Framebuffer::Mode::XRGB8888:
+				return _realloc_texture<Pixel_rgb888>(mode, use_alpha);
+			default:
+				return _realloc_texture<Pixel_rgb565>(mode, use_alpha);
 			}
-
-			::Session::texture(texture, use_alpha);
-			::Session::input_mask(texture->input_mask_buffer());
-
-			return texture;
 		}
 };
 
 
-template <typename PT>
 class Nitpicker::Root : public Genode::Root_component<Session_component>
 {
 	private:
@@ -1107,13 +1155,14 @@ struct Nitpicker::Main
 
 	Input::Event * const ev_buf = env.rm().attach(input.dataspace());
 
-	typedef Pixel_rgb565 PT;  /* physical pixel type */
-
 	/*
 	 * Initialize framebuffer
 	 *
 	 * The framebuffer is encapsulated in a volatile object to allow its
 	 * reconstruction at runtime as a response to resolution changes.
+	 *
+	 * The physical pixel type is determined by the pixel format of the
+	 * framebuffer.
 	 */
 	struct Framebuffer_screen
 	{
@@ -1123,12 +1172,36 @@ struct Nitpicker::Main
 
 		Attached_dataspace fb_ds = { framebuffer.dataspace() };
 
-		Screen<PT> screen = { fb_ds.local_addr<PT>(), Area(mode.width(), mode.height()) };
+		Area const size { (unsigned)mode.width(), (unsigned)mode.height() };
+
+		Genode::Lazy_volatile_object<Screen<Pixel_rgb565> > screen_rgb565;
+		Genode::Lazy_volatile_object<Screen<Pixel_rgb888> > screen_xrgb8888;
+
+		Canvas_base &screen()
+		{
+			if (screen_xrgb8888.constructed())
+				return *screen_xrgb8888;
+
+			return *screen_rgb565;
+		}
 
 		/**
 		 * Constructor
 		 */
-		Framebuffer_screen(Framebuffer::Session &fb) : framebuffer(fb) { }
+		Framebuffer_screen(Framebuffer::Session &fb) : framebuffer(fb)
+		{
+			switch (mode.format()) {
+			case Framebuffer::Mode::XRGB8888:
+				screen_xrgb8888.construct(fb_ds.local_addr<Pixel_rgb888>(), size);
+				break;
+			case Framebuffer::Mode::RGB565:
+				screen_rgb565.construct(fb_ds.local_addr<Pixel_rgb565>(), size);
+				break;
+			default:
+				Genode::error("unsupported pixel format of framebuffer");
+				throw Genode::Exception();
+			}
+		}
 	};
 
 	Genode::Volatile_object<Framebuffer_screen> fb_screen = { framebuffer };
@@ -1152,7 +1225,7 @@ struct Nitpicker::Main
 	Genode::Volatile_object<Domain_registry> domain_registry {
 		domain_registry_heap, Genode::Xml_node("<config/>") };
 
-	User_state user_state = { global_keys, fb_screen->screen.size() };
+	User_state user_state = { global_keys, fb_screen->size };
 
 	/*
 	 * Create view stack with default elements
@@ -1172,7 +1245,7 @@ struct Nitpicker::Main
 
 	Genode::Attached_rom_dataspace config { env, "config" };
 
-	Root<PT> np_root = { env, config, session_list, *domain_registry,
+	Root np_root = { env, config, session_list, *domain_registry,
 	                     global_keys, user_state, user_state, pointer_origin,
 	                     sliced_heap, framebuffer, focus_reporter };
 
@@ -1228,7 +1301,7 @@ struct Nitpicker::Main
 	 */
 	void draw_and_flush()
 	{
-		user_state.draw(fb_screen->screen).flush([&] (Rect const &rect) {
+		user_state.draw(fb_screen->screen()).flush([&] (Rect const &rect) {
 			framebuffer.refresh(rect.x1(), rect.y1(),
 			                    rect.w(),  rect.h()); });
 	}
@@ -1304,7 +1377,7 @@ void Nitpicker::Main::handle_input()
 		user_state.geometry(pointer_origin, Rect(new_pointer_pos, Area()));
 
 	/* perform redraw and flush pixels to the framebuffer */
-	user_state.draw(fb_screen->screen).flush([&] (Rect const &rect) {
+	user_state.draw(fb_screen->screen()).flush([&] (Rect const &rect) {
 		framebuffer.refresh(rect.x1(), rect.y1(),
 		                    rect.w(),  rect.h()); });
 
@@ -1378,6 +1451,16 @@ void Nitpicker::Main::handle_config()
 
 void Nitpicker::Main::handle_fb_mode()
 {
+	/*
+	 * The pixel format of the clients' virtual framebuffers follows the
+	 * physical pixel format. Because existing client buffers cannot be
+	 * converted, a change of the pixel format at runtime is not supported.
+	 */
+	if (framebuffer.mode().format() != fb_screen->mode.format()) {
+		Genode::error("change of framebuffer pixel format is not supported");
+		return;
+	}
+
 	/* reconstruct framebuffer screen and menu bar */
 	fb_screen.construct(framebuffer);
 
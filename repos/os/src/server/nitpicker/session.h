@@ -38,6 +38,7 @@ class Session : public Session_list::Element
 		Genode::Session_label  const  _label;
 		Domain_registry::Entry const *_domain;
 		Texture_base           const *_texture = { 0 };
+		Genode::Surface_base::Pixel_format _texture_format = { Genode::Surface_base::UNKNOWN };
 		bool                          _uses_alpha = { false };
 		bool                          _visible = true;
 		View                         *_background = 0;
@@ -97,10 +98,15 @@ class Session : public Session_list::Element
 
 		Texture_base const *texture() const { return _texture; }
 
-		void texture(Texture_base const *texture, bool uses_alpha)
+		Genode::Surface_base::Pixel_format texture_format() const {
+			return _texture_format; }
+
+		void texture(Texture_base const *texture,
+		             Genode::Surface_base::Pixel_format format, bool uses_alpha)
 		{
-			_texture    = texture;
-			_uses_alpha = uses_alpha;
+			_texture        = texture;
+			_texture_format = format;
+			_uses_alpha     = uses_alpha;
 		}
 
 		/**
@@ -132,7 +132,8 @@ void View::draw(Canvas_base &canvas, Mode const &mode) const
 
 	if (_session.texture()) {
 		canvas.draw_texture(_buffer_off + view_rect.p1(), *_session.texture(),
-		                    op, mix_color, allow_alpha);
+		                    _session.texture_format(), op, mix_color,
+		                    allow_alpha);
 	} else {
 		canvas.draw_box(view_rect, BLACK);
 	}
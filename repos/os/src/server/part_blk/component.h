@@ -17,6 +17,7 @@
 #include <os/session_policy.h>
 #include <base/exception.h>
 #include <root/component.h>
+#include <util/fifo.h>
 #include <block_session/rpc_object.h>
 
 #include "gpt.h"
@@ -31,7 +32,7 @@ namespace Block {
 
 
 class Block::Session_component : public Block::Session_rpc_object,
-                                 public List<Block::Session_component>::Element,
+                                 public Fifo<Block::Session_component>::Element,
                                  public Block_dispatcher
 {
 	private:
@@ -72,21 +73,32 @@ class Block::Session_component : public Block::Session_rpc_object,
 			_p_to_handle = packet;
 			_p_to_handle.succeeded(false);
 
+			bool const sync = packet.operation() == Packet_descriptor::SYNC;
+
 			/* ignore invalid packets */
-			if (!packet.size() || !_range_check(_p_to_handle)) {
+			if (!packet.size() || (!sync && !_range_check(_p_to_handle))) {
+				_ack_packet(_p_to_handle);
+				return;
+			}
+
+			/* fall back to the sync RPC if the device lacks sync packets */
+			if (sync && !Driver::driver().ops().supported(Packet_descriptor::SYNC)) {
+				Driver::driver().session().sync();
+				_p_to_handle.succeeded(true);
 				_ack_packet(_p_to_handle);
 				return;
 			}
 
-			bool write   = _p_to_handle.operation() == Packet_descriptor::WRITE;
-			sector_t off = _p_to_handle.block_number() + _partition->lba;
-			size_t cnt   = _p_to_handle.block_count();
+			/* a sync request applies to the whole device */
+			sector_t off = sync ? 0 : _p_to_handle.block_number() + _partition->lba;
+			size_t cnt   = sync ? 0 : _p_to_handle.block_count();
 			void* addr   = tx_sink()->packet_content(_p_to_handle);
 			try {
-				Driver::driver().io(write, off, cnt, addr, *this, _p_to_handle);
+				Driver::driver().io(off, cnt, addr, *this, _p_to_handle);
 			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
 				_req_queue_full = true;
-				Session_component::wait_queue().insert(this);
+				if (!enqueued())
+					Session_component::wait_queue().enqueue(this);
 			}
 		}
 
@@ -136,6 +148,12 @@ class Block::Session_component : public Block::Session_rpc_object,
 			_tx.sigh_packet_avail(_sink_submit);
 		}
 
+		~Session_component()
+		{
+			Session_component::wait_queue().remove(this);
+			Driver::driver().forget(*this);
+		}
+
 		Partition *partition() { return _partition; }
 
 		void dispatch(Packet_descriptor &request, Packet_descriptor &reply)
@@ -154,19 +172,33 @@ class Block::Session_component : public Block::Session_rpc_object,
 				_packet_avail(0);
 		}
 
-		static List<Session_component>& wait_queue()
+		/**
+		 * Sessions waiting for the back end to accept requests, oldest first
+		 */
+		static Fifo<Session_component>& wait_queue()
 		{
-			static List<Session_component> l;
-			return l;
+			static Fifo<Session_component> q;
+			return q;
 		}
 
+		/**
+		 * Resume the waiting sessions in the order of their arrival
+		 *
+		 * A session that cannot submit its pending request stays at the head
+		 * of the queue so that it is served first when the back end completed
+		 * the next request.
+		 */
 		static void wake_up()
 		{
-			for (Session_component *c = wait_queue().first(); c; c = c->next())
-			{
-				wait_queue().remove(c);
+			while (Session_component *c = wait_queue().head()) {
+
 				c->_req_queue_full = false;
 				c->_handle_packet(c->_p_to_handle);
+
+				if (c->_req_queue_full)
+					return;
+
+				wait_queue().remove(c);
 				c->_packet_avail(0);
 			}
 		}
@@ -181,6 +213,9 @@ class Block::Session_component : public Block::Session_rpc_object,
 			*blk_count = _partition->sectors;
 			*blk_size  = Driver::driver().blk_size();
 			*ops = Driver::driver().ops();
+
+			/* sync packets are supported, at least via the sync RPC */
+			ops->set_operation(Packet_descriptor::SYNC);
 		}
 
 		void sync() { Driver::driver().session().sync(); }
@@ -17,8 +17,6 @@
 #include <base/env.h>
 #include <base/allocator_avl.h>
 #include <base/signal.h>
-#include <base/tslab.h>
-#include <util/list.h>
 #include <block_session/connection.h>
 
 namespace Block {
@@ -38,7 +36,8 @@ class Block::Block_dispatcher
 bool operator== (const Block::Packet_descriptor& p1,
                  const Block::Packet_descriptor& p2)
 {
-	return p1.operation()    == p2.operation()    &&
+	return p1.offset()       == p2.offset()       &&
+	       p1.operation()    == p2.operation()    &&
 	       p1.block_number() == p2.block_number() &&
 	       p1.block_count()  == p2.block_count();
 }
@@ -48,35 +47,121 @@ class Block::Driver
 {
 	public:
 
-	class Request : public Genode::List<Request>::Element
-	{
-		private:
+		enum { DEFAULT_IO_BUFFER_SIZE = 4 * 1024 * 1024 };
 
-			Block_dispatcher &_dispatcher;
-			Packet_descriptor _cli;
-			Packet_descriptor _srv;
+	private:
 
-		public:
+		/**
+		 * Table of the requests submitted to the back-end session
+		 *
+		 * A request is identified by the offset of its back-end packet, which
+		 * is unique among the outstanding packets. The requests are hashed
+		 * by this offset to find the request of an acknowledged packet
+		 * without scanning all outstanding requests.
+		 */
+		class Request_table
+		{
+			public:
 
-			Request(Block_dispatcher &d,
-			        Packet_descriptor &cli,
-			        Packet_descriptor &srv)
-			: _dispatcher(d), _cli(cli), _srv(srv) {}
+				enum { MAX_REQUESTS = Session::TX_QUEUE_SIZE };
 
-			bool handle(Packet_descriptor& reply)
-			{
-				bool ret =  reply == _srv;
-				if (ret) _dispatcher.dispatch(_cli, reply);
-				return ret;
-			}
-	};
+			private:
 
-	private:
+				enum {
+					BUCKETS     = MAX_REQUESTS,
+					ALIGN_LOG2  = 11, /* alignment of 'dma_alloc_packet' */
+					INVALID     = ~0U
+				};
+
+				struct Request
+				{
+					Block_dispatcher *dispatcher;
+					Packet_descriptor cli;
+					Packet_descriptor srv;
+					unsigned          next; /* next request of bucket or free list */
+				};
+
+				Request  _requests[MAX_REQUESTS];
+				unsigned _buckets[BUCKETS];
+				unsigned _free  = 0;
+				unsigned _count = 0;
+
+				static unsigned _bucket(Packet_descriptor const &p) {
+					return (p.offset() >> ALIGN_LOG2) % BUCKETS; }
+
+			public:
+
+				Request_table()
+				{
+					for (unsigned i = 0; i < BUCKETS; i++)
+						_buckets[i] = INVALID;
+
+					for (unsigned i = 0; i < MAX_REQUESTS; i++)
+						_requests[i].next = i + 1 < MAX_REQUESTS ? i + 1 : INVALID;
+				}
+
+				bool full() const { return _count == MAX_REQUESTS; }
+
+				void insert(Block_dispatcher &dispatcher,
+				            Packet_descriptor const &cli,
+				            Packet_descriptor const &srv)
+				{
+					unsigned const index = _free;
+					Request &r = _requests[index];
 
-		enum { BLK_SZ = Session::TX_QUEUE_SIZE*sizeof(Request) };
+					_free = r.next;
+					_count++;
 
-		Genode::Tslab<Request, BLK_SZ>    _r_slab;
-		Genode::List<Request>             _r_list;
+					unsigned &bucket = _buckets[_bucket(srv)];
+
+					r.dispatcher = &dispatcher;
+					r.cli        = cli;
+					r.srv        = srv;
+					r.next       = bucket;
+					bucket       = index;
+				}
+
+				/**
+				 * Remove request of acknowledged back-end packet and
+				 * dispatch the reply to its client
+				 *
+				 * \return  false if the packet belongs to no request
+				 */
+				bool complete(Packet_descriptor &reply)
+				{
+					for (unsigned *link = &_buckets[_bucket(reply)];
+					     *link != INVALID; link = &_requests[*link].next) {
+
+						unsigned const index = *link;
+						Request &r = _requests[index];
+
+						if (!(r.srv == reply))
+							continue;
+
+						*link  = r.next;
+						r.next = _free;
+						_free  = index;
+						_count--;
+
+						if (r.dispatcher)
+							r.dispatcher->dispatch(r.cli, reply);
+						return true;
+					}
+					return false;
+				}
+
+				/**
+				 * Drop replies of all requests of the dispatcher
+				 */
+				void forget(Block_dispatcher &dispatcher)
+				{
+					for (unsigned i = 0; i < MAX_REQUESTS; i++)
+						if (_requests[i].dispatcher == &dispatcher)
+							_requests[i].dispatcher = nullptr;
+				}
+		};
+
+		Request_table                     _requests;
 		Genode::Allocator_avl             _block_alloc;
 		Block::Connection                 _session;
 		Block::sector_t                   _blk_cnt;
@@ -92,13 +177,7 @@ class Block::Driver
 			/* check for acknowledgements */
 			while (_session.tx()->ack_avail()) {
 				Packet_descriptor p = _session.tx()->get_acked_packet();
-				for (Request *r = _r_list.first(); r; r = r->next()) {
-					if (r->handle(p)) {
-						_r_list.remove(r);
-						Genode::destroy(&_r_slab, r);
-						break;
-					}
-				}
+				_requests.complete(p);
 				_session.tx()->release_packet(p);
 			}
 
@@ -107,10 +186,16 @@ class Block::Driver
 
 	public:
 
-		Driver(Genode::Signal_receiver &receiver)
-		: _r_slab(Genode::env()->heap()),
-		  _block_alloc(Genode::env()->heap()),
-		  _session(&_block_alloc, 4 * 1024 * 1024),
+		/**
+		 * Constructor
+		 *
+		 * \param io_buffer_size  size of the back-end communication buffer,
+		 *                        which bounds the amount of data of all
+		 *                        outstanding requests
+		 */
+		Driver(Genode::Signal_receiver &receiver, Genode::size_t io_buffer_size)
+		: _block_alloc(Genode::env()->heap()),
+		  _session(&_block_alloc, io_buffer_size),
 		  _source_ack(receiver, *this, &Driver::_ack_avail),
 		  _source_submit(receiver, *this, &Driver::_ready_to_submit)
 		{
@@ -130,20 +215,29 @@ class Block::Driver
 
 		static Driver& driver();
 
-		void io(bool write, sector_t nr, Genode::size_t cnt, void* addr,
+		/**
+		 * Submit request to the back-end session
+		 *
+		 * \throw Block::Session::Tx::Source::Packet_alloc_failed  the request
+		 *        cannot be submitted until an outstanding request completed
+		 */
+		void io(sector_t nr, Genode::size_t cnt, void* addr,
 		        Block_dispatcher &dispatcher, Packet_descriptor& cli)
 		{
-			if (!_session.tx()->ready_to_submit())
+			if (!_session.tx()->ready_to_submit() || _requests.full())
 				throw Block::Session::Tx::Source::Packet_alloc_failed();
 
-			Block::Packet_descriptor::Opcode op = write
-			    ? Block::Packet_descriptor::WRITE
-			    : Block::Packet_descriptor::READ;
-			Genode::size_t size = _blk_size * cnt;
+			Block::Packet_descriptor::Opcode const op = cli.operation();
+
+			bool const write = op == Block::Packet_descriptor::WRITE;
+			bool const data  = write || op == Block::Packet_descriptor::READ;
+
+			/* sync and trim requests carry no payload but need a packet */
+			Genode::size_t size = data ? _blk_size * cnt : _blk_size;
 			Packet_descriptor p(_session.dma_alloc_packet(size),
 			                    op,  nr, cnt);
-			Request *r = new (&_r_slab) Request(dispatcher, cli, p);
-			_r_list.insert(r);
+			p.fua(cli.fua());
+			_requests.insert(dispatcher, cli, p);
 
 			if (write)
 				Genode::memcpy(_session.tx()->packet_content(p),
@@ -151,6 +245,11 @@ class Block::Driver
 
 			_session.tx()->submit_packet(p);
 		}
+
+		/**
+		 * Discard outstanding requests of a closed session
+		 */
+		void forget(Block_dispatcher &dispatcher) { _requests.forget(dispatcher); }
 };
 
 #endif /* _PART_BLK__DRIVER_H_ */
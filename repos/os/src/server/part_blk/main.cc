@@ -24,9 +24,18 @@
 
 static Genode::Signal_receiver receiver;
 
+static Genode::size_t _io_buffer_size()
+{
+	Genode::Number_of_bytes size = Block::Driver::DEFAULT_IO_BUFFER_SIZE;
+	try { Genode::config()->xml_node().attribute("io_buffer").value(&size); }
+	catch (...) { }
+	return size;
+}
+
+
 Block::Driver& Block::Driver::driver()
 {
-	static Block::Driver driver(receiver);
+	static Block::Driver driver(receiver, _io_buffer_size());
 	return driver;
 }
 
@@ -20,8 +20,10 @@
 #include <base/exception.h>
 #include <base/heap.h>
 #include <base/log.h>
-#include <block/component.h>
+#include <block/multi_component.h>
 #include <block/driver.h>
+#include <os/periodic_reporter.h>
+#include <os/rpc_stats_reporter.h>
 
 
 using namespace Genode;
@@ -113,9 +115,13 @@ class Ram_blk : public Block::Driver
 			Block::Session::Operations o;
 			o.set_operation(Block::Packet_descriptor::READ);
 			o.set_operation(Block::Packet_descriptor::WRITE);
+			o.set_operation(Block::Packet_descriptor::TRIM);
 			return o;
 		}
 
+		/* data written to RAM is immediately "stable" */
+		bool fua_supported() override { return true; }
+
 		void read(Block::sector_t    block_number,
 		          size_t             block_count,
 		          char*              buffer,
@@ -131,6 +137,23 @@ class Ram_blk : public Block::Driver
 		{
 			_io(block_number, block_count, const_cast<char *>(buffer), packet, false);
 		}
+
+		void trim(Block::sector_t           block_number,
+		          size_t                    block_count,
+		          Block::Packet_descriptor &packet) override
+		{
+			if (block_number + block_count > _block_count) {
+				Genode::warning("requested blocks ", block_number, "-",
+				                block_number + block_count," out of range!");
+				return;
+			}
+
+			/* the backing store cannot be released partially, so zero it */
+			memset((void *)(_ram_addr + (size_t)block_number * _block_size), 0,
+			       block_count * _block_size);
+
+			ack_packet(packet);
+		}
 };
 
 
@@ -194,10 +217,34 @@ struct Main
 			Genode::destroy(&alloc, driver); }
 	} factory { env, heap, config_rom.xml() };
 
-	Block::Root root { env.ep(), &heap, factory };
+	Block::Multi_root root { env, heap, factory, config_rom.xml() };
+
+	bool rpc_stats { false };
+
+	void generate_stats(Xml_generator &xml)
+	{
+		root.generate_stats(xml);
+
+		if (rpc_stats)
+			xml.node("rpc_stats", [&] () {
+				Rpc_stats_reporter::generate(xml); });
+	}
+
+	Periodic_reporter<Main> stats_reporter {
+		env, "ram_blk_stats", *this, &Main::generate_stats, 16*1024 };
 
 	Main(Env &env) : env(env)
 	{
+		stats_reporter.configure(config_rom.xml());
+
+		if (stats_reporter.enabled()) {
+			try {
+				rpc_stats = config_rom.xml().sub_node("report")
+				                            .attribute_value("rpc_stats", false);
+			} catch (...) { }
+			Trace::Rpc_stats::enable(rpc_stats);
+		}
+
 		env.parent().announce(env.ep().manage(root));
 	}
 };
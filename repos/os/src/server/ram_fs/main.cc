@@ -23,6 +23,7 @@
 
 /* local includes */
 #include <ram_fs/directory.h>
+#include <ram_fs/chunk_allocator.h>
 
 
 /*************************
@@ -39,6 +40,8 @@ namespace File_system {
 			Directory            &_root;
 			Node_handle_registry  _handle_registry;
 			bool                  _writable;
+			Allocator            &_chunk_alloc;
+			size_t          const _chunk_size;
 
 			Signal_rpc_member<Session_component> _process_packet_dispatcher;
 
@@ -147,12 +150,15 @@ namespace File_system {
 			 * Constructor
 			 */
 			Session_component(size_t tx_buf_size, Server::Entrypoint &ep,
-			                  Directory &root, bool writable)
+			                  Directory &root, bool writable,
+			                  Allocator &chunk_alloc, size_t chunk_size)
 			:
 				Session_rpc_object(env()->ram_session()->alloc(tx_buf_size), ep.rpc_ep()),
 				_ep(ep),
 				_root(root),
 				_writable(writable),
+				_chunk_alloc(chunk_alloc),
+				_chunk_size(chunk_size),
 				_process_packet_dispatcher(ep, *this, &Session_component::_process_packets)
 			{
 				/*
@@ -200,7 +206,7 @@ namespace File_system {
 
 					try {
 						File * const file = new (env()->heap())
-						                    File(*env()->heap(), name.string());
+						                    File(_chunk_alloc, name.string(), _chunk_size);
 
 						dir->adopt_unsynchronized(file);
 					}
@@ -416,6 +422,7 @@ namespace File_system {
 
 			Server::Entrypoint &_ep;
 			Directory          &_root_dir;
+			Allocator          &_chunk_alloc;
 
 		protected:
 
@@ -428,6 +435,7 @@ namespace File_system {
 
 				Directory *session_root_dir = 0;
 				bool writeable = false;
+				size_t chunk_size = File::DEFAULT_CHUNK_SIZE;
 
 				enum { ROOT_MAX_LEN = 256 };
 				char root[ROOT_MAX_LEN];
@@ -471,6 +479,18 @@ namespace File_system {
 					 */
 					writeable = policy.attribute_value("writeable", false);
 
+					/*
+					 * Determine size of the leaf chunks of files created
+					 * by the session.
+					 */
+					chunk_size = policy.attribute_value("chunk_size",
+					                                    Number_of_bytes(chunk_size));
+					if (!File::valid_chunk_size(chunk_size)) {
+						PERR("Unsupported chunk size %zd in policy definition",
+						     chunk_size);
+						throw Root::Unavailable();
+					}
+
 				} catch (Session_policy::No_policy_defined) {
 					PERR("Invalid session request, no matching policy");
 					throw Root::Unavailable();
@@ -497,7 +517,8 @@ namespace File_system {
 					throw Root::Quota_exceeded();
 				}
 				return new (md_alloc())
-					Session_component(tx_buf_size, _ep, *session_root_dir, writeable);
+					Session_component(tx_buf_size, _ep, *session_root_dir, writeable,
+					                  _chunk_alloc, chunk_size);
 			}
 
 		public:
@@ -507,13 +528,16 @@ namespace File_system {
 			 *
 			 * \param ep        entrypoint
 			 * \param md_alloc  meta-data allocator
-			 * \param root_dir  root-directory handle (anchor for fs)
+			 * \param root_dir     root-directory handle (anchor for fs)
+			 * \param chunk_alloc  allocator for file content
 			 */
-			Root(Server::Entrypoint &ep, Allocator &md_alloc, Directory &root_dir)
+			Root(Server::Entrypoint &ep, Allocator &md_alloc, Directory &root_dir,
+			     Allocator &chunk_alloc)
 			:
 				Root_component<Session_component>(&ep.rpc_ep(), &md_alloc),
 				_ep(ep),
-				_root_dir(root_dir)
+				_root_dir(root_dir),
+				_chunk_alloc(chunk_alloc)
 			{ }
 	};
 
@@ -559,6 +583,7 @@ struct Attribute_string
 
 
 static void preload_content(Genode::Allocator      &alloc,
+                            Genode::Allocator      &chunk_alloc,
                             Genode::Xml_node        node,
                             File_system::Directory &dir)
 {
@@ -581,7 +606,7 @@ static void preload_content(Genode::Allocator      &alloc,
 			Directory *sub_dir = new (&alloc) Directory(name);
 
 			/* traverse into the new directory */
-			preload_content(alloc, sub_node, *sub_dir);
+			preload_content(alloc, chunk_alloc, sub_node, *sub_dir);
 
 			dir.adopt_unsynchronized(sub_dir);
 		}
@@ -597,7 +622,7 @@ static void preload_content(Genode::Allocator      &alloc,
 			/* read file content from ROM module */
 			try {
 				Attached_rom_dataspace rom(name);
-				File *file = new (&alloc) File(alloc, as);
+				File *file = new (&alloc) File(chunk_alloc, as);
 				file->write(rom.local_addr<char>(), rom.size(), 0);
 				dir.adopt_unsynchronized(file);
 			}
@@ -612,7 +637,7 @@ static void preload_content(Genode::Allocator      &alloc,
 		 */
 		if (sub_node.has_type("inline")) {
 
-			File *file = new (&alloc) File(alloc, name);
+			File *file = new (&alloc) File(chunk_alloc, name);
 			file->write(sub_node.content_addr(), sub_node.content_size(), 0);
 			dir.adopt_unsynchronized(file);
 		}
@@ -626,19 +651,24 @@ struct File_system::Main
 
 	Directory root_dir = { "" };
 
+	/*
+	 * Allocator for file content
+	 */
+	Chunk_allocator chunk_alloc = { *env()->heap() };
+
 	/*
 	 * Initialize root interface
 	 */
 	Sliced_heap sliced_heap = { env()->ram_session(), env()->rm_session() };
 
-	Root fs_root = { ep, sliced_heap, root_dir };
+	Root fs_root = { ep, sliced_heap, root_dir, chunk_alloc };
 
 	Main(Server::Entrypoint &ep) : ep(ep)
 	{
 		/* preload RAM file system with content as declared in the config */
 		try {
 			Xml_node content = config()->xml_node().sub_node("content");
-			preload_content(*env()->heap(), content, root_dir); }
+			preload_content(*env()->heap(), chunk_alloc, content, root_dir); }
 		catch (Xml_node::Nonexistent_sub_node) { }
 
 		env()->parent()->announce(ep.manage(fs_root));
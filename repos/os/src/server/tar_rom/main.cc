@@ -22,9 +22,32 @@
 #include <base/env.h>
 #include <base/printf.h>
 #include <os/config.h>
+#include <os/compressed_archive.h>
 #include <base/session_label.h>
 
 
+/**
+ * Access to the content of the TAR archive, which may be stored compressed
+ */
+struct Archive
+{
+	char const                 *base;
+	Genode::size_t              size;
+	Genode::Compressed_archive *compressed;
+
+	void read(Genode::size_t offset, char *dst, Genode::size_t len)
+	{
+		if (compressed) {
+			compressed->read(offset, dst, len);
+			return;
+		}
+
+		if (offset >= size) return;
+		Genode::memcpy(dst, base + offset, Genode::min(len, size - offset));
+	}
+};
+
+
 /**
  * A 'Rom_session_component' exports a single file of the tar archive
  */
@@ -32,8 +55,9 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 {
 	private:
 
-		const char *_tar_addr, *_filename, *_file_addr;
-		Genode::size_t _file_size, _tar_size;
+		Archive        &_archive;
+		const char     *_filename;
+		Genode::size_t  _file_offset, _file_size, _tar_size;
 		Genode::Ram_dataspace_capability _file_ds;
 
 		enum {
@@ -60,7 +84,11 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 			/* copy content */
 			size_t dst_ds_size   = Dataspace_client(dst).size();
 			size_t bytes_to_copy = min(_file_size, dst_ds_size);
-			memcpy(dst_addr, _file_addr, bytes_to_copy);
+			try { _archive.read(_file_offset, dst_addr, bytes_to_copy); }
+			catch (...) {
+				env()->rm_session()->detach(dst_addr);
+				throw;
+			}
 
 			/* unmap dataspace */
 			env()->rm_session()->detach(dst_addr);
@@ -79,12 +107,20 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 			/* scan metablocks of archive */
 			while (block_id < block_cnt) {
 
+				/* copy metablock, which may be stored in compressed form */
+				char metablock[_BLOCK_LEN + 1];
+				try { _archive.read(block_id*_BLOCK_LEN, metablock, _BLOCK_LEN); }
+				catch (Genode::Compressed_archive::Invalid_archive) {
+					PERR("corrupt metablock in compressed archive");
+					break;
+				}
+				metablock[_BLOCK_LEN] = 0;
+
 				unsigned long file_size = 0;
-				Genode::ascii_to_unsigned(_tar_addr + block_id*_BLOCK_LEN +
-				                          _FIELD_SIZE_LEN, file_size, 8);
+				Genode::ascii_to_unsigned(metablock + _FIELD_SIZE_LEN, file_size, 8);
 
 				/* get name of tar record */
-				char const *record_filename = _tar_addr + block_id*_BLOCK_LEN;
+				char const *record_filename = metablock;
 
 				/* skip leading dot of path if present */
 				if (record_filename[0] == '.' && record_filename[1] == '/')
@@ -92,8 +128,8 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 
 				/* get infos about current file */
 				if (Genode::strcmp(_filename, record_filename) == 0) {
-					_file_size = file_size;
-					_file_addr = _tar_addr + (block_id+1) * _BLOCK_LEN;
+					_file_size   = file_size;
+					_file_offset = (block_id+1) * _BLOCK_LEN;
 					file_found = true;
 					break;
 				}
@@ -109,9 +145,11 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 					break;
 
 				/* lookout for empty eof-blocks */
-				if (*(_tar_addr + (block_id*_BLOCK_LEN)) == 0x00)
-					if (*(_tar_addr + (block_id*_BLOCK_LEN + 1)) == 0x00)
-						break;
+				char eof_marker[2];
+				try { _archive.read(block_id*_BLOCK_LEN, eof_marker, sizeof(eof_marker)); }
+				catch (Genode::Compressed_archive::Invalid_archive) { break; }
+				if (eof_marker[0] == 0x00 && eof_marker[1] == 0x00)
+					break;
 			}
 
 			if (!file_found) {
@@ -126,6 +164,10 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 
 				/* get content of file copied into dataspace and return */
 				_copy_content_to_dataspace(file_ds);
+			} catch (Genode::Compressed_archive::Invalid_archive) {
+				PERR("corrupt content of file '%s', empty result", _filename);
+				Genode::env()->ram_session()->free(file_ds);
+				return Genode::Ram_dataspace_capability();
 			} catch (...) {
 				PERR("couldn't allocate memory for file, empty result\n");
 				return file_ds;
@@ -139,15 +181,13 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 		/**
 		 * Constructor scans and seeks to file
 		 *
-		 * \param  tar_addr  local address to tar archive
-		 * \param  tar_size  size of tar archive in bytes
+		 * \param  archive   tar archive
 		 * \param  filename  name of the requested file
 		 */
-		Rom_session_component(const char *tar_addr, unsigned tar_size,
-		                      const char *filename)
+		Rom_session_component(Archive &archive, const char *filename)
 		:
-			_tar_addr(tar_addr), _filename(filename), _file_addr(0), _file_size(0),
-			_tar_size(tar_size),
+			_archive(archive), _filename(filename), _file_offset(0), _file_size(0),
+			_tar_size(archive.compressed ? archive.compressed->size() : archive.size),
 			_file_ds(_init_file_ds())
 		{
 			if (!_file_ds.valid())
@@ -176,8 +216,7 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 {
 	private:
 
-		char    *_tar_addr;
-		unsigned _tar_size;
+		Archive &_archive;
 
 		Rom_session_component *_create_session(const char *args)
 		{
@@ -189,7 +228,7 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 			PINF("connection for module '%s' requested", module_name.string());
 
 			/* create new session for the requested file */
-			return new (md_alloc()) Rom_session_component(_tar_addr, _tar_size,
+			return new (md_alloc()) Rom_session_component(_archive,
 			                                              module_name.string());
 		}
 
@@ -200,15 +239,14 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 		 *
 		 * \param  entrypoint  entrypoint to be used for ROM sessions
 		 * \param  md_alloc    meta-data allocator used for ROM sessions
-		 * \param  tar_base    local address of tar archive
-		 * \param  tar_size    size of tar archive in bytes
+		 * \param  archive     tar archive
 		 */
 		Rom_root(Genode::Rpc_entrypoint *entrypoint,
 		         Genode::Allocator      *md_alloc,
-		         char *tar_addr, Genode::size_t tar_size)
+		         Archive                &archive)
 		:
 			Genode::Root_component<Rom_session_component>(entrypoint, md_alloc),
-			_tar_addr(tar_addr), _tar_size(tar_size)
+			_archive(archive)
 		{ }
 };
 
@@ -243,6 +281,36 @@ int main(void)
 
 	PINF("using tar archive '%s' with size %zd", tar_filename, tar_size);
 
+	static Archive archive { tar_base, tar_size, nullptr };
+
+	/*
+	 * Block-compressed archives are decompressed lazily. The amount of
+	 * memory used for caching decompressed blocks and the number of
+	 * decompression threads are configurable via the 'cache' and 'threads'
+	 * attributes of the 'archive' node.
+	 */
+	if (Compressed_archive::probe(tar_base, tar_size)) {
+
+		Xml_node archive_node = config()->xml_node().sub_node("archive");
+
+		size_t const cache_size =
+			archive_node.attribute_value("cache", Number_of_bytes(1024*1024));
+		unsigned const threads =
+			archive_node.attribute_value("threads", 0U);
+
+		try {
+			archive.compressed = new (env()->heap())
+				Compressed_archive(*env()->heap(), tar_base, tar_size,
+				                   cache_size, threads);
+		} catch (Compressed_archive::Invalid_archive) {
+			PERR("compressed tar archive is corrupt");
+			return -3;
+		}
+
+		PINF("archive is compressed, uncompressed size is %zd",
+		     archive.compressed->size());
+	}
+
 	/* connection to capability service needed to create capabilities */
 	static Cap_connection cap;
 
@@ -252,7 +320,7 @@ int main(void)
 
 	enum { STACK_SIZE = 8*1024 };
 	static Rpc_entrypoint ep(&cap, STACK_SIZE, "tar_rom_ep");
-	static Rom_root rom_root(&ep, &sliced_heap, tar_base, tar_size);
+	static Rom_root rom_root(&ep, &sliced_heap, archive);
 
 	/* announce server*/
 	env()->parent()->announce(ep.manage(&rom_root));
@@ -17,6 +17,7 @@
 #include <base/allocator.h>
 #include <base/lock.h>
 #include <base/trace/types.h>
+#include <base/trace/buffer.h>
 
 #include <directory.h>
 #include <trace_files.h>
@@ -41,37 +42,48 @@ namespace Trace_fs {
 
 					struct Process_entry
 					{
-						virtual size_t operator()(Genode::Trace::Buffer::Entry&) = 0;
+						virtual size_t operator()(char const *data, size_t len) = 0;
 					};
 
 				private:
 
-					Genode::Trace::Buffer       *buffer;
-					Genode::Trace::Buffer::Entry current_entry;
+					enum { MAX_ENTRY_LEN = 512 };
+
+					Genode::Trace::Buffer        *buffer;
+					Genode::Trace::Buffer::Cursor cursor;
+
+					char entry_buf[MAX_ENTRY_LEN];
 
 
 				public:
 
 				Trace_buffer_manager(Genode::Dataspace_capability ds_cap)
 				:
-					buffer(Genode::env()->rm_session()->attach(ds_cap)),
-					current_entry(buffer->first())
+					buffer(Genode::env()->rm_session()->attach(ds_cap))
 				{ }
 
-				size_t dump_entry(Process_entry &process)
+				/**
+				 * Process next entry of the trace buffer
+				 *
+				 * \param len  length of the processed entry
+				 *
+				 * \return false if no new entry is available
+				 */
+				bool dump_entry(Process_entry &process, size_t &len)
 				{
-					size_t len = process(current_entry);
+					Genode::Trace::Buffer::Entry_info info;
+					if (!buffer->read(cursor, info, entry_buf, sizeof(entry_buf)))
+						return false;
 
-					current_entry = buffer->next(current_entry);
-					return len;
-				}
-
-				bool last_entry() const
-				{
-					return current_entry.last();
+					len = process(entry_buf, Genode::min(info.length,
+					                                     sizeof(entry_buf)));
+					return true;
 				}
 
-				void rewind() { current_entry = buffer->first(); }
+				/**
+				 * Return number of entries overwritten before being read
+				 */
+				unsigned long lost() const { return cursor.lost; }
 			};
 
 
@@ -211,16 +211,17 @@ class Trace_file_system
 				char const *data() const { return _buf; }
 
 				/**
-				 * Functor for processing a Trace:Buffer::Entry
+				 * Functor for processing a Trace:Buffer entry
 				 *
-				 * \param entry reference of Trace::Buffer::Entry
+				 * \param data    entry data
+				 * \param length  length of entry data
 				 *
-				 * \return length of processed Trace::Buffer::Entry
+				 * \return length of processed Trace::Buffer entry
 				 */
-				Genode::size_t operator()(Genode::Trace::Buffer::Entry &entry)
+				Genode::size_t operator()(char const *data, Genode::size_t length)
 				{
-					Genode::size_t len = Genode::min(entry.length() + 1, CAPACITY);
-					Genode::memcpy(_buf, entry.data(), len);
+					Genode::size_t len = Genode::min(length + 1, CAPACITY);
+					Genode::memcpy(_buf, data, len);
 					_buf[len - 1] = '\n';
 
 					_length = len;
@@ -265,8 +266,10 @@ class Trace_file_system
 
 			Process_entry<512> process_entry;
 
-			while (!manager->last_entry()) {
-				size_t len = manager->dump_entry(process_entry);
+			unsigned long const lost = manager->lost();
+
+			size_t len = 0;
+			while (manager->dump_entry(process_entry, len)) {
 
 				if (len == 0)
 					continue;
@@ -275,8 +278,13 @@ class Trace_file_system
 				catch (...) { PERR("could not write entry"); }
 			}
 
-			if (manager->last_entry()) {
-				manager->rewind();
+			/* note entries that were overwritten before we could read them */
+			if (manager->lost() != lost) {
+				char buf[64];
+				int const n = Genode::snprintf(buf, sizeof(buf), "[%lu events lost]\n",
+				                               manager->lost() - lost);
+				try { subject->events_file.append(buf, n); }
+				catch (...) { PERR("could not write entry"); }
 			}
 		}
 
@@ -360,6 +360,113 @@ struct Violation_test : Test
 };
 
 
+/**
+ * Test of the packet-based trim, FUA-write and sync operations
+ *
+ * The content of the tested blocks is read first and written back with the
+ * FUA flag set after trimming the blocks. The sync packet submitted
+ * thereafter must not be acknowledged before all writes.
+ */
+struct Sync_test : Test
+{
+	struct Ordering_violated : Exception {
+		void print_error() { PINF("sync acknowledged before preceding writes!"); } };
+
+	enum { NR_BLOCKS = 16 };
+
+	Block::Packet_descriptor content;
+
+	bool     read_done    = false;
+	bool     trim_done    = false;
+	bool     sync_done    = false;
+	unsigned writes_acked = 0;
+
+	Sync_test(unsigned timeo_ms)
+	: Test(Block::Session::TX_QUEUE_SIZE*blk_sz, timeo_ms) { }
+
+	Block::Packet_descriptor submit(Block::Packet_descriptor::Opcode op,
+	                                Block::sector_t nr, Genode::size_t cnt)
+	{
+		Genode::size_t const size = op == Block::Packet_descriptor::READ
+		                          ? cnt*blk_sz : blk_sz;
+
+		Block::Packet_descriptor p(_session.dma_alloc_packet(size), op, nr, cnt);
+		p.fua(op == Block::Packet_descriptor::WRITE);
+		return p;
+	}
+
+	void perform()
+	{
+		using Block::Packet_descriptor;
+
+		if (!blk_ops.supported(Packet_descriptor::WRITE)
+		 || !blk_ops.supported(Packet_descriptor::SYNC)
+		 || test_cnt < NR_BLOCKS)
+			return;
+
+		PINF("trim/FUA-write/sync block 0 - %u", NR_BLOCKS - 1);
+
+		_session.tx()->submit_packet(submit(Packet_descriptor::READ, 0, NR_BLOCKS));
+		while (!read_done)
+			_handle_signal();
+
+		if (blk_ops.supported(Packet_descriptor::TRIM)) {
+			_session.tx()->submit_packet(submit(Packet_descriptor::TRIM, 0, NR_BLOCKS));
+			while (!trim_done)
+				_handle_signal();
+		}
+
+		for (unsigned i = 0; i < NR_BLOCKS; i++) {
+			Packet_descriptor w = submit(Packet_descriptor::WRITE, i, 1);
+			Genode::memcpy(_session.tx()->packet_content(w),
+			               _session.tx()->packet_content(content) + i*blk_sz,
+			               blk_sz);
+			_session.tx()->submit_packet(w);
+		}
+		_session.tx()->submit_packet(submit(Packet_descriptor::SYNC, 0, 0));
+
+		while (!sync_done)
+			_handle_signal();
+
+		_session.tx()->release_packet(content);
+	}
+
+	void ack_avail()
+	{
+		 _handle = false;
+
+		while (_session.tx()->ack_avail()) {
+			Block::Packet_descriptor p = _session.tx()->get_acked_packet();
+
+			bool const read = p.operation() == Block::Packet_descriptor::READ;
+			if (!p.succeeded())
+				throw Block_exception(p.block_number(), p.block_count(), !read);
+
+			switch (p.operation()) {
+			case Block::Packet_descriptor::READ:
+				content   = p;
+				read_done = true;
+				continue;
+			case Block::Packet_descriptor::TRIM:
+				trim_done = true;
+				break;
+			case Block::Packet_descriptor::WRITE:
+				writes_acked++;
+				break;
+			case Block::Packet_descriptor::SYNC:
+				if (writes_acked != NR_BLOCKS)
+					throw Ordering_violated();
+				sync_done = true;
+				break;
+			default:
+				break;
+			}
+			_session.tx()->release_packet(p);
+		}
+	}
+};
+
+
 template <typename TEST>
 void perform(unsigned timeo_ms = 0)
 {
@@ -400,6 +507,7 @@ int main()
 		perform<Read_test<Block::Session::TX_QUEUE_SIZE*5, 1> >();
 		perform<Read_test<Block::Session::TX_QUEUE_SIZE, 1> >();
 		perform<Write_test<Block::Session::TX_QUEUE_SIZE, 8, 16> >();
+		perform<Sync_test>();
 		perform<Violation_test>(1000);
 
 		PINF("Tests finished successfully!");
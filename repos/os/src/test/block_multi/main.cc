@@ -0,0 +1,264 @@
+/*
+ * \brief  Test of the request scheduling of the multi-session block root
+ * \author Genode Labs
+ * \date   2016-07-22
+ *
+ * The test opens the sessions "heavy", "light", and "limited" at the block
+ * server and keeps their request queues filled for 'DURATION_MS'. The
+ * server is configured to weight "heavy" four times as much as "light" and
+ * to limit "limited" to 'IOPS_LIMIT' requests per second. The deadline of
+ * "limited" is shorter than the interval imposed by the limit, so its
+ * requests miss their deadline but must not bypass the limit. Once all
+ * requests are completed, the test evaluates the statistics report of the
+ * server.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/snprintf.h>
+#include <block_session/connection.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Client;
+	struct Main;
+}
+
+
+/**
+ * Client that keeps its request queue filled
+ */
+struct Test::Client
+{
+	enum {
+		REQUEST_BLOCKS = 8,
+		TX_BUF_SIZE    = 128*1024,
+	};
+
+	char const * const name;
+
+	Allocator_avl     alloc;
+	Block::Connection session;
+
+	Signal_handler<Client> handler;
+
+	size_t          block_size  = 0;
+	Block::sector_t block_count = 0;
+	Block::sector_t current     = 0;
+
+	bool          stopped   = false;
+	unsigned      in_flight = 0;
+	unsigned long completed = 0;
+	unsigned long failed    = 0;
+
+	void submit()
+	{
+		Block::Session::Tx::Source &tx = *session.tx();
+
+		while (!stopped && tx.ready_to_submit()) {
+
+			Block::Packet_descriptor p;
+			try {
+				p = Block::Packet_descriptor(
+					tx.alloc_packet(REQUEST_BLOCKS*block_size),
+					Block::Packet_descriptor::READ, current, REQUEST_BLOCKS);
+			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+				return;
+			}
+
+			tx.submit_packet(p);
+			in_flight++;
+
+			current += REQUEST_BLOCKS;
+			if (current + REQUEST_BLOCKS > block_count)
+				current = 0;
+		}
+	}
+
+	void handle_signal()
+	{
+		Block::Session::Tx::Source &tx = *session.tx();
+
+		while (tx.ack_avail()) {
+			Block::Packet_descriptor const p = tx.get_acked_packet();
+
+			if (!p.succeeded())
+				failed++;
+
+			tx.release_packet(p);
+			in_flight--;
+			completed++;
+		}
+
+		submit();
+	}
+
+	Client(Env &env, Allocator &heap, char const *name)
+	:
+		name(name), alloc(&heap), session(env, &alloc, TX_BUF_SIZE, name),
+		handler(env.ep(), *this, &Client::handle_signal)
+	{
+		session.tx_channel()->sigh_ack_avail(handler);
+		session.tx_channel()->sigh_ready_to_submit(handler);
+
+		Block::Session::Operations ops;
+		session.info(&block_count, &block_size, &ops);
+	}
+
+	void stop() { stopped = true; }
+
+	bool idle() const { return stopped && !in_flight; }
+};
+
+
+struct Test::Main
+{
+	enum {
+		DURATION_MS = 5000,
+		WEIGHT      = 4,   /* weight of "heavy" relative to "light" */
+		IOPS_LIMIT  = 50,  /* limit of "limited" */
+
+		/* time to wait for a report after all requests completed */
+		REPORT_WAIT_MS = 1500,
+	};
+
+	Env  &env;
+	Heap  heap { env.ram(), env.rm() };
+
+	Timer::Connection timer { env };
+
+	Client heavy   { env, heap, "heavy"   };
+	Client light   { env, heap, "light"   };
+	Client limited { env, heap, "limited" };
+
+	enum Phase { RUNNING, DRAINING, REPORTING } phase = RUNNING;
+
+	Signal_handler<Main> timeout_handler { env.ep(), *this, &Main::handle_timeout };
+
+	/**
+	 * Return counter 'attr' of the session of 'client' in the report
+	 */
+	static unsigned long reported(Xml_node report, Client const &client,
+	                              char const *attr)
+	{
+		char label[64];
+		snprintf(label, sizeof(label), "test-block_multi -> %s", client.name);
+
+		unsigned long result = 0;
+		report.for_each_sub_node("session", [&] (Xml_node session) {
+			if (session.attribute("label").has_value(label))
+				result = session.attribute_value(attr, 0UL); });
+
+		return result;
+	}
+
+	bool evaluate()
+	{
+		Attached_rom_dataspace report(env, "ram_blk_stats");
+
+		bool ok = true;
+
+		Client const * const clients[] = { &heavy, &light, &limited };
+		for (Client const *c : clients) {
+
+			unsigned long const requests = reported(report.xml(), *c, "requests");
+
+			log(c->name, ": ", c->completed, " requests completed, ",
+			    requests, " reported");
+
+			if (!c->completed || c->failed || requests != c->completed) {
+				error("unexpected request count of session '", c->name, "'");
+				ok = false;
+			}
+		}
+
+		/* the share of "heavy" must roughly correspond to its weight */
+		if (heavy.completed*3 < light.completed*WEIGHT*2
+		 || heavy.completed*2 > light.completed*WEIGHT*3) {
+			error("share of 'heavy' does not match its weight");
+			ok = false;
+		}
+
+		/* the IOPS limit admits a burst of a tenth of the limit */
+		unsigned long const max_limited =
+			IOPS_LIMIT*DURATION_MS/1000 + IOPS_LIMIT/10 + IOPS_LIMIT/5;
+
+		if (limited.completed > max_limited) {
+			error("'limited' exceeded its IOPS limit");
+			ok = false;
+		}
+
+		if (!reported(report.xml(), limited, "deadline_misses")) {
+			error("'limited' reported no deadline misses");
+			ok = false;
+		}
+
+		return ok;
+	}
+
+	void handle_timeout()
+	{
+		switch (phase) {
+
+		case RUNNING:
+			heavy.stop(); light.stop(); limited.stop();
+			phase = DRAINING;
+			timer.trigger_once(10*1000);
+			return;
+
+		case DRAINING:
+			if (!heavy.idle() || !light.idle() || !limited.idle()) {
+				timer.trigger_once(10*1000);
+				return;
+			}
+			phase = REPORTING;
+			timer.trigger_once(REPORT_WAIT_MS*1000);
+			return;
+
+		case REPORTING:
+			{
+				bool const ok = evaluate();
+				log("--- test-block_multi ", ok ? "finished" : "failed", " ---");
+				env.parent().exit(ok ? 0 : -1);
+			}
+			return;
+		}
+	}
+
+	Main(Env &env) : env(env)
+	{
+		log("--- test-block_multi started ---");
+
+		timer.sigh(timeout_handler);
+		timer.trigger_once(DURATION_MS*1000);
+
+		heavy.submit();
+		light.submit();
+		limited.submit();
+	}
+};
+
+
+/***************
+ ** Component **
+ ***************/
+
+namespace Component {
+
+	Genode::size_t stack_size()      { return 4*1024*sizeof(long); }
+	void construct(Genode::Env &env) { static Test::Main main(env); }
+}
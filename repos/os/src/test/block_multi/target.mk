@@ -0,0 +1,3 @@
+TARGET = test-block_multi
+SRC_CC = main.cc
+LIBS   = base
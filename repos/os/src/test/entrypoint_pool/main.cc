@@ -0,0 +1,144 @@
+/*
+ * \brief  Test for distributing RPC objects and signals among entrypoints
+ * \author Genode Labs
+ * \date   2016-07-01
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/rpc_client.h>
+#include <base/semaphore.h>
+#include <os/entrypoint_pool.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Thread_id;
+	struct Thread_id_component;
+	struct Main;
+}
+
+
+/**
+ * RPC interface that reveals the thread serving the object
+ */
+struct Test::Thread_id
+{
+	GENODE_RPC(Rpc_thread, unsigned long, thread);
+	GENODE_RPC_INTERFACE(Rpc_thread);
+};
+
+
+struct Test::Thread_id_component : Rpc_object<Thread_id, Thread_id_component>
+{
+	unsigned long thread() { return (unsigned long)Thread::myself(); }
+};
+
+
+struct Test::Main
+{
+	enum { NUM_EPS = 4, NUM_OBJECTS = 3*NUM_EPS };
+	enum { STACK_SIZE = 2*1024*sizeof(long) };
+
+	Env &env;
+
+	Entrypoint_pool pool { env, NUM_EPS, STACK_SIZE, "pool_ep" };
+
+	Thread_id_component objects[NUM_OBJECTS];
+	Thread_id_component pinned;
+
+	Semaphore     signal_handled;
+	unsigned long signal_thread = 0;
+
+	void handle_signal()
+	{
+		signal_thread = (unsigned long)Thread::myself();
+		signal_handled.up();
+	}
+
+	Signal_handler<Main> signal_handler { pool.ep(1), *this,
+	                                      &Main::handle_signal };
+
+	static unsigned long thread_of(Capability<Thread_id> cap) {
+		return cap.call<Thread_id::Rpc_thread>(); }
+
+	Main(Env &env);
+};
+
+
+Test::Main::Main(Env &env) : env(env)
+{
+	log("--- entrypoint-pool test ---");
+
+	if (pool.count() != NUM_EPS) {
+		error("unexpected number of entrypoints ", pool.count());
+		throw -1;
+	}
+
+	/* distribute objects round robin, pin one object to the last entrypoint */
+	Capability<Thread_id> caps[NUM_OBJECTS];
+	for (unsigned i = 0; i < NUM_OBJECTS; i++)
+		caps[i] = pool.manage(objects[i]);
+
+	Capability<Thread_id> pinned_cap = pool.manage(pinned, NUM_EPS - 1);
+
+	/* each object is served by the same thread for all requests */
+	unsigned long threads[NUM_OBJECTS];
+	for (unsigned i = 0; i < NUM_OBJECTS; i++) {
+		threads[i] = thread_of(caps[i]);
+
+		if (thread_of(caps[i]) != threads[i]) {
+			error("object ", i, " is served by different threads");
+			throw -2;
+		}
+	}
+
+	/* objects are spread over all entrypoints */
+	for (unsigned i = 0; i < NUM_OBJECTS; i++) {
+		for (unsigned j = 0; j < NUM_OBJECTS; j++) {
+
+			bool const same_ep = (i % NUM_EPS) == (j % NUM_EPS);
+
+			if (same_ep != (threads[i] == threads[j])) {
+				error("unexpected distribution of objects ", i, " and ", j);
+				throw -3;
+			}
+		}
+	}
+	log("objects distributed among ", (unsigned)NUM_EPS, " entrypoints");
+
+	if (thread_of(pinned_cap) != threads[NUM_EPS - 1]) {
+		error("pinned object is served by wrong entrypoint");
+		throw -4;
+	}
+	log("pinned object served by entrypoint ", (unsigned)NUM_EPS - 1);
+
+	/* signals are dispatched by the entrypoint of the signal handler */
+	Signal_transmitter(signal_handler).submit();
+	signal_handled.down();
+
+	if (signal_thread != threads[1]) {
+		error("signal handled by wrong entrypoint");
+		throw -5;
+	}
+	log("signal handled by entrypoint 1");
+
+	for (unsigned i = 0; i < NUM_OBJECTS; i++)
+		pool.dissolve(objects[i]);
+	pool.dissolve(pinned);
+
+	log("--- entrypoint-pool test finished ---");
+	env.parent().exit(0);
+}
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -16,6 +16,7 @@
 #include <base/printf.h>
 #include <os/attached_dataspace.h>
 #include <blit/blit.h>
+#include <blit/painter.h>
 #include <framebuffer_session/connection.h>
 #include <timer_session/connection.h>
 
@@ -27,6 +28,68 @@ static unsigned long now_ms()
 }
 
 
+/**
+ * Repeatedly execute 'fn' for 'duration_ms' and print the pixel throughput
+ *
+ * \param fn  functor that processes 'pixels' pixels per call
+ */
+template <typename FN>
+static void measure(char const *kernel, char const *op,
+                    unsigned long pixels, unsigned long duration_ms, FN const &fn)
+{
+	unsigned long long processed = 0;
+	unsigned long const start_ms = now_ms();
+
+	for (; now_ms() - start_ms < duration_ms; processed += pixels)
+		fn();
+
+	unsigned long const end_ms = now_ms();
+
+	Genode::printf("%s %s -> %llu MPixel/sec\n", kernel, op,
+	               processed/((end_ms - start_ms)*1000));
+}
+
+
+/**
+ * Measure the pixel kernels of the blit library for the pixel type 'PT'
+ */
+template <typename PT>
+static void measure_kernels(Framebuffer::Mode const mode, PT *fb,
+                            PT const *src, unsigned char const *alpha,
+                            unsigned long duration_ms)
+{
+	int           const w = mode.width();
+	int           const h = mode.height();
+	unsigned long const n = w*h;
+
+	PT const color(0x40, 0x80, 0xc0);
+
+	for (unsigned i = 0; Blit::kernels(i); i++) {
+
+		Blit::Kernels const &k = *Blit::kernels(i);
+
+		measure(k.name, "copy ", n, duration_ms, [&] () {
+			k.copy(src, w*sizeof(PT), fb, w*sizeof(PT), w*sizeof(PT), h); });
+
+		if (sizeof(PT) == 2) {
+			measure(k.name, "fill ", n, duration_ms, [&] () {
+				k.fill_16bit(fb, w, color.pixel, w, h); });
+			measure(k.name, "mix  ", n, duration_ms, [&] () {
+				k.mix_rgb565(fb, w, color.pixel, 100, w, h); });
+			measure(k.name, "blend", n, duration_ms, [&] () {
+				k.blend_rgb565(src, w, alpha, fb, w, w, h); });
+		} else {
+			measure(k.name, "fill ", n, duration_ms, [&] () {
+				k.fill_32bit(fb, w, color.pixel, w, h); });
+			measure(k.name, "mix  ", n, duration_ms, [&] () {
+				k.mix_xrgb8888(fb, w, color.pixel, 100, w, h); });
+			measure(k.name, "blend", n, duration_ms, [&] () {
+				k.blend_xrgb8888(src, w, alpha, fb, w, w, h); });
+		}
+	}
+}
+
+
 int main(int argc, char **argv)
 {
 	using namespace Genode;
@@ -133,6 +196,34 @@ int main(int argc, char **argv)
 		       (transferred_kib)/(end_ms - start_ms));
 	}
 
+	/*
+	 * Pixel kernels of the blit library, the alpha values cover the range
+	 * from fully transparent to opaque
+	 */
+	printf("pixel kernels of blit library from RAM to framebuffer...\n");
+	{
+		unsigned long const num_pixels = fb_mode.width()*fb_mode.height();
+
+		unsigned char *alpha = (unsigned char *)env()->heap()->alloc(num_pixels);
+		for (unsigned long i = 0; i < num_pixels; i++)
+			alpha[i] = i;
+
+		switch (fb_mode.format()) {
+		case Framebuffer::Mode::RGB565:
+			measure_kernels(fb_mode, fb_ds.local_addr<Pixel_rgb565>(),
+			                (Pixel_rgb565 const *)src_buf[0], alpha, duration_ms);
+			break;
+		case Framebuffer::Mode::XRGB8888:
+			measure_kernels(fb_mode, fb_ds.local_addr<Pixel_rgb888>(),
+			                (Pixel_rgb888 const *)src_buf[0], alpha, duration_ms);
+			break;
+		default:
+			printf("unsupported pixel format\n");
+		}
+
+		env()->heap()->free(alpha, num_pixels);
+	}
+
 	printf("--- test-fb_bench finished ---\n");
 	return 0;
 }
@@ -0,0 +1,192 @@
+/*
+ * \brief  Throughput benchmark for the forwarding between NIC-bridge clients
+ * \author Genode Labs
+ * \date   2016-07-05
+ *
+ * The benchmark opens two NIC sessions at the bridge and streams ethernet
+ * frames from the first to the second session, addressed to the MAC address
+ * of the second session. The bridge thereby forwards each frame from one
+ * client to the other, without involving the uplink.
+ *
+ * The sender is not paced, and the bridge drops frames that cannot be
+ * delivered. Hence, the benchmark ends once all frames are sent and no
+ * frame was received for 'IDLE_MS', and it reports the number of frames
+ * that got lost.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <nic/packet_allocator.h>
+#include <nic_session/connection.h>
+#include <timer_session/connection.h>
+#include <util/string.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Endpoint;
+	struct Main;
+}
+
+
+/**
+ * Client of the NIC bridge
+ */
+struct Test::Endpoint
+{
+	enum { BUF_SIZE = Nic::Packet_allocator::DEFAULT_PACKET_SIZE * 128 };
+
+	Nic::Packet_allocator alloc;
+	Nic::Connection       nic;
+
+	Endpoint(Env &env, Allocator &heap, char const *label)
+	:
+		alloc(&heap), nic(env, &alloc, BUF_SIZE, BUF_SIZE, label)
+	{ }
+};
+
+
+struct Test::Main
+{
+	enum { NUM_PACKETS = 100000, PACKET_SIZE = 1024 };
+	enum { IDLE_MS = 500, IDLE_CHECK_MS = 100 };
+
+	/* experimental ethertype, not interpreted by the bridge */
+	enum { ETHERTYPE = 0x88b5 };
+
+	Env  &env;
+	Heap  heap { env.ram(), env.rm() };
+
+	Timer::Connection timer { env };
+
+	Endpoint sender   { env, heap, "sender" };
+	Endpoint receiver { env, heap, "receiver" };
+
+	unsigned      sent       = 0;
+	unsigned      received   = 0;
+	unsigned long start_ms   = 0;
+	unsigned long last_rx_ms = 0;
+	bool          idle_check = false;
+	bool          finished   = false;
+
+	Signal_handler<Main> tx_handler   { env.ep(), *this, &Main::handle_tx };
+	Signal_handler<Main> rx_handler   { env.ep(), *this, &Main::handle_rx };
+	Signal_handler<Main> idle_handler { env.ep(), *this, &Main::handle_idle };
+
+	void finish()
+	{
+		if (finished)
+			return;
+
+		finished = true;
+
+		unsigned long const ms = max(last_rx_ms - start_ms, 1UL);
+
+		log("sent ", sent, " packets of ", (unsigned)PACKET_SIZE, " bytes, "
+		    "received ", received, ", dropped ", sent - received);
+		log("forwarded ", received, " packets in ", ms, " ms");
+		log("throughput: ", received*1000UL/ms, " packets/s, ",
+		    (unsigned long long)received*PACKET_SIZE*8/1000/ms,
+		    " Mbit/s");
+		log("--- nic_bridge benchmark finished ---");
+
+		env.parent().exit(0);
+	}
+
+	/**
+	 * Finish once all frames are sent and the receiver became idle
+	 */
+	void handle_idle()
+	{
+		if (timer.elapsed_ms() - last_rx_ms >= IDLE_MS)
+			finish();
+	}
+
+	/**
+	 * Submit as many frames as possible as one batch
+	 */
+	void handle_tx()
+	{
+		Nic::Session::Tx::Source &tx = *sender.nic.tx();
+
+		while (tx.ack_avail())
+			tx.release_packet(tx.get_acked_packet());
+
+		Nic::Mac_address const src = sender.nic.mac_address();
+		Nic::Mac_address const dst = receiver.nic.mac_address();
+
+		while (sent < NUM_PACKETS && tx.ready_to_submit()) {
+
+			Packet_descriptor packet;
+			try { packet = tx.alloc_packet(PACKET_SIZE); }
+			catch (Nic::Session::Tx::Source::Packet_alloc_failed) { break; }
+
+			unsigned char *frame = (unsigned char *)tx.packet_content(packet);
+			memcpy(frame,     dst.addr, sizeof(dst.addr));
+			memcpy(frame + 6, src.addr, sizeof(src.addr));
+			frame[12] = ETHERTYPE >> 8;
+			frame[13] = ETHERTYPE & 0xff;
+
+			tx.submit_packet(packet);
+			sent++;
+		}
+
+		if (sent == NUM_PACKETS && !idle_check) {
+			idle_check = true;
+			timer.sigh(idle_handler);
+			timer.trigger_periodic(IDLE_CHECK_MS*1000);
+		}
+	}
+
+	void handle_rx()
+	{
+		Nic::Session::Rx::Sink &rx = *receiver.nic.rx();
+
+		unsigned const received_before = received;
+
+		while (rx.packet_avail() && rx.ready_to_ack()) {
+			rx.acknowledge_packet(rx.get_packet());
+			received++;
+		}
+
+		if (received != received_before)
+			last_rx_ms = timer.elapsed_ms();
+
+		if (received == NUM_PACKETS)
+			finish();
+	}
+
+	Main(Env &env) : env(env)
+	{
+		log("--- nic_bridge benchmark ---");
+
+		sender.nic.tx_channel()->sigh_ack_avail(tx_handler);
+		sender.nic.tx_channel()->sigh_ready_to_submit(tx_handler);
+		receiver.nic.rx_channel()->sigh_packet_avail(rx_handler);
+		receiver.nic.rx_channel()->sigh_ready_to_ack(rx_handler);
+
+		start_ms = last_rx_ms = timer.elapsed_ms();
+		handle_tx();
+	}
+};
+
+
+/***************
+ ** Component **
+ ***************/
+
+namespace Component {
+
+	Genode::size_t stack_size()      { return 4*1024*sizeof(long); }
+	void construct(Genode::Env &env) { static Test::Main main(env); }
+}
@@ -0,0 +1,3 @@
+TARGET = test-nic_bridge_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -7,13 +7,21 @@
 /* Genode includes */
 #include <base/env.h>
 #include <base/printf.h>
+#include <timer_session/connection.h>
 #include <ram_fs/chunk.h>
+#include <ram_fs/chunk_allocator.h>
+#include <ram_fs/file.h>
 
 namespace File_system {
 	typedef Chunk<2>                      Chunk_level_3;
 	typedef Chunk_index<3, Chunk_level_3> Chunk_level_2;
 	typedef Chunk_index<4, Chunk_level_2> Chunk_level_1;
 	typedef Chunk_index<5, Chunk_level_1> Chunk_level_0;
+
+	/* geometry used by the benchmark, capacity is 32 MiB */
+	typedef Chunk<4096>                     Bench_level_2;
+	typedef Chunk_index<128, Bench_level_2> Bench_level_1;
+	typedef Chunk_index<64,  Bench_level_1> Bench_level_0;
 }
 
 
@@ -92,6 +100,115 @@ static void truncate(File_system::Chunk_level_0 &chunk,
 }
 
 
+/**
+ * Measure throughput and memory overhead of the chunk data structure
+ *
+ * \param alloc  allocator used for the chunks
+ * \param sum    function returning the memory consumed by 'alloc'
+ */
+template <typename FUNC>
+static void benchmark(char const *name, Genode::Allocator &alloc,
+                      Timer::Connection &timer, FUNC const &sum)
+{
+	using namespace File_system;
+	using namespace Genode;
+
+	enum { BLOCK_SIZE = 4096, FILE_SIZE = 8*1024*1024,
+	       SPARSE_STRIDE = 1024*1024 };
+
+	static char buf[BLOCK_SIZE];
+	memset(buf, 0x55, sizeof(buf));
+
+	auto kib_per_sec = [] (unsigned long ms) {
+		return (unsigned long)((FILE_SIZE/1024)*1000ULL/max(ms, 1UL)); };
+
+	/* sequential write and read */
+	{
+		Bench_level_0 chunk(alloc, 0);
+
+		unsigned long const t0 = timer.elapsed_ms();
+		for (size_t offset = 0; offset < FILE_SIZE; offset += BLOCK_SIZE)
+			chunk.write(buf, BLOCK_SIZE, offset);
+
+		unsigned long const t1 = timer.elapsed_ms();
+		for (size_t offset = 0; offset < FILE_SIZE; offset += BLOCK_SIZE)
+			chunk.read(buf, BLOCK_SIZE, offset);
+
+		unsigned long const t2 = timer.elapsed_ms();
+
+		printf("%s: write %lu KiB/s, read %lu KiB/s, overhead=%zd bytes\n",
+		       name, kib_per_sec(t1 - t0), kib_per_sec(t2 - t1),
+		       sum() - FILE_SIZE);
+	}
+
+	/* sparse file with one byte written per stride */
+	{
+		Bench_level_0 chunk(alloc, 0);
+
+		for (size_t offset = 0; offset < FILE_SIZE; offset += SPARSE_STRIDE)
+			chunk.write(buf, 1, offset);
+
+		printf("%s: sparse file of %d bytes consumes %zd bytes\n",
+		       name, FILE_SIZE, sum());
+	}
+}
+
+
+/**
+ * Write, truncate, and delete files backed by the chunk allocator
+ *
+ * Truncating and deleting a file releases its chunks via 'Genode::destroy',
+ * which does not pass the size of the object to the allocator.
+ *
+ * \return  true if the memory consumption stays bounded
+ */
+static bool file_lifecycle(Genode::Allocator &backing_store)
+{
+	using namespace File_system;
+	using namespace Genode;
+
+	enum { BLOCK_SIZE = 4096, FILE_SIZE = 1024*1024, NUM_FILES = 16 };
+
+	static char buf[BLOCK_SIZE];
+	memset(buf, 0x55, sizeof(buf));
+
+	Chunk_allocator chunk_alloc(backing_store);
+
+	size_t consumed_after_first = 0;
+
+	for (unsigned i = 0; i < NUM_FILES; i++) {
+
+		File *file = new (env()->heap()) File(chunk_alloc, "file");
+
+		for (size_t offset = 0; offset < FILE_SIZE; offset += BLOCK_SIZE)
+			file->write(buf, BLOCK_SIZE, offset);
+
+		size_t const consumed_full = chunk_alloc.consumed();
+
+		file->truncate(BLOCK_SIZE);
+
+		if (chunk_alloc.consumed() >= consumed_full) {
+			PERR("truncate did not release chunks");
+			return false;
+		}
+
+		destroy(env()->heap(), file);
+
+		if (i == 0)
+			consumed_after_first = chunk_alloc.consumed();
+	}
+
+	if (chunk_alloc.consumed() > consumed_after_first) {
+		PERR("deleted files leak chunks");
+		return false;
+	}
+
+	printf("file: %d files of %d bytes written, truncated, and deleted\n",
+	       (int)NUM_FILES, (int)FILE_SIZE);
+	return true;
+}
+
+
 int main(int, char **)
 {
 	using namespace File_system;
@@ -127,5 +244,20 @@ int main(int, char **)
 
 	printf("allocator: sum=%zd\n", alloc.sum());
 
+	static Timer::Connection timer;
+
+	{
+		Allocator_tracer heap_alloc(*env()->heap());
+		benchmark("heap", heap_alloc, timer, [&] () { return heap_alloc.sum(); });
+	}
+
+	{
+		Chunk_allocator chunk_alloc(*env()->heap());
+		benchmark("slab", chunk_alloc, timer, [&] () { return chunk_alloc.consumed(); });
+	}
+
+	if (!file_lifecycle(*env()->heap()))
+		return -1;
+
 	return 0;
 }
@@ -0,0 +1,172 @@
+/*
+ * \brief  Test for the aggregated RPC statistics
+ * \author Genode Labs
+ * \date   2016-07-20
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/rpc_client.h>
+#include <base/rpc_server.h>
+#include <base/trace/rpc_stats.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Counter;
+	struct Counter_component;
+	struct Main;
+}
+
+
+/**
+ * RPC interface with a cheap and an expensive function
+ */
+struct Test::Counter
+{
+	GENODE_RPC(Rpc_fast, unsigned, fast);
+	GENODE_RPC(Rpc_slow, unsigned, slow, unsigned);
+	GENODE_RPC_INTERFACE(Rpc_fast, Rpc_slow);
+};
+
+
+struct Test::Counter_component : Rpc_object<Counter, Counter_component>
+{
+	unsigned volatile value = 0;
+
+	unsigned fast() { return ++value; }
+
+	unsigned slow(unsigned loops)
+	{
+		for (unsigned i = 0; i < loops; i++)
+			value = value + 1;
+		return value;
+	}
+};
+
+
+struct Test::Main
+{
+	enum { CALLS = 100, LOOPS = 1000*1000 };
+	enum { STACK_SIZE = 2*1024*sizeof(long) };
+
+	typedef Trace::Rpc_stats Rpc_stats;
+
+	Env &env;
+
+	Rpc_entrypoint    ep { &env.pd(), STACK_SIZE, "rpc_stats_ep" };
+	Counter_component counter;
+
+	Capability<Counter> cap = ep.manage(&counter);
+
+	template <typename FUNC, Rpc_stats::Side SIDE>
+	static Rpc_stats::Function const &stats() {
+		return Rpc_stats::Slot<Counter, FUNC, SIDE>::function; }
+
+	/**
+	 * Return bucket that contains the median latency
+	 */
+	static unsigned median(Rpc_stats::Function const &f)
+	{
+		unsigned sum = 0;
+		for (unsigned i = 0; i < Rpc_stats::BUCKETS; i++)
+			if ((sum += f.histogram[i])*2 >= f.calls)
+				return i;
+		return Rpc_stats::BUCKETS;
+	}
+
+	static void check(Rpc_stats::Function const &f, char const *what)
+	{
+		unsigned sum = 0;
+		for (unsigned i = 0; i < Rpc_stats::BUCKETS; i++)
+			sum += f.histogram[i];
+
+		if (f.calls != CALLS || sum != CALLS) {
+			error(what, ": unexpected number of calls ", f.calls,
+			      " (histogram ", sum, ")");
+			throw -1;
+		}
+
+		if (f.interface_name() != "Test::Counter") {
+			error(what, ": unexpected interface name '",
+			      f.interface_name(), "'");
+			throw -2;
+		}
+	}
+
+	Main(Env &env);
+
+	~Main() { ep.dissolve(&counter); }
+};
+
+
+Test::Main::Main(Env &env) : env(env)
+{
+	log("--- RPC statistics test ---");
+
+	if (Rpc_stats::enabled()) {
+		error("RPC statistics are enabled by default");
+		throw -3;
+	}
+
+	/* calls performed while the statistics are disabled are not recorded */
+	cap.call<Counter::Rpc_fast>();
+
+	Rpc_stats::enable(true);
+
+	for (unsigned i = 0; i < CALLS; i++) {
+		cap.call<Counter::Rpc_fast>();
+		cap.call<Counter::Rpc_slow>((unsigned)LOOPS);
+	}
+
+	Rpc_stats::enable(false);
+
+	check(stats<Counter::Rpc_fast, Rpc_stats::CLIENT>(), "fast client");
+	check(stats<Counter::Rpc_fast, Rpc_stats::SERVER>(), "fast server");
+	check(stats<Counter::Rpc_slow, Rpc_stats::CLIENT>(), "slow client");
+	check(stats<Counter::Rpc_slow, Rpc_stats::SERVER>(), "slow server");
+	log("calls of ", (unsigned)CALLS, " recorded on client and server side");
+
+	/*
+	 * The latency of the slow function appears in the histograms, provided
+	 * that the platform offers timestamps
+	 */
+	if (Trace::timestamp()) {
+		unsigned const fast = median(stats<Counter::Rpc_fast, Rpc_stats::SERVER>());
+		unsigned const slow = median(stats<Counter::Rpc_slow, Rpc_stats::SERVER>());
+		if (slow <= fast) {
+			error("latency of slow function not above fast function");
+			throw -4;
+		}
+		log("latency: buckets differ between fast and slow function");
+	} else {
+		log("latency: not measured, no timestamps available");
+	}
+
+	/* all recorded functions are visible to 'for_each' */
+	unsigned functions = 0;
+	Rpc_stats::for_each([&] (Rpc_stats::Function const &f) {
+		if (f.interface_name() == "Test::Counter")
+			functions++; });
+
+	if (functions != 4) {
+		error("unexpected number of registered functions ", functions);
+		throw -5;
+	}
+	log("statistics of ", functions, " functions registered");
+
+	log("--- RPC statistics test finished ---");
+	env.parent().exit(0);
+}
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
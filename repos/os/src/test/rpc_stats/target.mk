@@ -0,0 +1,3 @@
+TARGET = test-rpc_stats
+SRC_CC = main.cc
+LIBS   = base
@@ -11,6 +11,7 @@
  * under the terms of the GNU General Public License version 2.
  */
 
+#include <base/component.h>
 #include <base/printf.h>
 #include <base/signal.h>
 #include <base/sleep.h>
@@ -626,9 +627,76 @@ static void many_managed_contexts()
 
 
 /**
- * Main program
+ * Measure the latency of signals delivered to entrypoints
+ *
+ * Two entrypoints play ping-pong with signals. Each round trip comprises the
+ * submission of two signals and the dispatching of each signal by a signal
+ * handler at the respective entrypoint. Once finished, the test exits the
+ * component.
  */
-int main(int, char **)
+class Signal_latency_test
+{
+	private:
+
+		enum { ROUND_TRIPS = 10000, STACK_SIZE = 4096*sizeof(long) };
+
+		Env &_env;
+
+		Entrypoint _pong_ep { _env, STACK_SIZE, "pong_ep" };
+
+		unsigned      _round_trips = 0;
+		unsigned long _start_ms    = 0;
+
+		void _handle_ping();
+		void _handle_pong();
+
+		Signal_handler<Signal_latency_test> _ping_handler {
+			_env.ep(), *this, &Signal_latency_test::_handle_ping };
+
+		Signal_handler<Signal_latency_test> _pong_handler {
+			_pong_ep, *this, &Signal_latency_test::_handle_pong };
+
+		Signal_transmitter _ping_transmitter { _ping_handler };
+		Signal_transmitter _pong_transmitter { _pong_handler };
+
+	public:
+
+		Signal_latency_test(Env &env) : _env(env)
+		{
+			printf("\n");
+			printf("TEST %d: signal latency between entrypoints\n", ++test_cnt);
+			printf("\n");
+
+			_start_ms = timer.elapsed_ms();
+			_pong_transmitter.submit();
+		}
+};
+
+
+void Signal_latency_test::_handle_pong() { _ping_transmitter.submit(); }
+
+
+void Signal_latency_test::_handle_ping()
+{
+	if (++_round_trips < ROUND_TRIPS) {
+		_pong_transmitter.submit();
+		return;
+	}
+
+	unsigned long const duration_ms = max(timer.elapsed_ms() - _start_ms, 1UL);
+
+	printf("%u round trips took %lu ms\n", _round_trips, duration_ms);
+	printf("average round-trip time is %lu us\n",
+	       (duration_ms*1000)/_round_trips);
+	printf("\n");
+	printf("TEST %d FINISHED\n", test_cnt);
+
+	printf("--- signalling test finished ---\n");
+	_env.parent().exit(0);
+}
+
+
+void Component::construct(Env &env)
 {
 	printf("--- signalling test ---\n");
 
@@ -640,6 +708,6 @@ int main(int, char **)
 	synchronized_context_destruction_test();
 	many_managed_contexts();
 
-	printf("--- signalling test finished ---\n");
-	return 0;
+	/* the latency test is driven by signals dispatched by the entrypoint */
+	static Signal_latency_test latency_test(env);
 }
@@ -67,13 +67,11 @@ class Trace_buffer_monitor
 
 		Trace::Subject_id     _id;
 		Trace::Buffer        *_buffer;
-		Trace::Buffer::Entry _curr_entry;
+		Trace::Buffer::Cursor _cursor;
 
-		const char *_terminate_entry(Trace::Buffer::Entry const &entry)
+		const char *_terminate_entry(Trace::Buffer::Entry_info const &info)
 		{
-			size_t len = min(entry.length() + 1, MAX_ENTRY_BUF);
-			memcpy(_buf, entry.data(), len);
-			_buf[len-1] = '\0';
+			_buf[min(info.length, MAX_ENTRY_BUF - 1)] = '\0';
 
 			return _buf;
 		}
@@ -83,8 +81,7 @@ class Trace_buffer_monitor
 		Trace_buffer_monitor(Trace::Subject_id id, Dataspace_capability ds_cap)
 		:
 			_id(id),
-			_buffer(env()->rm_session()->attach(ds_cap)),
-			_curr_entry(_buffer->first())
+			_buffer(env()->rm_session()->attach(ds_cap))
 		{
 			PLOG("monitor subject:%d buffer:0x%lx", _id.id, (addr_t)_buffer);
 		}
@@ -102,18 +99,15 @@ class Trace_buffer_monitor
 			PLOG("overflows: %u", _buffer->wrapped());
 
 			PLOG("read all remaining events");
-			for (; !_curr_entry.last(); _curr_entry = _buffer->next(_curr_entry)) {
-				/* omit empty entries */
-				if (_curr_entry.length() == 0)
-					continue;
+			Trace::Buffer::Entry_info info;
+			while (_buffer->read(_cursor, info, _buf, MAX_ENTRY_BUF - 1)) {
 
-				const char *data = _terminate_entry(_curr_entry);
+				const char *data = _terminate_entry(info);
 				if (data)
-					PLOG("%s", data);
+					PLOG("%llu: %s", (unsigned long long)info.timestamp, data);
 			}
 
-			/* reset after we read all available entries */
-			_curr_entry = _buffer->first();
+			PLOG("lost events: %lu", _cursor.lost);
 		}
 };
 
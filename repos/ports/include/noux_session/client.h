@@ -32,6 +32,11 @@ namespace Noux {
 				return call<Rpc_sysio_dataspace>();
 			}
 
+			Dataspace_capability io_buffer_dataspace()
+			{
+				return call<Rpc_io_buffer_dataspace>();
+			}
+
 			bool syscall(Syscall sc)
 			{
 				static bool verbose = false;
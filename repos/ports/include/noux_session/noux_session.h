@@ -34,6 +34,16 @@ namespace Noux {
 
 		virtual Dataspace_capability sysio_dataspace() = 0;
 
+		/**
+		 * Return I/O buffer used for bulk reads and writes
+		 *
+		 * The buffer is allocated on the first call. Its content is
+		 * transferred by 'SYSCALL_READ_BULK' and 'SYSCALL_WRITE_BULK'.
+		 *
+		 * \return  invalid capability if the buffer could not be allocated
+		 */
+		virtual Dataspace_capability io_buffer_dataspace() = 0;
+
 		/**
 		 * Return leaf region map that covers a given address
 		 *
@@ -86,6 +96,8 @@ namespace Noux {
 			SYSCALL_SYNC,
 			SYSCALL_KILL,
 			SYSCALL_GETDTABLESIZE,
+			SYSCALL_READ_BULK,
+			SYSCALL_WRITE_BULK,
 			SYSCALL_INVALID = -1
 		};
 
@@ -136,6 +148,8 @@ namespace Noux {
 			NOUX_DECL_SYSCALL_NAME(SYNC)
 			NOUX_DECL_SYSCALL_NAME(KILL)
 			NOUX_DECL_SYSCALL_NAME(GETDTABLESIZE)
+			NOUX_DECL_SYSCALL_NAME(READ_BULK)
+			NOUX_DECL_SYSCALL_NAME(WRITE_BULK)
 			case SYSCALL_INVALID: return 0;
 			}
 			return 0;
@@ -164,13 +178,15 @@ namespace Noux {
 		 *********************/
 
 		GENODE_RPC(Rpc_sysio_dataspace, Dataspace_capability, sysio_dataspace);
+		GENODE_RPC(Rpc_io_buffer_dataspace, Dataspace_capability, io_buffer_dataspace);
 		GENODE_RPC(Rpc_lookup_region_map, Capability<Region_map>,
 		           lookup_region_map, addr_t);
 		GENODE_RPC(Rpc_syscall, bool, syscall, Syscall);
 		GENODE_RPC(Rpc_next_open_fd, int, next_open_fd, int);
 
-		GENODE_RPC_INTERFACE(Rpc_sysio_dataspace, Rpc_lookup_region_map,
-		                     Rpc_syscall, Rpc_next_open_fd);
+		GENODE_RPC_INTERFACE(Rpc_sysio_dataspace, Rpc_io_buffer_dataspace,
+		                     Rpc_lookup_region_map, Rpc_syscall,
+		                     Rpc_next_open_fd);
 	};
 }
 
@@ -51,6 +51,13 @@ namespace Noux {
 		enum { CHUNK_SIZE = 11*1024 };
 		typedef char Chunk[CHUNK_SIZE];
 
+		/*
+		 * Size of the I/O buffer used by 'SYSCALL_READ_BULK' and
+		 * 'SYSCALL_WRITE_BULK', which transfer the payload via a dedicated
+		 * dataspace instead of the sysio chunk
+		 */
+		enum { IO_BUFFER_SIZE = 1024*1024 };
+
 		enum { ARGS_MAX_LEN = 5*1024 };
 		typedef char Args[ARGS_MAX_LEN];
 
@@ -502,6 +509,10 @@ namespace Noux {
 			SYSIO_DECL(kill,        { int pid; Signal sig; }, { });
 
 			SYSIO_DECL(getdtablesize, { }, { int n; });
+
+			SYSIO_DECL(read_bulk,   { int fd; size_t count; }, { size_t count; });
+
+			SYSIO_DECL(write_bulk,  { int fd; size_t count; }, { size_t count; });
 		};
 	};
 };
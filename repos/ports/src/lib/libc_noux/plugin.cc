@@ -106,6 +106,48 @@ class Noux_connection
 
 		Noux::Session *session() { return &_connection; }
 		Noux::Sysio   *sysio()   { return  _sysio; }
+
+		/**
+		 * Return buffer for bulk reads and writes, or 0 if unavailable
+		 *
+		 * The buffer is requested from noux on first use. It is not
+		 * handed out while a bulk transfer is in progress, which may be
+		 * the case if a signal handler performs I/O.
+		 */
+		char *io_buffer()
+		{
+			if (_io_buffer_in_use)
+				return 0;
+
+			if (!_io_buffer_requested) {
+				_io_buffer_requested = true;
+				try {
+					Genode::Dataspace_capability ds = _connection.io_buffer_dataspace();
+					if (ds.valid())
+						_io_buffer = Genode::env()->rm_session()->attach(ds);
+				} catch (...) { }
+			}
+			return _io_buffer;
+		}
+
+		/**
+		 * Guard for marking the I/O buffer as used by a bulk transfer
+		 */
+		struct Io_buffer_guard
+		{
+			Noux_connection &connection;
+
+			Io_buffer_guard(Noux_connection &connection) : connection(connection) {
+				connection._io_buffer_in_use = true; }
+
+			~Io_buffer_guard() { connection._io_buffer_in_use = false; }
+		};
+
+	private:
+
+		char *_io_buffer           = 0;
+		bool  _io_buffer_requested = false;
+		bool  _io_buffer_in_use    = false;
 };
 
 
@@ -1189,11 +1231,126 @@ namespace {
 	}
 
 
+	/**
+	 * Set errno according to the error of a failed write syscall
+	 */
+	static void set_write_errno()
+	{
+		switch (sysio()->error.write) {
+		case Vfs::File_io_service::WRITE_ERR_AGAIN:       errno = EAGAIN;      break;
+		case Vfs::File_io_service::WRITE_ERR_WOULD_BLOCK: errno = EWOULDBLOCK; break;
+		case Vfs::File_io_service::WRITE_ERR_INVALID:     errno = EINVAL;      break;
+		case Vfs::File_io_service::WRITE_ERR_IO:          errno = EIO;         break;
+		case Vfs::File_io_service::WRITE_ERR_INTERRUPT:   errno = EINTR;       break;
+		default: 
+			if (sysio()->error.general == Vfs::Directory_service::ERR_FD_INVALID)
+				errno = EBADF;
+			else
+				errno = 0;
+			break;
+		}
+	}
+
+
+	/**
+	 * Set errno according to the error of a failed read syscall
+	 */
+	static void set_read_errno()
+	{
+		switch (sysio()->error.read) {
+		case Vfs::File_io_service::READ_ERR_AGAIN:       errno = EAGAIN;      break;
+		case Vfs::File_io_service::READ_ERR_WOULD_BLOCK: errno = EWOULDBLOCK; break;
+		case Vfs::File_io_service::READ_ERR_INVALID:     errno = EINVAL;      break;
+		case Vfs::File_io_service::READ_ERR_IO:          errno = EIO;         break;
+		case Vfs::File_io_service::READ_ERR_INTERRUPT:   errno = EINTR;       break;
+		default:
+			if (sysio()->error.general == Vfs::Directory_service::ERR_FD_INVALID)
+				errno = EBADF;
+			else
+				errno = 0;
+			break;
+		}
+	}
+
+
+	/**
+	 * Write data via the I/O buffer, transferring up to
+	 * 'Sysio::IO_BUFFER_SIZE' bytes per syscall
+	 */
+	static ssize_t write_bulk(int fd, char const *src, ::size_t count,
+	                          char *io_buffer)
+	{
+		Noux_connection::Io_buffer_guard guard(*noux_connection());
+
+		::size_t written = 0;
+		while (written < count) {
+
+			::size_t const curr_count =
+				Genode::min(count - written, (::size_t)Noux::Sysio::IO_BUFFER_SIZE);
+
+			Genode::memcpy(io_buffer, src + written, curr_count);
+
+			sysio()->write_bulk_in.fd    = fd;
+			sysio()->write_bulk_in.count = curr_count;
+
+			if (!noux_syscall(Noux::Session::SYSCALL_WRITE_BULK)) {
+				set_write_errno();
+				return written ? (ssize_t)written : -1;
+			}
+
+			written += sysio()->write_bulk_out.count;
+
+			if (sysio()->write_bulk_out.count < curr_count)
+				break;
+		}
+		return written;
+	}
+
+
+	/**
+	 * Read data via the I/O buffer
+	 */
+	static ssize_t read_bulk(int fd, char *dst, ::size_t count, char *io_buffer)
+	{
+		Noux_connection::Io_buffer_guard guard(*noux_connection());
+
+		::size_t sum_read_count = 0;
+		while (sum_read_count < count) {
+
+			::size_t const curr_count =
+				Genode::min(count - sum_read_count, (::size_t)Noux::Sysio::IO_BUFFER_SIZE);
+
+			sysio()->read_bulk_in.fd    = fd;
+			sysio()->read_bulk_in.count = curr_count;
+
+			if (!noux_syscall(Noux::Session::SYSCALL_READ_BULK)) {
+				set_read_errno();
+				return sum_read_count ? (ssize_t)sum_read_count : -1;
+			}
+
+			::size_t const n = Genode::min(sysio()->read_bulk_out.count, curr_count);
+
+			Genode::memcpy(dst + sum_read_count, io_buffer, n);
+			sum_read_count += n;
+
+			if (n < curr_count)
+				break; /* end of file */
+		}
+		return sum_read_count;
+	}
+
+
 	ssize_t Plugin::write(Libc::File_descriptor *fd, const void *buf,
 	                      ::size_t count)
 	{
 		if (!buf) { errno = EFAULT; return -1; }
 
+		/* transfer large requests via the I/O buffer */
+		if (count > Noux::Sysio::CHUNK_SIZE)
+			if (char *io_buffer = noux_connection()->io_buffer())
+				return write_bulk(noux_fd(fd->context), (char const *)buf,
+				                  count, io_buffer);
+
 		/* remember original len for the return value */
 		int const orig_count = count;
 
@@ -1206,21 +1363,8 @@ namespace {
 			sysio()->write_in.count = curr_count;
 			Genode::memcpy(sysio()->write_in.chunk, src, curr_count);
 
-			if (!noux_syscall(Noux::Session::SYSCALL_WRITE)) {
-				switch (sysio()->error.write) {
-				case Vfs::File_io_service::WRITE_ERR_AGAIN:       errno = EAGAIN;      break;
-				case Vfs::File_io_service::WRITE_ERR_WOULD_BLOCK: errno = EWOULDBLOCK; break;
-				case Vfs::File_io_service::WRITE_ERR_INVALID:     errno = EINVAL;      break;
-				case Vfs::File_io_service::WRITE_ERR_IO:          errno = EIO;         break;
-				case Vfs::File_io_service::WRITE_ERR_INTERRUPT:   errno = EINTR;       break;
-				default: 
-					if (sysio()->error.general == Vfs::Directory_service::ERR_FD_INVALID)
-						errno = EBADF;
-					else
-						errno = 0;
-					break;
-				}
-			}
+			if (!noux_syscall(Noux::Session::SYSCALL_WRITE))
+				set_write_errno();
 
 			count -= curr_count;
 			src   += curr_count;
@@ -1233,6 +1377,12 @@ namespace {
 	{
 		if (!buf) { errno = EFAULT; return -1; }
 
+		/* transfer large requests via the I/O buffer */
+		if (count > Noux::Sysio::CHUNK_SIZE)
+			if (char *io_buffer = noux_connection()->io_buffer())
+				return read_bulk(noux_fd(fd->context), (char *)buf, count,
+				                 io_buffer);
+
 		Genode::size_t sum_read_count = 0;
 
 		while (count > 0) {
@@ -1244,20 +1394,7 @@ namespace {
 			sysio()->read_in.count = curr_count;
 
 			if (!noux_syscall(Noux::Session::SYSCALL_READ)) {
-
-				switch (sysio()->error.read) {
-				case Vfs::File_io_service::READ_ERR_AGAIN:       errno = EAGAIN;      break;
-				case Vfs::File_io_service::READ_ERR_WOULD_BLOCK: errno = EWOULDBLOCK; break;
-				case Vfs::File_io_service::READ_ERR_INVALID:     errno = EINVAL;      break;
-				case Vfs::File_io_service::READ_ERR_IO:          errno = EIO;         break;
-				case Vfs::File_io_service::READ_ERR_INTERRUPT:   errno = EINTR;       break;
-				default:
-					if (sysio()->error.general == Vfs::Directory_service::ERR_FD_INVALID)
-						errno = EBADF;
-					else
-						errno = 0;
-					break;
-				}
+				set_read_errno();
 				return -1;
 			}
 
@@ -0,0 +1,329 @@
+/*
+ * \brief  Cache of executable binaries
+ * \author Genode Labs
+ * \date   2016-07-14
+ *
+ * Obtaining the dataspace of a binary from the VFS implies copying the
+ * whole file into a new RAM dataspace for most file systems, and 'execve'
+ * looks up the binary several times. The cache keeps the dataspaces of
+ * recently executed binaries and hands out the same dataspace to all
+ * processes executing a binary.
+ *
+ * Only read-only dataspaces, e.g., of binaries provided as ROM modules, are
+ * shared. A writable dataspace would be mapped writable into each process,
+ * so a process that writes to its text would corrupt the binary for all
+ * other processes executing it. Each process executing a binary with a
+ * writable dataspace, e.g., from a RAM or TAR file system, obtains a
+ * private copy from the VFS. The same holds for all binaries if the cache
+ * is disabled via a 'binary_cache_size' of 0.
+ *
+ * Dataspaces not used by any process are evicted in least-recently-used
+ * order once the cached binaries exceed the configured size. A cached
+ * binary is invalidated when the file is opened for writing, unlinked, or
+ * renamed, or when its size or inode changed.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _NOUX__BINARY_CACHE_H_
+#define _NOUX__BINARY_CACHE_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/lock.h>
+#include <base/printf.h>
+#include <dataspace/client.h>
+#include <util/list.h>
+#include <vfs/dir_file_system.h>
+
+/* Noux includes */
+#include <path.h>
+
+namespace Noux {
+
+	class Binary_cache;
+
+	/**
+	 * Return cache of executable binaries
+	 */
+	Binary_cache &binary_cache();
+}
+
+
+class Noux::Binary_cache
+{
+	public:
+
+		enum { DEFAULT_SIZE = 32*1024*1024 };
+
+		struct Stats
+		{
+			unsigned long hits          = 0;
+			unsigned long misses        = 0;
+			unsigned long evictions     = 0;
+			unsigned long invalidations = 0;
+		};
+
+	private:
+
+		struct Entry : List<Entry>::Element
+		{
+			Absolute_path  const path;
+			Vfs::Directory_service::Stat const stat;
+
+			Vfs::Dir_file_system &root_dir;
+			Dataspace_capability const ds;
+			size_t const size;
+
+			unsigned      users    = 0;
+			unsigned long last_use = 0;
+			unsigned long hits     = 0;
+
+			/* invalidated while in use, released with the last user */
+			bool stale = false;
+
+			/*
+			 * Private to a single user because the dataspace is writable
+			 * or the cache is disabled
+			 */
+			bool const exclusive;
+
+			Entry(char const *path, Vfs::Directory_service::Stat const &stat,
+			      Vfs::Dir_file_system &root_dir, Dataspace_capability ds,
+			      bool exclusive)
+			:
+				path(path), stat(stat), root_dir(root_dir), ds(ds),
+				size(Dataspace_client(ds).size()), exclusive(exclusive)
+			{ }
+
+			~Entry() { root_dir.release(path.base(), ds); }
+
+			bool same_file(Vfs::Directory_service::Stat const &other) const
+			{
+				return stat.inode && stat.inode  == other.inode
+				                  && stat.device == other.device;
+			}
+		};
+
+		Lock        _lock;
+		List<Entry> _entries;
+
+		size_t        _max_size    = DEFAULT_SIZE;
+		size_t        _cached_size = 0;
+		unsigned long _use_count   = 0;
+
+		Stats _stats;
+
+		void _destroy(Entry *e)
+		{
+			_entries.remove(e);
+			if (!e->exclusive)
+				_cached_size -= e->size;
+			destroy(env()->heap(), e);
+		}
+
+		void _invalidate(Entry *e)
+		{
+			_stats.invalidations++;
+
+			if (e->users) {
+				e->stale = true;
+				return;
+			}
+			_destroy(e);
+		}
+
+		/**
+		 * Evict unused entries until the cache size limit is met
+		 */
+		void _evict()
+		{
+			while (_cached_size > _max_size) {
+
+				Entry *lru = nullptr;
+				for (Entry *e = _entries.first(); e; e = e->next())
+					if (!e->users && (!lru || e->last_use < lru->last_use))
+						lru = e;
+
+				if (!lru)
+					return;
+
+				_stats.evictions++;
+				_destroy(lru);
+			}
+		}
+
+		Entry *_lookup(char const *path)
+		{
+			for (Entry *e = _entries.first(); e; e = e->next())
+				if (!e->stale && !e->exclusive && e->path.equals(Absolute_path(path)))
+					return e;
+			return nullptr;
+		}
+
+	public:
+
+		/**
+		 * Set upper bound of the size of cached binaries not in use
+		 *
+		 * A size of 0 disables the cache. No binary is shared between
+		 * processes then, binaries still in use are released with their
+		 * last user.
+		 */
+		void max_size(size_t max_size)
+		{
+			Lock::Guard guard(_lock);
+			_max_size = max_size;
+
+			if (!_max_size)
+				for (Entry *e = _entries.first(); e; e = e->next())
+					e->stale = true;
+
+			_evict();
+		}
+
+		bool enabled() const { return _max_size > 0; }
+
+		/**
+		 * Return dataspace of binary
+		 *
+		 * \return  dataspace, or invalid capability if the binary could
+		 *          not be obtained from the VFS
+		 *
+		 * Each successful call must be paired with a call of 'release'.
+		 * If the binary is writable or the cache is disabled, each call
+		 * yields a private copy of the binary.
+		 */
+		Dataspace_capability acquire(Vfs::Dir_file_system &root_dir,
+		                             char const *path)
+		{
+			Lock::Guard guard(_lock);
+
+			Vfs::Directory_service::Stat stat;
+			if (root_dir.stat(path, stat) != Vfs::Directory_service::STAT_OK)
+				return Dataspace_capability();
+
+			Entry *e = _lookup(path);
+
+			/* detect files that were replaced behind our back */
+			if (e && (e->stat.size != stat.size || e->stat.inode != stat.inode)) {
+				_invalidate(e);
+				e = nullptr;
+			}
+
+			if (e) {
+				_stats.hits++;
+				e->hits++;
+			} else {
+				Dataspace_capability ds = root_dir.dataspace(path);
+				if (!ds.valid())
+					return ds;
+
+				_stats.misses++;
+
+				bool const exclusive = !enabled() || Dataspace_client(ds).writable();
+
+				try {
+					e = new (env()->heap()) Entry(path, stat, root_dir, ds,
+					                              exclusive);
+				} catch (...) {
+					root_dir.release(path, ds);
+					return Dataspace_capability();
+				}
+				_entries.insert(e);
+				if (!exclusive)
+					_cached_size += e->size;
+			}
+
+			e->users++;
+			e->last_use = ++_use_count;
+
+			_evict();
+
+			return e->ds;
+		}
+
+		/**
+		 * Release dataspace obtained via 'acquire'
+		 */
+		void release(Dataspace_capability ds)
+		{
+			Lock::Guard guard(_lock);
+
+			for (Entry *e = _entries.first(); e; e = e->next()) {
+
+				if (!(e->ds == ds) || !e->users)
+					continue;
+
+				e->users--;
+
+				if (!e->users && (e->stale || e->exclusive))
+					_destroy(e);
+				else
+					_evict();
+
+				return;
+			}
+			PERR("release of unknown binary dataspace");
+		}
+
+		/**
+		 * Invalidate cached binary that is about to be modified
+		 *
+		 * Besides the binary cached for 'path', all binaries referring to
+		 * the same file, e.g., via a hard link or symlink, are invalidated.
+		 */
+		void invalidate(Vfs::Dir_file_system &root_dir, char const *path)
+		{
+			Lock::Guard guard(_lock);
+
+			if (!_entries.first())
+				return;
+
+			Vfs::Directory_service::Stat stat;
+			bool const stat_ok =
+				root_dir.stat(path, stat) == Vfs::Directory_service::STAT_OK;
+
+			Entry *next = nullptr;
+			for (Entry *e = _entries.first(); e; e = next) {
+				next = e->next();
+
+				if (e->stale)
+					continue;
+
+				if (e->path.equals(Absolute_path(path)) || (stat_ok && e->same_file(stat)))
+					_invalidate(e);
+			}
+		}
+
+		Stats stats()
+		{
+			Lock::Guard guard(_lock);
+			return _stats;
+		}
+
+		/**
+		 * Log cache statistics and the hit counts of the cached binaries
+		 */
+		void print_stats()
+		{
+			Lock::Guard guard(_lock);
+
+			PINF("binary cache: %lu hits, %lu misses, %lu evictions, "
+			     "%lu invalidations, %zu KiB cached",
+			     _stats.hits, _stats.misses, _stats.evictions,
+			     _stats.invalidations, _cached_size/1024);
+
+			for (Entry *e = _entries.first(); e; e = e->next())
+				if (!e->exclusive)
+					PINF("  %s: %lu hits, %u users%s", e->path.base(), e->hits,
+					     e->users, e->stale ? " (stale)" : "");
+		}
+};
+
+#endif /* _NOUX__BINARY_CACHE_H_ */
@@ -21,6 +21,7 @@
 #include <pd_session/connection.h>
 #include <os/attached_ram_dataspace.h>
 #include <os/attached_rom_dataspace.h>
+#include <util/volatile_object.h>
 
 /* Noux includes */
 #include <file_descriptor_registry.h>
@@ -38,6 +39,7 @@
 #include <interrupt_handler.h>
 #include <kill_broadcaster.h>
 #include <parent_execve.h>
+#include <binary_cache.h>
 #include <local_cpu_service.h>
 #include <local_pd_service.h>
 #include <local_rom_service.h>
@@ -177,9 +179,11 @@ namespace Noux {
 
 				Resources(char const *label, Rpc_entrypoint &ep,
 				          Dataspace_registry &ds_registry,
+				          Signal_receiver &sig_rec,
 				          Pd_session_capability core_pd_cap, bool forked)
 				:
-					ep(ep), ram(ds_registry), cpu(label, core_pd_cap, forked)
+					ep(ep), ram(ds_registry, sig_rec),
+					cpu(label, core_pd_cap, forked)
 				{
 					ep.manage(&ram);
 					ep.manage(&cpu);
@@ -223,16 +227,20 @@ namespace Noux {
 				Vfs::Dir_file_system * const _root_dir;
 				Dataspace_capability   const _binary_ds;
 
-				Elf(char const * const binary_name, Vfs::Dir_file_system * root_dir,
-				    Dataspace_capability binary_ds)
+				Elf(char const * const binary_name, Vfs::Dir_file_system * root_dir)
 				:
-					_root_dir(root_dir), _binary_ds(binary_ds)
+					_root_dir(root_dir),
+					_binary_ds(binary_cache().acquire(*root_dir, binary_name))
 				{
 					strncpy(_name, binary_name, sizeof(_name));
 					_name[NAME_MAX_LEN - 1] = 0;
 				}
 
-				~Elf() { _root_dir->release(_name, _binary_ds); }
+				~Elf()
+				{
+					if (_binary_ds.valid())
+						binary_cache().release(_binary_ds);
+				}
 			} _elf;
 
 			enum { PAGE_SIZE = 4096, PAGE_MASK = ~(PAGE_SIZE - 1) };
@@ -262,6 +270,41 @@ namespace Noux {
 			Static_dataspace_info _env_ds_info;
 			Static_dataspace_info _config_ds_info;
 
+			/**
+			 * Buffer of bulk reads and writes, allocated on first use
+			 *
+			 * The buffer is private to the process. A forked process does
+			 * not inherit the buffer but obtains a buffer of its own.
+			 */
+			struct Io_buffer
+			{
+				struct Info : Static_dataspace_info
+				{
+					Info(Dataspace_registry &registry, Dataspace_capability ds)
+					: Static_dataspace_info(registry, ds) { }
+
+					Dataspace_capability fork(Ram_session_capability,
+					                          Dataspace_registry &,
+					                          Rpc_entrypoint &) override
+					{
+						return Dataspace_capability();
+					}
+				};
+
+				Attached_ram_dataspace ds;
+				Info                   info;
+
+				Io_buffer(Dataspace_registry &registry)
+				:
+					ds(Genode::env()->ram_session(), Sysio::IO_BUFFER_SIZE),
+					info(registry, ds.cap())
+				{ }
+
+				char *base() { return ds.local_addr<char>(); }
+			};
+
+			Lazy_volatile_object<Io_buffer> _io_buffer;
+
 			Dataspace_capability _ldso_ds;
 
 			Child_policy  _child_policy;
@@ -394,12 +437,13 @@ namespace Noux {
 				_cap_session(cap_session),
 				_entrypoint(cap_session, STACK_SIZE, "noux_process", false),
 				_pd(binary_name, resources_ep, _ds_registry),
-				_resources(binary_name, resources_ep, _ds_registry, _pd.core_pd_cap(), false),
+				_resources(binary_name, resources_ep, _ds_registry, *sig_rec,
+				           _pd.core_pd_cap(), false),
 				_initial_thread(_resources.cpu, _pd.cap(), binary_name),
 				_args(ARGS_DS_SIZE, args),
 				_env(env),
 				_config(*Genode::env()->ram_session()),
-				_elf(binary_name, root_dir, root_dir->dataspace(binary_name)),
+				_elf(binary_name, root_dir),
 				_sysio_ds(Genode::env()->ram_session(), SYSIO_DS_SIZE),
 				_sysio(_sysio_ds.local_addr<Sysio>()),
 				_noux_session_cap(Session_capability(_entrypoint.manage(this))),
@@ -431,6 +475,13 @@ namespace Noux {
 				       _entrypoint, _child_policy, _local_pd_service,
 				       _parent_ram_service, _local_cpu_service)
 			{
+				/*
+				 * The read-write segments of the binary are populated by
+				 * noux during the construction of '_child' and thereby
+				 * must not be copy-on-write dataspaces.
+				 */
+				_resources.ram.enable_copy_on_write();
+
 				if (verbose)
 					_args.dump();
 
@@ -487,6 +538,18 @@ namespace Noux {
 				return _sysio_ds.cap();
 			}
 
+			Dataspace_capability io_buffer_dataspace()
+			{
+				if (!_io_buffer.constructed()) {
+					try { _io_buffer.construct(_ds_registry); }
+					catch (...) {
+						PWRN("could not allocate I/O buffer");
+						return Dataspace_capability();
+					}
+				}
+				return _io_buffer->ds.cap();
+			}
+
 			Capability<Region_map> lookup_region_map(addr_t const addr)
 			{
 				return _pd.lookup_region_map(addr);
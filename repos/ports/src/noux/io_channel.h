@@ -82,6 +82,70 @@ namespace Noux {
 			virtual bool     ioctl(Sysio *sysio)                 { return false; }
 			virtual bool     lseek(Sysio *sysio)                 { return false; }
 
+			/**
+			 * Read data into a buffer of noux
+			 *
+			 * \param dst        destination buffer
+			 * \param count      maximum number of bytes to read
+			 * \param out_count  number of bytes read
+			 *
+			 * This function is used for bulk reads, which bypass the sysio
+			 * chunk. Errors are reported via 'sysio->error.read'. The default
+			 * implementation issues chunk-sized reads until 'count' is
+			 * reached or a read returns less data than requested.
+			 */
+			virtual bool read(Sysio *sysio, char *dst, size_t count,
+			                  size_t &out_count)
+			{
+				for (out_count = 0; out_count < count; ) {
+
+					size_t const curr_count = min(count - out_count,
+					                              sizeof(sysio->read_out.chunk));
+
+					sysio->read_in.count = curr_count;
+
+					if (!read(sysio))
+						return out_count > 0;
+
+					memcpy(dst + out_count, sysio->read_out.chunk,
+					       sysio->read_out.count);
+
+					out_count += sysio->read_out.count;
+
+					if (sysio->read_out.count < curr_count)
+						break;
+				}
+				return true;
+			}
+
+			/**
+			 * Write data from a buffer of noux
+			 *
+			 * \param src     source buffer
+			 * \param count   number of bytes of the source buffer
+			 * \param offset  in/out offset of the not yet written data
+			 *
+			 * Like the sysio-based 'write', the function may write only a
+			 * part of the data and is called again for the remainder. The
+			 * default implementation writes at most one sysio chunk.
+			 */
+			virtual bool write(Sysio *sysio, char const *src, size_t count,
+			                   size_t &offset)
+			{
+				size_t const curr_count = min(count - offset,
+				                              sizeof(sysio->write_in.chunk));
+
+				memcpy(sysio->write_in.chunk, src + offset, curr_count);
+				sysio->write_in.count = curr_count;
+
+				size_t chunk_offset = 0;
+				if (!write(sysio, chunk_offset))
+					return false;
+
+				offset += chunk_offset;
+				return true;
+			}
+
 			/**
 			 * Return true if an unblocking condition of the channel is satisfied
 			 *
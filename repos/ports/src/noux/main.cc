@@ -46,6 +46,7 @@
 static const bool verbose_quota  = false;
 static bool trace_syscalls = false;
 static bool verbose = false;
+static Genode::size_t pipe_capacity = Noux::Pipe::DEFAULT_CAPACITY;
 
 namespace Noux {
 
@@ -208,6 +209,70 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 				break;
 			}
 
+		case SYSCALL_WRITE_BULK:
+			{
+				if (!_io_buffer.constructed()) {
+					_sysio->error.write = Vfs::File_io_service::WRITE_ERR_INVALID;
+					break;
+				}
+
+				int    const fd       = _sysio->write_bulk_in.fd;
+				size_t const count_in = min(_sysio->write_bulk_in.count,
+				                            (size_t)Sysio::IO_BUFFER_SIZE);
+
+				size_t offset = 0;
+				while (offset != count_in) {
+
+					Shared_pointer<Io_channel> io = _lookup_channel(fd);
+
+					if (!io->nonblocking())
+						_block_for_io_channel(io, false, true, false);
+
+					if (!io->check_unblock(false, true, false)) {
+						if (result == false)
+							_sysio->error.write = Vfs::File_io_service::WRITE_ERR_INTERRUPT;
+						break;
+					}
+
+					size_t const prev_offset = offset;
+
+					result = io->write(_sysio, _io_buffer->base(), count_in, offset);
+
+					/* stop if the channel does not make progress */
+					if (result == false || offset == prev_offset)
+						break;
+				}
+
+				_sysio->write_bulk_out.count = offset;
+				break;
+			}
+
+		case SYSCALL_READ_BULK:
+			{
+				if (!_io_buffer.constructed()) {
+					_sysio->error.read = Vfs::File_io_service::READ_ERR_INVALID;
+					break;
+				}
+
+				int    const fd    = _sysio->read_bulk_in.fd;
+				size_t const count = min(_sysio->read_bulk_in.count,
+				                         (size_t)Sysio::IO_BUFFER_SIZE);
+
+				Shared_pointer<Io_channel> io = _lookup_channel(fd);
+
+				if (!io->nonblocking())
+					_block_for_io_channel(io, true, false, false);
+
+				if (io->check_unblock(true, false, false)) {
+					size_t out_count = 0;
+					result = io->read(_sysio, _io_buffer->base(), count, out_count);
+					_sysio->read_bulk_out.count = out_count;
+				} else
+					_sysio->error.read = Vfs::File_io_service::READ_ERR_INTERRUPT;
+
+				break;
+			}
+
 		case SYSCALL_FTRUNCATE:
 			{
 				Shared_pointer<Io_channel> io = _lookup_channel(_sysio->ftruncate_in.fd);
@@ -292,6 +357,10 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 
 		case SYSCALL_OPEN:
 			{
+				/* cached binaries must not survive modifications */
+				if ((_sysio->open_in.mode & Sysio::OPEN_MODE_ACCMODE) != Sysio::OPEN_MODE_RDONLY)
+					binary_cache().invalidate(*root_dir(), _sysio->open_in.path);
+
 				Vfs::Vfs_handle *vfs_handle = 0;
 				_sysio->error.open = root_dir()->open(_sysio->open_in.path,
 				                                      _sysio->open_in.mode,
@@ -351,7 +420,7 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 				 * does not exist.
 				 */
 				Dataspace_capability binary_ds =
-					root_dir()->dataspace(_sysio->execve_in.filename);
+					binary_cache().acquire(*root_dir(), _sysio->execve_in.filename);
 
 				if (!binary_ds.valid()) {
 					_sysio->error.execve = Sysio::EXECVE_NONEXISTENT;
@@ -362,16 +431,16 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 					child_env(_sysio->execve_in.filename, binary_ds,
 					          _sysio->execve_in.args, _sysio->execve_in.env);
 
-				root_dir()->release(_sysio->execve_in.filename, binary_ds);
+				binary_cache().release(binary_ds);
 
-				binary_ds = root_dir()->dataspace(child_env.binary_name());
+				binary_ds = binary_cache().acquire(*root_dir(), child_env.binary_name());
 
 				if (!binary_ds.valid()) {
 					_sysio->error.execve = Sysio::EXECVE_NONEXISTENT;
 					break;
 				}
 
-				root_dir()->release(child_env.binary_name(), binary_ds);
+				binary_cache().release(binary_ds);
 
 				try {
 					_parent_execve.execve_child(*this,
@@ -675,7 +744,7 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 
 		case SYSCALL_PIPE:
 			{
-				Shared_pointer<Pipe> pipe(new Pipe, Genode::env()->heap());
+				Shared_pointer<Pipe> pipe(new Pipe(pipe_capacity), Genode::env()->heap());
 
 				Shared_pointer<Io_channel> pipe_sink(new Pipe_sink_io_channel(pipe, *_sig_rec),
 				                                     Genode::env()->heap());
@@ -702,6 +771,8 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 
 		case SYSCALL_UNLINK:
 
+			binary_cache().invalidate(*root_dir(), _sysio->unlink_in.path);
+
 			_sysio->error.unlink = root_dir()->unlink(_sysio->unlink_in.path);
 
 			result = (_sysio->error.unlink == Vfs::Directory_service::UNLINK_OK);
@@ -725,6 +796,9 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 
 		case SYSCALL_RENAME:
 
+			binary_cache().invalidate(*root_dir(), _sysio->rename_in.from_path);
+			binary_cache().invalidate(*root_dir(), _sysio->rename_in.to_path);
+
 			_sysio->error.rename = root_dir()->rename(_sysio->rename_in.from_path,
 			                                          _sysio->rename_in.to_path);
 
@@ -1074,6 +1148,13 @@ static Noux::Io_channel *connect_stdio(Vfs::Dir_file_system            &root,
 }
 
 
+Noux::Binary_cache &Noux::binary_cache()
+{
+	static Binary_cache inst;
+	return inst;
+}
+
+
 Genode::Dataspace_capability Noux::ldso_ds_cap()
 {
 	try {
@@ -1147,6 +1228,11 @@ int main(int argc, char **argv)
 	/* obtain global configuration */
 	trace_syscalls = config()->xml_node().attribute_value("trace_syscalls", trace_syscalls);
 	verbose        = config()->xml_node().attribute_value("verbose", verbose);
+	pipe_capacity  = config()->xml_node().attribute_value("pipe_capacity",
+	                                                      Number_of_bytes(pipe_capacity));
+
+	binary_cache().max_size(config()->xml_node().attribute_value("binary_cache_size",
+	                        Number_of_bytes(Binary_cache::DEFAULT_SIZE)));
 
 	/* register additional file systems to the VFS */
 	Vfs::Global_file_system_factory &fs_factory = Vfs::global_file_system_factory();
@@ -1253,6 +1339,9 @@ int main(int argc, char **argv)
 				 env()->ram_session()->used());
 	}
 
+	if (verbose)
+		binary_cache().print_stats();
+
 	PINF("--- exiting noux ---");
 	return exit_value;
 }
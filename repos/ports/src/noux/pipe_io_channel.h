@@ -14,46 +14,118 @@
 #ifndef _NOUX__PIPE_IO_CHANNEL_H_
 #define _NOUX__PIPE_IO_CHANNEL_H_
 
+/* Genode includes */
+#include <util/fifo.h>
+#include <util/construct_at.h>
+
 /* Noux includes */
 #include <io_channel.h>
 
 namespace Noux {
 
+	/**
+	 * Pipe buffer
+	 *
+	 * The pipe data is stored in a queue of page-sized segments. Segments
+	 * are allocated while the writer produces data, up to the capacity of
+	 * the pipe, and a filled segment is handed over to the reader as a
+	 * whole. Segments drained by the reader are released, except for one
+	 * spare segment that is reused by the writer. Hence, an idle pipe
+	 * occupies a single segment while a pipe between a fast writer and a
+	 * slow reader can grow up to its capacity.
+	 */
 	class Pipe : public Reference_counter
 	{
+		public:
+
+			enum { SEGMENT_SIZE     = 4096,
+			       DEFAULT_CAPACITY = 64*1024,
+			       MAX_CAPACITY     = 1024*1024 };
+
 		private:
 
+			struct Segment : Fifo<Segment>::Element
+			{
+				size_t read_offset  = 0;
+				size_t write_offset = 0;
+
+				char data[SEGMENT_SIZE];
+
+				bool full()  const { return write_offset == SEGMENT_SIZE; }
+				bool empty() const { return read_offset  == write_offset; }
+
+				size_t write(char const *src, size_t len)
+				{
+					len = min(len, SEGMENT_SIZE - write_offset);
+					memcpy(&data[write_offset], src, len);
+					write_offset += len;
+					return len;
+				}
+
+				size_t read(char *dst, size_t len)
+				{
+					len = min(len, write_offset - read_offset);
+					memcpy(dst, &data[read_offset], len);
+					read_offset += len;
+					return len;
+				}
+			};
+
 			Lock mutable _lock;
 
-			enum { BUFFER_SIZE = 4096 };
-			char _buffer[BUFFER_SIZE];
+			size_t const _capacity;
+
+			Fifo<Segment> _segments;
+			Segment      *_tail  = nullptr; /* segment written to */
+			Segment      *_spare = nullptr;
 
-			unsigned _read_offset;
-			unsigned _write_offset;
+			/* number of bytes stored in the pipe */
+			size_t _used = 0;
 
 			Signal_context_capability _read_ready_sigh;
 			Signal_context_capability _write_ready_sigh;
 
 			bool _writer_is_gone;
 
+			static size_t _init_capacity(size_t capacity)
+			{
+				return min(max(align_addr(capacity, 12), (size_t)SEGMENT_SIZE),
+				           (size_t)MAX_CAPACITY);
+			}
+
 			/**
 			 * Return space available in the buffer for writing, in bytes
 			 */
-			size_t _avail_buffer_space() const
+			size_t _avail_buffer_space() const { return _capacity - _used; }
+
+			bool _any_space_avail_for_writing() const
 			{
-				if (_read_offset < _write_offset)
-					return (BUFFER_SIZE - _write_offset) + _read_offset - 1;
+				return _avail_buffer_space() > 0;;
+			}
 
-				if (_read_offset > _write_offset)
-					return _read_offset - _write_offset - 1;
+			/**
+			 * Return segment for appending data, or 0 if out of memory
+			 */
+			Segment *_alloc_segment()
+			{
+				if (_spare) {
+					Segment *seg = _spare;
+					_spare = nullptr;
+					return seg;
+				}
 
-				/* _read_offset == _write_offset */
-				return BUFFER_SIZE - 1;
+				try { return new (env()->heap()) Segment; }
+				catch (Allocator::Out_of_memory) { return nullptr; }
 			}
 
-			bool _any_space_avail_for_writing() const
+			void _release_segment(Segment *seg)
 			{
-				return _avail_buffer_space() > 0;;
+				if (!_spare) {
+					construct_at<Segment>(seg);
+					_spare = seg;
+					return;
+				}
+				destroy(env()->heap(), seg);
 			}
 
 			void _wake_up_reader()
@@ -70,14 +142,29 @@ namespace Noux {
 
 		public:
 
-			Pipe()
-			: _read_offset(0), _write_offset(0), _writer_is_gone(false) { }
+			/**
+			 * Constructor
+			 *
+			 * \param capacity  maximum number of bytes buffered by the pipe,
+			 *                  rounded up to the segment size and limited
+			 *                  to 'MAX_CAPACITY'
+			 */
+			Pipe(size_t capacity = DEFAULT_CAPACITY)
+			: _capacity(_init_capacity(capacity)), _writer_is_gone(false) { }
 
 			~Pipe()
 			{
 				Lock::Guard guard(_lock);
+
+				while (Segment *seg = _segments.dequeue())
+					destroy(env()->heap(), seg);
+
+				if (_spare)
+					destroy(env()->heap(), _spare);
 			}
 
+			size_t capacity() const { return _capacity; }
+
 			void writer_close()
 			{
 				Lock::Guard guard(_lock);
@@ -109,51 +196,51 @@ namespace Noux {
 			{
 				Lock::Guard guard(_lock);
 
-				return _read_offset != _write_offset;
+				return _used > 0;
 			}
 
 			size_t read(char *dst, size_t dst_len)
 			{
 				Lock::Guard guard(_lock);
 
-				if (_read_offset < _write_offset) {
-
-					size_t len = min(dst_len, _write_offset - _read_offset);
-					memcpy(dst, &_buffer[_read_offset], len);
+				size_t len = 0;
+				while (len < dst_len && _segments.head()) {
 
-					_read_offset += len;
-					_wake_up_writer();
+					Segment *seg = _segments.head();
 
-					return len;
-				}
+					len += seg->read(dst + len, dst_len - len);
 
-				if (_read_offset > _write_offset) {
+					if (!seg->empty())
+						break;
 
-					size_t const upper_len = min(dst_len, BUFFER_SIZE - _read_offset);
-					memcpy(dst, &_buffer[_read_offset], upper_len);
-
-					size_t const lower_len = min(dst_len - upper_len, _write_offset);
-					if (lower_len) {
-						memcpy(dst + upper_len, &_buffer[0], lower_len);
-						_read_offset = lower_len;
-					} else {
-						_read_offset += upper_len;
+					/* keep the segment currently written to */
+					if (seg == _tail && !seg->full()) {
+						seg->read_offset = seg->write_offset = 0;
+						break;
 					}
-					_wake_up_writer();
 
-					return upper_len + lower_len;
+					_segments.dequeue();
+					if (seg == _tail)
+						_tail = nullptr;
+
+					_release_segment(seg);
 				}
 
-				/* _read_offset == _write_offset */
-				return 0;
+				_used -= len;
+
+				if (len)
+					_wake_up_writer();
+
+				return len;
 			}
 
 			/**
 			 * Write to pipe buffer
 			 *
-			 * \return number of written bytes (may be less than 'len')
+			 * \return number of written bytes (may be less than 'len'), 0
+			 *         if no segment could be allocated for the data
 			 */
-			size_t write(char *src, size_t len)
+			size_t write(char const *src, size_t len)
 			{
 				Lock::Guard guard(_lock);
 
@@ -164,36 +251,33 @@ namespace Noux {
 				 * Remember pipe state prior writing to see whether a reader
 				 * must be unblocked after writing.
 				 */
-				bool const pipe_was_empty = (_read_offset == _write_offset);
+				bool const pipe_was_empty = (_used == 0);
 
-				/* write data up to the upper boundary of the pipe buffer */
-				size_t const upper_len = min(BUFFER_SIZE - _write_offset, trimmed_len);
-				memcpy(&_buffer[_write_offset], src, upper_len);
+				size_t written = 0;
+				while (written < trimmed_len) {
 
-				_write_offset += upper_len;
-
-				/*
-				 * Determine number of remaining bytes beyond the buffer boundary.
-				 * The buffer wraps. So this data will end up in the lower part
-				 * of the pipe buffer.
-				 */
-				size_t const lower_len = trimmed_len - upper_len;
+					if (!_tail || _tail->full()) {
+						Segment *seg = _alloc_segment();
+						if (!seg)
+							break;
 
-				if (lower_len > 0) {
+						_segments.enqueue(seg);
+						_tail = seg;
+					}
 
-					/* pipe buffer wrap-around, write remaining data to the lower part */
-					memcpy(&_buffer[0], src + upper_len, lower_len);
-					_write_offset = lower_len;
+					written += _tail->write(src + written, trimmed_len - written);
 				}
 
+				_used += written;
+
 				/*
 				 * Wake up reader who may block for incoming data.
 				 */
-				if (pipe_was_empty || !_any_space_avail_for_writing())
+				if (written && (pipe_was_empty || !_any_space_avail_for_writing()))
 					_wake_up_reader();
 
 				/* return number of written bytes */
-				return trimmed_len;
+				return written;
 			}
 
 			void register_write_ready_sigh(Signal_context_capability sigh)
@@ -217,6 +301,20 @@ namespace Noux {
 			Shared_pointer<Pipe> _pipe;
 			Signal_receiver     &_sig_rec;
 
+			/**
+			 * Fail write that stored no data
+			 *
+			 * The write is called only if the pipe has space left. If no
+			 * byte could be stored nevertheless, the pipe is out of memory
+			 * for its segments. Failing the write prevents the caller from
+			 * retrying it forever.
+			 */
+			static bool _write_failed(Sysio *sysio)
+			{
+				sysio->error.write = Vfs::File_io_service::WRITE_ERR_IO;
+				return false;
+			}
+
 		public:
 
 			Pipe_sink_io_channel(Shared_pointer<Pipe> pipe,
@@ -251,6 +349,20 @@ namespace Noux {
 				/* dimension the pipe write operation to the not yet written data */
 				size_t curr_count = _pipe->write(sysio->write_in.chunk + offset,
 				                                 sysio->write_in.count - offset);
+				if (!curr_count)
+					return _write_failed(sysio);
+
+				offset += curr_count;
+				return true;
+			}
+
+			bool write(Sysio *sysio, char const *src, size_t count,
+			           size_t &offset) override
+			{
+				size_t const curr_count = _pipe->write(src + offset, count - offset);
+				if (!curr_count)
+					return _write_failed(sysio);
+
 				offset += curr_count;
 				return true;
 			}
@@ -331,6 +443,13 @@ namespace Noux {
 				return true;
 			}
 
+			bool read(Sysio *sysio, char *dst, size_t count,
+			          size_t &out_count) override
+			{
+				out_count = _pipe->read(dst, count);
+				return true;
+			}
+
 			bool fcntl(Sysio *sysio) override
 			{
 				switch (sysio->fcntl_in.cmd) {
@@ -11,6 +11,23 @@
  * dataspaces allocated by each Noux process. When forking a process, the
  * acquired information (in the form of 'Ram_dataspace_info' objects) is used
  * to create a shadow copy of the forking address space.
+ *
+ * Large dataspaces are shared copy-on-write between the forking process and
+ * the new process. Such a dataspace is a managed dataspace composed of
+ * chunks that are populated on demand. On fork, the chunks are detached from
+ * the forking process and referenced by both processes. A process that
+ * accesses a shared chunk afterwards faults and obtains a private copy. Core
+ * maps RAM dataspaces always writeable, which leaves no way to tell a first
+ * read from a first write. So the copy is made on the first access. Once the
+ * other process released its reference, e.g., by calling 'execve', the
+ * chunk is attached again without being copied.
+ *
+ * Faults are resolved by the signal handler of the noux main thread. Hence,
+ * noux must never access a copy-on-write dataspace via a local attachment.
+ * In particular, the read-write segments of the binary are allocated from
+ * the RAM session and populated by noux while constructing the child.
+ * Copy-on-write dataspaces are therefore handed out only once the process
+ * is up and running.
  */
 
 /*
@@ -25,20 +42,32 @@
 
 /* Genode includes */
 #include <ram_session/client.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
 #include <base/rpc_server.h>
+#include <base/signal.h>
 #include <base/env.h>
+#include <util/misc_math.h>
 
 /* Noux includes */
 #include <dataspace_registry.h>
 
 namespace Noux {
 
+	class Ram_session_component;
+
 	struct Ram_dataspace_info : Dataspace_info,
 	                            List<Ram_dataspace_info>::Element
 	{
-		Ram_dataspace_info(Ram_dataspace_capability ds_cap)
+		Ram_dataspace_info(Dataspace_capability ds_cap)
 		: Dataspace_info(ds_cap) { }
 
+		/**
+		 * Release backing store of the dataspace
+		 */
+		virtual void release() {
+			env()->ram_session()->free(static_cap_cast<Ram_dataspace>(ds_cap())); }
+
 		Dataspace_capability fork(Ram_session_capability ram,
 		                          Dataspace_registry    &,
 		                          Rpc_entrypoint        &)
@@ -97,6 +126,301 @@ namespace Noux {
 	};
 
 
+	/**
+	 * Lock protecting the copy-on-write state of all dataspaces
+	 */
+	inline Lock &cow_lock()
+	{
+		static Lock lock;
+		return lock;
+	}
+
+
+	/**
+	 * RM session used for creating the managed copy-on-write dataspaces
+	 */
+	inline Rm_connection &cow_rm()
+	{
+		static Rm_connection rm;
+		return rm;
+	}
+
+
+	inline Capability<Region_map> create_cow_region_map(size_t size)
+	{
+		for (;;) {
+			try { return cow_rm().create(size); }
+			catch (Region_map::Out_of_metadata) {
+				env()->parent()->upgrade(cow_rm().cap(), "ram_quota=8192"); }
+		}
+	}
+
+
+	/**
+	 * Memory shared by the copy-on-write dataspaces of several processes
+	 */
+	struct Cow_chunk
+	{
+		size_t                   const size;
+		Ram_dataspace_capability const ds;
+
+		/* number of dataspaces referring to the chunk */
+		unsigned refs = 1;
+
+		Cow_chunk(size_t size)
+		: size(size), ds(env()->ram_session()->alloc(size)) { }
+
+		~Cow_chunk() { env()->ram_session()->free(ds); }
+
+		/**
+		 * Create private copy of the chunk
+		 */
+		Cow_chunk *copy()
+		{
+			Cow_chunk *dst = new (env()->heap()) Cow_chunk(size);
+
+			void *src_local = env()->rm_session()->attach(ds);
+			void *dst_local = env()->rm_session()->attach(dst->ds);
+
+			memcpy(dst_local, src_local, size);
+
+			env()->rm_session()->detach(src_local);
+			env()->rm_session()->detach(dst_local);
+
+			return dst;
+		}
+	};
+
+
+	class Cow_dataspace_info : public Ram_dataspace_info
+	{
+		public:
+
+			enum {
+				CHUNK_SIZE = 64*1024,
+
+				/* smaller dataspaces are copied eagerly on fork */
+				MIN_SIZE = 2*CHUNK_SIZE
+			};
+
+		private:
+
+			struct Slot
+			{
+				Cow_chunk *chunk;
+				bool       attached;
+			};
+
+			Capability<Region_map> const _rm_cap;
+			Region_map_client            _rm;
+
+			size_t const _num_slots;
+			Slot * const _slots;
+
+			Signal_dispatcher<Cow_dataspace_info> _fault_dispatcher;
+
+			Slot *_alloc_slots()
+			{
+				Slot *slots = (Slot *)env()->heap()->alloc(_num_slots*sizeof(Slot));
+				for (size_t i = 0; i < _num_slots; i++)
+					slots[i] = Slot { nullptr, false };
+				return slots;
+			}
+
+			size_t _chunk_size(size_t i) const {
+				return min((size_t)CHUNK_SIZE, size() - i*CHUNK_SIZE); }
+
+			/**
+			 * Return chunk of slot, which is referenced by no other dataspace
+			 *
+			 * The caller must hold the 'cow_lock'.
+			 */
+			Cow_chunk &_private_chunk(size_t i)
+			{
+				Slot &slot = _slots[i];
+
+				/* populate chunk on first access */
+				if (!slot.chunk) {
+					slot.chunk = new (env()->heap()) Cow_chunk(_chunk_size(i));
+					return *slot.chunk;
+				}
+
+				if (slot.chunk->refs > 1) {
+					Cow_chunk *copy = slot.chunk->copy();
+					slot.chunk->refs--;
+					slot.chunk = copy;
+				}
+				return *slot.chunk;
+			}
+
+			void _attach(size_t i)
+			{
+				for (;;) {
+					try {
+						_rm.attach_at(_slots[i].chunk->ds, i*CHUNK_SIZE);
+						break;
+					} catch (Region_map::Out_of_metadata) {
+						env()->parent()->upgrade(cow_rm().cap(), "ram_quota=8192");
+					}
+				}
+				_slots[i].attached = true;
+			}
+
+			void _detach(size_t i)
+			{
+				_rm.detach(i*CHUNK_SIZE);
+				_slots[i].attached = false;
+			}
+
+			static void _release(Cow_chunk *chunk)
+			{
+				if (chunk && --chunk->refs == 0)
+					destroy(env()->heap(), chunk);
+			}
+
+			/**
+			 * Resolve faults of the process at the managed dataspace
+			 */
+			void _handle_fault(unsigned)
+			{
+				Lock::Guard guard(cow_lock());
+
+				for (;;) {
+					Region_map::State const state = _rm.state();
+					if (state.type == Region_map::State::READY)
+						return;
+
+					size_t const i = state.addr / CHUNK_SIZE;
+					if (i >= _num_slots || _slots[i].attached) {
+						PERR("unresolvable fault at copy-on-write dataspace, offset 0x%lx",
+						     state.addr);
+						return;
+					}
+
+					try {
+						_private_chunk(i);
+						_attach(i);
+					} catch (...) {
+						PERR("out of memory while resolving copy-on-write fault");
+						return;
+					}
+				}
+			}
+
+		public:
+
+			/**
+			 * Constructor
+			 *
+			 * \param rm       region map of the managed dataspace, created
+			 *                 via 'create_cow_region_map'
+			 * \param sig_rec  receiver of the fault signals
+			 */
+			Cow_dataspace_info(Capability<Region_map> rm, Signal_receiver &sig_rec)
+			:
+				Ram_dataspace_info(Region_map_client(rm).dataspace()),
+				_rm_cap(rm), _rm(rm),
+				_num_slots((size() + CHUNK_SIZE - 1) / CHUNK_SIZE),
+				_slots(_alloc_slots()),
+				_fault_dispatcher(sig_rec, *this, &Cow_dataspace_info::_handle_fault)
+			{
+				_rm.fault_handler(_fault_dispatcher);
+			}
+
+			~Cow_dataspace_info()
+			{
+				{
+					Lock::Guard guard(cow_lock());
+
+					for (size_t i = 0; i < _num_slots; i++)
+						_release(_slots[i].chunk);
+				}
+
+				env()->heap()->free(_slots, _num_slots*sizeof(Slot));
+			}
+
+			/**
+			 * Share all chunks of the 'src' dataspace
+			 *
+			 * The chunks are detached from 'src' such that the next access
+			 * of either process faults and creates a private copy.
+			 */
+			void share(Cow_dataspace_info &src)
+			{
+				Lock::Guard guard(cow_lock());
+
+				for (size_t i = 0; i < min(_num_slots, src._num_slots); i++) {
+
+					Slot &src_slot = src._slots[i];
+					if (!src_slot.chunk)
+						continue;
+
+					if (src_slot.attached)
+						src._detach(i);
+
+					src_slot.chunk->refs++;
+					_slots[i].chunk = src_slot.chunk;
+				}
+			}
+
+			/**
+			 * Return true if managed dataspaces are supported by the platform
+			 */
+			static bool supported()
+			{
+				static bool const result = [] () {
+					try {
+						Capability<Region_map> rm = cow_rm().create(CHUNK_SIZE);
+						bool const valid = Region_map_client(rm).dataspace().valid();
+						cow_rm().destroy(rm);
+						return valid;
+					} catch (...) { return false; }
+				} ();
+
+				return result;
+			}
+
+			void release() override { cow_rm().destroy(_rm_cap); }
+
+			inline Dataspace_capability fork(Ram_session_capability ram,
+			                                 Dataspace_registry    &ds_registry,
+			                                 Rpc_entrypoint        &ep) override;
+
+			void poke(addr_t dst_offset, void const *src, size_t len) override
+			{
+				if ((dst_offset >= size()) || (dst_offset + len > size())) {
+					PERR("illegal attemt to write beyond dataspace boundary");
+					return;
+				}
+
+				Lock::Guard guard(cow_lock());
+
+				while (len) {
+
+					size_t const i      = dst_offset / CHUNK_SIZE;
+					size_t const offset = dst_offset % CHUNK_SIZE;
+					size_t const n      = min(len, _chunk_size(i) - offset);
+
+					try {
+						Cow_chunk &chunk = _private_chunk(i);
+
+						char *dst = env()->rm_session()->attach(chunk.ds);
+						memcpy(dst + offset, src, n);
+						env()->rm_session()->detach(dst);
+
+					} catch (...) {
+						PERR("poke: failed to access copy-on-write chunk");
+						return;
+					}
+
+					src         = (char const *)src + n;
+					dst_offset += n;
+					len        -= n;
+				}
+			}
+	};
+
+
 	class Ram_session_component : public Rpc_object<Ram_session>
 	{
 		private:
@@ -112,13 +436,28 @@ namespace Noux {
 
 			Dataspace_registry &_registry;
 
+			/* receiver of the faults at copy-on-write dataspaces */
+			Signal_receiver &_sig_rec;
+
+			/* hand out copy-on-write dataspaces for large allocations */
+			bool _cow_enabled = false;
+
+			void _insert(Ram_dataspace_info *ds_info)
+			{
+				_used_quota += ds_info->size();
+
+				_registry.insert(ds_info);
+				_list.insert(ds_info);
+			}
+
 		public:
 
 			/**
 			 * Constructor
 			 */
-			Ram_session_component(Dataspace_registry &registry)
-			: _used_quota(0), _registry(registry) { }
+			Ram_session_component(Dataspace_registry &registry,
+			                      Signal_receiver &sig_rec)
+			: _used_quota(0), _registry(registry), _sig_rec(sig_rec) { }
 
 			/**
 			 * Destructor
@@ -131,24 +470,53 @@ namespace Noux {
 			}
 
 
+			/**
+			 * Enable copy-on-write dataspaces for subsequent allocations
+			 *
+			 * Must not be called before noux finished populating the
+			 * dataspaces of the process.
+			 */
+			void enable_copy_on_write() { _cow_enabled = true; }
+
+
 			/***************************
 			 ** Ram_session interface **
 			 ***************************/
 
+			/**
+			 * Create copy-on-write copy of a dataspace of the forking process
+			 */
+			Dataspace_capability fork(Cow_dataspace_info &src)
+			{
+				Cow_dataspace_info *ds_info = new (env()->heap())
+					Cow_dataspace_info(create_cow_region_map(src.size()), _sig_rec);
+
+				ds_info->share(src);
+				_insert(ds_info);
+
+				return ds_info->ds_cap();
+			}
+
 			Ram_dataspace_capability alloc(size_t size, Cache_attribute cached)
 			{
-				Ram_dataspace_capability ds_cap =
-					env()->ram_session()->alloc(size, cached);
+				Ram_dataspace_info *ds_info = nullptr;
 
-				Ram_dataspace_info *ds_info = new (env()->heap())
-				                              Ram_dataspace_info(ds_cap);
+				if (_cow_enabled && size >= Cow_dataspace_info::MIN_SIZE
+				 && cached == CACHED
+				 && Cow_dataspace_info::supported()) {
 
-				_used_quota += ds_info->size();
+					size = align_addr(size, 12);
+					ds_info = new (env()->heap())
+						Cow_dataspace_info(create_cow_region_map(size), _sig_rec);
 
-				_registry.insert(ds_info);
-				_list.insert(ds_info);
+				} else {
+					ds_info = new (env()->heap())
+						Ram_dataspace_info(env()->ram_session()->alloc(size, cached));
+				}
 
-				return ds_cap;
+				_insert(ds_info);
+
+				return static_cap_cast<Ram_dataspace>(ds_info->ds_cap());
 			}
 
 			void free(Ram_dataspace_capability ds_cap)
@@ -170,7 +538,7 @@ namespace Noux {
 					_list.remove(ds_info);
 					_used_quota -= ds_info->size();
 
-					env()->ram_session()->free(ds_cap);
+					ds_info->release();
 				};
 				_registry.apply(ds_cap, lambda);
 				destroy(env()->heap(), ds_info);
@@ -183,4 +551,16 @@ namespace Noux {
 	};
 }
 
+
+Noux::Dataspace_capability
+Noux::Cow_dataspace_info::fork(Ram_session_capability ram,
+                               Dataspace_registry &, Rpc_entrypoint &ep)
+{
+	/* look up the RAM session of the new process, served by 'ep' */
+	return ep.apply(ram, [&] (Ram_session_component *dst) -> Dataspace_capability {
+		try { return dst ? dst->fork(*this) : Dataspace_capability(); }
+		catch (...) { return Dataspace_capability(); }
+	});
+}
+
 #endif /* _NOUX__RAM_SESSION_COMPONENT_H_ */
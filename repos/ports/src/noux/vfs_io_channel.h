@@ -79,6 +79,38 @@ namespace Noux {
 			return true;
 		}
 
+		bool read(Sysio *sysio, char *dst, size_t count,
+		          size_t &out_count) override
+		{
+			Vfs::file_size n = 0;
+
+			sysio->error.read = _fh->fs().read(_fh, dst, count, n);
+
+			if (sysio->error.read != Vfs::File_io_service::READ_OK)
+				return false;
+
+			_fh->advance_seek(n);
+			out_count = n;
+
+			return true;
+		}
+
+		bool write(Sysio *sysio, char const *src, size_t count,
+		           size_t &offset) override
+		{
+			Vfs::file_size n = 0;
+
+			sysio->error.write = _fh->fs().write(_fh, src + offset,
+			                                     count - offset, n);
+			if (sysio->error.write != Vfs::File_io_service::WRITE_OK)
+				return false;
+
+			_fh->advance_seek(n);
+			offset += n;
+
+			return true;
+		}
+
 		bool fstat(Sysio *sysio) override
 		{
 			/*
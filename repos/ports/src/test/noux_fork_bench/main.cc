@@ -0,0 +1,145 @@
+/*
+ * \brief  Noux fork/execve microbenchmark
+ * \author Genode Labs
+ * \date   2016-07-08
+ *
+ * The benchmark populates the heap of the process and measures the time
+ * of fork followed by an immediate exit of the child, and of fork followed
+ * by execve, which is the common pattern of shells and build tools.
+ *
+ * Before the measurement, a forked child checks that it sees the heap
+ * content of its parent and modifies the heap afterwards, which must not
+ * become visible to the parent.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+enum { ITERATIONS = 50, HEAP_SIZE = 32*1024*1024 };
+
+static char const *binary = "/test-noux_fork_bench";
+
+
+static unsigned long elapsed_ms(struct timeval const &start)
+{
+	struct timeval now;
+	gettimeofday(&now, 0);
+	return (now.tv_sec - start.tv_sec)*1000
+	     + (now.tv_usec - start.tv_usec)/1000;
+}
+
+
+static bool heap_intact(char const *heap, char value)
+{
+	for (unsigned i = 0; i < HEAP_SIZE; i++)
+		if (heap[i] != value) {
+			printf("Error: heap corrupted at offset %u\n", i);
+			return false;
+		}
+	return true;
+}
+
+
+/**
+ * Check the heap as seen by a forked child
+ */
+static bool check_child_view(char *heap)
+{
+	pid_t const pid = fork();
+	if (pid < 0) {
+		printf("Error: fork failed\n");
+		return false;
+	}
+
+	if (pid == 0) {
+		if (!heap_intact(heap, 0x55))
+			_exit(1);
+
+		/* private copy of the child, must not affect the parent */
+		memset(heap, 0xaa, HEAP_SIZE);
+		_exit(heap_intact(heap, (char)0xaa) ? 0 : 1);
+	}
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		printf("Error: child saw unexpected heap content\n");
+		return false;
+	}
+
+	printf("heap content of forked child is correct\n");
+	return heap_intact(heap, 0x55);
+}
+
+
+static bool run(char const *name, bool exec)
+{
+	struct timeval start;
+	gettimeofday(&start, 0);
+
+	for (unsigned i = 0; i < ITERATIONS; i++) {
+
+		pid_t const pid = fork();
+		if (pid < 0) {
+			printf("Error: fork failed\n");
+			return false;
+		}
+
+		if (pid == 0) {
+			if (exec)
+				execl(binary, binary, "--exit", (char *)0);
+			_exit(0);
+		}
+
+		int status = 0;
+		waitpid(pid, &status, 0);
+	}
+
+	unsigned long const ms = elapsed_ms(start);
+	printf("%s: %u iterations in %lu ms, %lu us per iteration\n",
+	       name, (unsigned)ITERATIONS, ms, ms*1000/ITERATIONS);
+	return true;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* started via execve by the benchmark */
+	if (argc > 1 && strcmp(argv[1], "--exit") == 0)
+		return 0;
+
+	printf("--- noux fork benchmark started ---\n");
+
+	/* populate heap that must be preserved in the forked process */
+	char *heap = (char *)malloc(HEAP_SIZE);
+	if (!heap) {
+		printf("Error: could not allocate heap\n");
+		return -1;
+	}
+	memset(heap, 0x55, HEAP_SIZE);
+	printf("heap of %u MiB populated\n", (unsigned)(HEAP_SIZE >> 20));
+
+	if (!check_child_view(heap))
+		return -1;
+
+	if (!run("fork+exit", false) || !run("fork+execve", true))
+		return -1;
+
+	/* the heap content must not be affected by the children */
+	if (!heap_intact(heap, 0x55))
+		return -1;
+
+	printf("--- noux fork benchmark finished ---\n");
+	return 0;
+}
@@ -0,0 +1,201 @@
+/*
+ * \brief  Noux read/write throughput benchmark
+ * \author Genode Labs
+ * \date   2016-07-11
+ *
+ * The benchmark transfers data through a file of a RAM file system and
+ * through a pipe between two processes. Each transfer is performed with
+ * small blocks, which are passed through the sysio page, and with large
+ * blocks, which are passed through the process' I/O buffer.
+ *
+ * When started with the argument "pipe", only the pipe throughput is
+ * measured for a range of block sizes.
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+enum {
+	TOTAL_SIZE       = 64*1024*1024,
+	SMALL_BLOCK_SIZE = 8*1024,
+	LARGE_BLOCK_SIZE = 1024*1024,
+};
+
+static char const *file_name = "/tmp/noux_io_bench";
+
+
+static unsigned long elapsed_us(struct timeval const &start)
+{
+	struct timeval now;
+	gettimeofday(&now, 0);
+	return (now.tv_sec - start.tv_sec)*1000000
+	     + (now.tv_usec - start.tv_usec);
+}
+
+
+static void print_result(char const *name, size_t block_size,
+                         struct timeval const &start)
+{
+	unsigned long const us = elapsed_us(start);
+	printf("%-6s %7u bytes/block: %lu ms, %lu MB/s\n", name,
+	       (unsigned)block_size, us/1000,
+	       us ? (unsigned long)((unsigned long long)TOTAL_SIZE/us) : 0);
+}
+
+
+/**
+ * Write or read 'TOTAL_SIZE' bytes in blocks of 'block_size'
+ */
+static bool transfer(int fd, char *buf, size_t block_size, bool write_data)
+{
+	for (size_t done = 0; done < TOTAL_SIZE; ) {
+
+		ssize_t const n = write_data ? write(fd, buf, block_size)
+		                             : read(fd, buf, block_size);
+		if (n <= 0) {
+			printf("Error: %s returned %zd\n", write_data ? "write" : "read", n);
+			return false;
+		}
+		done += n;
+	}
+	return true;
+}
+
+
+static bool bench_file(char *buf, size_t block_size)
+{
+	struct timeval start;
+
+	int fd = open(file_name, O_CREAT | O_TRUNC | O_WRONLY, 0644);
+	if (fd < 0) {
+		printf("Error: could not create %s\n", file_name);
+		return false;
+	}
+
+	gettimeofday(&start, 0);
+	bool ok = transfer(fd, buf, block_size, true);
+	close(fd);
+	if (!ok)
+		return false;
+	print_result("write", block_size, start);
+
+	fd = open(file_name, O_RDONLY);
+	if (fd < 0) {
+		printf("Error: could not open %s\n", file_name);
+		return false;
+	}
+
+	gettimeofday(&start, 0);
+	ok = transfer(fd, buf, block_size, false);
+	close(fd);
+	unlink(file_name);
+	if (!ok)
+		return false;
+	print_result("read", block_size, start);
+
+	/* the last block must have survived the round trip */
+	for (size_t i = 0; i < block_size; i++)
+		if (buf[i] != (char)(i & 0xff)) {
+			printf("Error: data mismatch at offset %zu\n", i);
+			return false;
+		}
+
+	return true;
+}
+
+
+static bool bench_pipe(char *buf, size_t block_size)
+{
+	int fds[2];
+	if (pipe(fds) != 0) {
+		printf("Error: could not create pipe\n");
+		return false;
+	}
+
+	struct timeval start;
+	gettimeofday(&start, 0);
+
+	pid_t const pid = fork();
+	if (pid < 0) {
+		printf("Error: fork failed\n");
+		return false;
+	}
+
+	/* the child produces the data */
+	if (pid == 0) {
+		close(fds[0]);
+		bool const ok = transfer(fds[1], buf, block_size, true);
+		close(fds[1]);
+		_exit(ok ? 0 : 1);
+	}
+
+	close(fds[1]);
+	bool const ok = transfer(fds[0], buf, block_size, false);
+	close(fds[0]);
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+
+	if (!ok || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		return false;
+
+	print_result("pipe", block_size, start);
+	return true;
+}
+
+
+static bool bench_pipe_only(char *buf)
+{
+	size_t const block_sizes[] = { 512, 4*1024, 64*1024, 256*1024,
+	                               LARGE_BLOCK_SIZE };
+
+	for (size_t block_size : block_sizes)
+		if (!bench_pipe(buf, block_size))
+			return false;
+
+	return true;
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- noux I/O benchmark started ---\n");
+
+	char *buf = (char *)malloc(LARGE_BLOCK_SIZE);
+	if (!buf) {
+		printf("Error: could not allocate buffer\n");
+		return -1;
+	}
+
+	for (size_t i = 0; i < LARGE_BLOCK_SIZE; i++)
+		buf[i] = i & 0xff;
+
+	if (argc > 1 && strcmp(argv[1], "pipe") == 0) {
+		if (!bench_pipe_only(buf))
+			return -1;
+
+		printf("--- noux I/O benchmark finished ---\n");
+		return 0;
+	}
+
+	size_t const block_sizes[] = { SMALL_BLOCK_SIZE, LARGE_BLOCK_SIZE };
+
+	for (size_t block_size : block_sizes)
+		if (!bench_file(buf, block_size) || !bench_pipe(buf, block_size))
+			return -1;
+
+	printf("--- noux I/O benchmark finished ---\n");
+	return 0;
+}
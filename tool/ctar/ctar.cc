@@ -0,0 +1,210 @@
+/*
+ * \brief  Host tool for creating block-compressed archives
+ * \author Genode Labs
+ * \date   2016-06-20
+ *
+ * The tool converts an arbitrary file (usually a TAR archive) into the
+ * seekable compressed format understood by 'tar_rom' and the VFS 'tar' file
+ * system (see 'os/include/os/compressed_archive.h'). Each block is compressed
+ * independently using the LZ4 block format. Blocks that do not shrink are
+ * stored uncompressed.
+ *
+ * Usage: ctar [-b <block size>] <input file> <output file>
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+
+/* must match 'Genode::Compressed_archive' */
+struct Header
+{
+	char     magic[8];
+	uint32_t block_size;
+	uint32_t block_count;
+	uint64_t size;
+} __attribute__((packed));
+
+struct Index_entry
+{
+	enum { FLAG_STORED = 1 };
+
+	uint64_t offset;
+	uint32_t length;
+	uint32_t flags;
+} __attribute__((packed));
+
+
+/**
+ * Greedy LZ4 block compressor using a single-entry hash table
+ *
+ * \return  size of compressed block, or 0 if the block does not shrink
+ */
+static size_t lz4_compress(uint8_t const *src, size_t len, uint8_t *dst, size_t dst_len)
+{
+	enum { HASH_BITS = 16, MIN_MATCH = 4, LAST_LITERALS = 5, MF_LIMIT = 12,
+	       MAX_OFFSET = 65535 };
+
+	std::vector<uint32_t> table(1 << HASH_BITS, 0xffffffff);
+
+	uint8_t *op = dst, *op_end = dst + dst_len;
+
+	auto hash = [&] (size_t pos) {
+		uint32_t v; memcpy(&v, src + pos, 4);
+		return (v*2654435761u) >> (32 - HASH_BITS);
+	};
+
+	auto write_length = [&] (size_t len) {
+		for (; len >= 255; len -= 255) {
+			if (op >= op_end) return false;
+			*op++ = 255;
+		}
+		if (op >= op_end) return false;
+		*op++ = (uint8_t)len;
+		return true;
+	};
+
+	auto emit = [&] (size_t lit_start, size_t lit_len, size_t offset, size_t match_len) {
+
+		if (op >= op_end) return false;
+
+		uint8_t *token = op++;
+		*token = (uint8_t)((lit_len >= 15 ? 15 : lit_len) << 4);
+		if (lit_len >= 15 && !write_length(lit_len - 15)) return false;
+
+		if ((size_t)(op_end - op) < lit_len) return false;
+		memcpy(op, src + lit_start, lit_len);
+		op += lit_len;
+
+		if (!match_len) return true;
+
+		if (op_end - op < 2) return false;
+		*op++ = offset & 0xff;
+		*op++ = offset >> 8;
+
+		size_t const ml = match_len - MIN_MATCH;
+		*token |= (ml >= 15 ? 15 : ml);
+		return ml < 15 || write_length(ml - 15);
+	};
+
+	size_t anchor = 0, pos = 0;
+
+	if (len > MF_LIMIT) {
+		size_t const match_limit = len - LAST_LITERALS;
+
+		while (pos + MF_LIMIT < len) {
+
+			uint32_t const h = hash(pos);
+			size_t   const ref = table[h];
+			table[h] = (uint32_t)pos;
+
+			if (ref == 0xffffffff || pos - ref > MAX_OFFSET
+			 || memcmp(src + ref, src + pos, MIN_MATCH) != 0) {
+				pos++;
+				continue;
+			}
+
+			size_t match_len = MIN_MATCH;
+			while (pos + match_len < match_limit
+			    && src[ref + match_len] == src[pos + match_len])
+				match_len++;
+
+			if (!emit(anchor, pos - anchor, pos - ref, match_len))
+				return 0;
+
+			pos   += match_len;
+			anchor = pos;
+		}
+	}
+
+	if (!emit(anchor, len - anchor, 0, 0))
+		return 0;
+
+	size_t const result = op - dst;
+	return result < len ? result : 0;
+}
+
+
+int main(int argc, char **argv)
+{
+	size_t block_size = 64*1024;
+
+	int arg = 1;
+	if (argc > 2 && strcmp(argv[1], "-b") == 0) {
+		block_size = strtoul(argv[2], 0, 0);
+		arg = 3;
+	}
+
+	if (argc - arg != 2 || block_size == 0) {
+		fprintf(stderr, "usage: %s [-b <block size>] <input> <output>\n", argv[0]);
+		return 1;
+	}
+
+	FILE *in = fopen(argv[arg], "rb");
+	if (!in) { perror(argv[arg]); return 1; }
+
+	std::vector<uint8_t> content;
+	{
+		uint8_t buf[64*1024];
+		size_t n;
+		while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+			content.insert(content.end(), buf, buf + n);
+		fclose(in);
+	}
+
+	uint32_t const block_count = (content.size() + block_size - 1) / block_size;
+
+	Header header;
+	memcpy(header.magic, "GCTAR001", sizeof(header.magic));
+	header.block_size  = block_size;
+	header.block_count = block_count;
+	header.size        = content.size();
+
+	std::vector<Index_entry> index(block_count);
+	std::vector<uint8_t>     data;
+	std::vector<uint8_t>     buf(block_size);
+
+	uint64_t offset = sizeof(Header) + block_count*sizeof(Index_entry);
+
+	for (uint32_t i = 0; i < block_count; i++) {
+
+		uint8_t const *src = content.data() + (size_t)i*block_size;
+		size_t const   len = std::min(block_size, content.size() - (size_t)i*block_size);
+
+		size_t const compressed = lz4_compress(src, len, buf.data(), buf.size());
+
+		index[i].offset = offset + data.size();
+		index[i].length = compressed ? compressed : len;
+		index[i].flags  = compressed ? 0 : Index_entry::FLAG_STORED;
+
+		if (compressed)
+			data.insert(data.end(), buf.data(), buf.data() + compressed);
+		else
+			data.insert(data.end(), src, src + len);
+	}
+
+	FILE *out = fopen(argv[arg + 1], "wb");
+	if (!out) { perror(argv[arg + 1]); return 1; }
+
+	bool const ok = fwrite(&header, sizeof(header), 1, out) == 1
+	             && (!block_count || fwrite(index.data(), sizeof(Index_entry), block_count, out) == block_count)
+	             && fwrite(data.data(), 1, data.size(), out) == data.size();
+
+	if (fclose(out) != 0 || !ok) {
+		perror(argv[arg + 1]);
+		return 1;
+	}
+
+	printf("%s: %zu -> %llu bytes in %u blocks\n", argv[arg + 1], content.size(),
+	       (unsigned long long)(offset + data.size()), block_count);
+	return 0;
+}
@@ -0,0 +1,486 @@
+/*
+ * \brief  Host tool for symbolizing execution samples
+ * \author Genode Labs
+ * \date   2016-07-18
+ *
+ * The tool reads the sample file written by the 'trace_export' component
+ * (see 'os/src/app/trace_export/sample_file.h'), resolves the sampled
+ * addresses to function names using the ELF symbol tables of the
+ * unstripped binaries, and prints a flat profile or the folded call
+ * stacks understood by 'flamegraph.pl'.
+ *
+ * The binary of a thread is looked up by the last element of its session
+ * label in the binary directories, e.g., 'test-timer' for the label
+ * "init -> test-timer". Shared libraries are found via the link maps that
+ * the dynamic linker prints to the log when configured with
+ * 'ld_verbose="yes"'.
+ *
+ * Usage: trace_profile [-b <bin dir>]... [-l <log file>] [-f flat|folded]
+ *                      <sample file>
+ */
+
+/*
+ * Copyright (C) 2016 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cxxabi.h>
+#include <elf.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* must match 'Trace_export::Sample_file' */
+enum Record_type { THREAD = 1, SAMPLE = 2, LOST = 3 };
+
+
+static bool read_file(std::string const &path, std::vector<uint8_t> &content)
+{
+	FILE *f = fopen(path.c_str(), "rb");
+	if (!f) return false;
+
+	uint8_t buf[64*1024];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+		content.insert(content.end(), buf, buf + n);
+	fclose(f);
+	return true;
+}
+
+
+static std::string demangle(char const *name)
+{
+	int status = 0;
+	char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+	if (status != 0 || !demangled)
+		return name;
+
+	std::string result(demangled);
+	free(demangled);
+	return result;
+}
+
+
+/**
+ * Function symbols of an ELF file
+ */
+struct Elf_symbols
+{
+	struct Symbol
+	{
+		uint64_t    addr;
+		uint64_t    size;
+		std::string name;
+
+		bool operator < (Symbol const &other) const { return addr < other.addr; }
+	};
+
+	std::string         name;
+	bool                relocatable = false;  /* shared object */
+	std::vector<Symbol> symbols;
+
+	template <typename EHDR, typename SHDR, typename SYM>
+	void _load(std::vector<uint8_t> const &elf)
+	{
+		auto valid = [&] (uint64_t offset, uint64_t size) {
+			return offset <= elf.size() && size <= elf.size() - offset; };
+
+		EHDR const &ehdr = *(EHDR const *)elf.data();
+		relocatable = ehdr.e_type == ET_DYN;
+
+		if (!valid(ehdr.e_shoff, (uint64_t)ehdr.e_shnum*sizeof(SHDR)))
+			return;
+
+		SHDR const *shdr = (SHDR const *)(elf.data() + ehdr.e_shoff);
+
+		/* prefer the full symbol table, fall back to the dynamic symbols */
+		for (uint32_t type : { SHT_SYMTAB, SHT_DYNSYM }) {
+			for (unsigned i = 0; i < ehdr.e_shnum; i++) {
+
+				if (shdr[i].sh_type != type || shdr[i].sh_link >= ehdr.e_shnum)
+					continue;
+
+				SHDR const &strtab = shdr[shdr[i].sh_link];
+				if (!valid(shdr[i].sh_offset, shdr[i].sh_size)
+				 || !valid(strtab.sh_offset, strtab.sh_size))
+					continue;
+
+				SYM const *sym = (SYM const *)(elf.data() + shdr[i].sh_offset);
+				size_t const num = shdr[i].sh_size/sizeof(SYM);
+				char const *str = (char const *)elf.data() + strtab.sh_offset;
+
+				for (size_t j = 0; j < num; j++) {
+					unsigned const sym_type = sym[j].st_info & 0xf;
+					if ((sym_type != STT_FUNC && sym_type != STT_NOTYPE)
+					 || !sym[j].st_value || sym[j].st_name >= strtab.sh_size
+					 || sym[j].st_shndx == SHN_UNDEF)
+						continue;
+
+					/* skip local labels and ARM mapping symbols */
+					char const *sym_name = str + sym[j].st_name;
+					if (!*sym_name || *sym_name == '$' || *sym_name == '.')
+						continue;
+
+					symbols.push_back({ sym[j].st_value & ~1ULL, sym[j].st_size,
+					                    sym_name });
+				}
+			}
+			if (!symbols.empty())
+				break;
+		}
+		std::sort(symbols.begin(), symbols.end());
+	}
+
+	bool load(std::string const &path)
+	{
+		std::vector<uint8_t> elf;
+		if (!read_file(path, elf) || elf.size() < EI_NIDENT
+		 || memcmp(elf.data(), ELFMAG, SELFMAG) != 0)
+			return false;
+
+		if (elf[EI_CLASS] == ELFCLASS64 && elf.size() >= sizeof(Elf64_Ehdr))
+			_load<Elf64_Ehdr, Elf64_Shdr, Elf64_Sym>(elf);
+		else if (elf[EI_CLASS] == ELFCLASS32 && elf.size() >= sizeof(Elf32_Ehdr))
+			_load<Elf32_Ehdr, Elf32_Shdr, Elf32_Sym>(elf);
+		else
+			return false;
+
+		return true;
+	}
+
+	/**
+	 * Return symbol containing the address, or nullptr
+	 */
+	Symbol const *lookup(uint64_t addr) const
+	{
+		auto it = std::upper_bound(symbols.begin(), symbols.end(),
+		                           Symbol { addr, 0, "" });
+		if (it == symbols.begin())
+			return nullptr;
+
+		Symbol const &sym = *--it;
+
+		/* symbols without size extend to the next symbol */
+		if (sym.size && addr >= sym.addr + sym.size)
+			return nullptr;
+
+		return &sym;
+	}
+};
+
+
+/**
+ * Shared object loaded into a component as reported by the dynamic linker
+ */
+struct Mapping
+{
+	uint64_t    start, end;
+	std::string name;
+};
+
+
+struct Thread
+{
+	std::string label;
+	std::string name;
+};
+
+
+struct Profile
+{
+	std::vector<std::string> bin_dirs;
+
+	std::map<std::string, std::unique_ptr<Elf_symbols>> elf_files;
+	std::map<std::string, std::vector<Mapping>>         link_maps;  /* by label */
+	std::map<uint32_t, Thread>                          threads;    /* by tid   */
+
+	/* folded stack -> count */
+	std::map<std::string, unsigned long> stacks;
+
+	/* function -> self and total count */
+	struct Count { unsigned long self = 0, total = 0; };
+	std::map<std::string, Count> functions;
+
+	unsigned long num_samples = 0;
+	unsigned long num_lost    = 0;
+
+	Elf_symbols const *elf(std::string const &name)
+	{
+		auto it = elf_files.find(name);
+		if (it != elf_files.end())
+			return it->second.get();
+
+		std::unique_ptr<Elf_symbols> symbols(new Elf_symbols);
+		symbols->name = name;
+
+		bool found = false;
+		for (std::string const &dir : bin_dirs)
+			if ((found = symbols->load(dir + "/" + name)))
+				break;
+
+		if (!found)
+			fprintf(stderr, "warning: no symbols for '%s'\n", name.c_str());
+
+		Elf_symbols const *result = found ? symbols.get() : nullptr;
+		elf_files[name] = found ? std::move(symbols) : nullptr;
+		return result;
+	}
+
+	/**
+	 * Parse link maps of the dynamic linker from log output
+	 *
+	 * The relevant lines look like "[init -> app]   1000000 .. 10fffff: libc.lib.so".
+	 */
+	void parse_log(char const *path)
+	{
+		FILE *f = fopen(path, "r");
+		if (!f) { perror(path); exit(1); }
+
+		char line[1024];
+		while (fgets(line, sizeof(line), f)) {
+
+			/* strip escape sequences used for colored output */
+			std::string clean;
+			for (char const *s = line; *s; s++) {
+				if (*s == '\033') {
+					while (*s && *s != 'm') s++;
+					if (!*s) break;
+					continue;
+				}
+				clean += *s;
+			}
+
+			size_t const label_start = clean.find('[');
+			size_t const label_end   = clean.find("] ");
+			if (label_start == std::string::npos || label_end == std::string::npos
+			 || label_end < label_start)
+				continue;
+
+			unsigned long long start = 0, end = 0;
+			char name[256];
+			if (sscanf(clean.c_str() + label_end + 2, " %llx .. %llx: %255s",
+			           &start, &end, name) != 3)
+				continue;
+
+			std::string const label = clean.substr(label_start + 1,
+			                                       label_end - label_start - 1);
+			link_maps[label].push_back({ start, end, name });
+		}
+		fclose(f);
+	}
+
+	/**
+	 * Resolve address to "function [object]"
+	 */
+	std::string symbolize(std::string const &label, uint64_t addr)
+	{
+		std::string object = label.substr(label.rfind("> ") == std::string::npos
+		                                  ? 0 : label.rfind("> ") + 2);
+		uint64_t base = 0;
+
+		for (Mapping const &m : link_maps[label])
+			if (addr >= m.start && addr <= m.end) {
+				object = m.name;
+				base   = m.start;
+			}
+
+		char buf[64];
+		Elf_symbols const *symbols = elf(object);
+		if (symbols) {
+			uint64_t const elf_addr = symbols->relocatable ? addr - base : addr;
+
+			Elf_symbols::Symbol const *sym = symbols->lookup(elf_addr);
+			if (sym)
+				return demangle(sym->name.c_str()) + " [" + object + "]";
+		}
+
+		snprintf(buf, sizeof(buf), "0x%llx", (unsigned long long)addr);
+		return std::string(buf) + " [" + object + "]";
+	}
+
+	void sample(uint32_t tid, uint64_t const *ip, uint32_t depth)
+	{
+		if (!depth)
+			return;
+
+		auto it = threads.find(tid);
+		Thread const thread = it != threads.end() ? it->second
+		                                          : Thread { "unknown", "unknown" };
+		std::vector<std::string> frames;
+		for (uint32_t i = 0; i < depth; i++) {
+
+			/* return addresses point behind the call instruction */
+			uint64_t const addr = i ? ip[i] - 1 : ip[i];
+			frames.push_back(symbolize(thread.label, addr));
+		}
+
+		num_samples++;
+		functions[frames[0]].self++;
+
+		/* count recursive functions only once per sample */
+		std::vector<std::string> unique(frames);
+		std::sort(unique.begin(), unique.end());
+		unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+		for (std::string const &f : unique)
+			functions[f].total++;
+
+		std::string stack = thread.label + ";" + thread.name;
+		for (auto f = frames.rbegin(); f != frames.rend(); ++f)
+			stack += ";" + *f;
+		stacks[stack]++;
+	}
+
+	void parse_samples(char const *path)
+	{
+		std::vector<uint8_t> data;
+		if (!read_file(path, data)) { perror(path); exit(1); }
+
+		if (data.size() < 8 || memcmp(data.data(), "GSAMPLE1", 8) != 0) {
+			fprintf(stderr, "%s: not a sample file\n", path);
+			exit(1);
+		}
+
+		size_t pos = 8;
+
+		auto avail = [&] (size_t len) { return len <= data.size() - pos; };
+
+		auto u32 = [&] () {
+			uint32_t v; memcpy(&v, data.data() + pos, sizeof(v));
+			pos += sizeof(v); return v; };
+
+		auto u64 = [&] () {
+			uint64_t v; memcpy(&v, data.data() + pos, sizeof(v));
+			pos += sizeof(v); return v; };
+
+		auto str = [&] (std::string &s) {
+			if (!avail(4)) return false;
+			uint32_t const len = u32();
+			if (!avail(len)) return false;
+			s.assign((char const *)data.data() + pos, len);
+			pos += len;
+			return true;
+		};
+
+		while (avail(8)) {
+
+			uint32_t const type = u32();
+			uint32_t const tid  = u32();
+
+			bool ok = true;
+			switch (type) {
+
+			case THREAD:
+				{
+					Thread t;
+					ok = str(t.label) && str(t.name);
+					threads[tid] = t;
+					break;
+				}
+
+			case SAMPLE:
+				{
+					if (!(ok = avail(12))) break;
+					u64(); /* timestamp */
+					uint32_t const depth = u32();
+					if (!(ok = avail((size_t)depth*8))) break;
+
+					std::vector<uint64_t> ip(depth);
+					for (uint32_t i = 0; i < depth; i++)
+						ip[i] = u64();
+					sample(tid, ip.data(), depth);
+					break;
+				}
+
+			case LOST:
+				if ((ok = avail(4)))
+					num_lost += u32();
+				break;
+
+			default:
+				ok = false;
+			}
+
+			if (!ok) {
+				fprintf(stderr, "%s: truncated or corrupt record at offset %zu\n",
+				        path, pos);
+				break;
+			}
+		}
+	}
+
+	void print_flat()
+	{
+		std::vector<std::pair<std::string, Count>> sorted(functions.begin(),
+		                                                  functions.end());
+		std::sort(sorted.begin(), sorted.end(), [] (auto const &a, auto const &b) {
+			return a.second.self != b.second.self ? a.second.self > b.second.self
+			                                      : a.second.total > b.second.total; });
+
+		printf("%lu samples, %lu lost\n\n", num_samples, num_lost);
+		printf("   self       %%    total       %%  function\n");
+
+		double const n = num_samples ? num_samples : 1;
+		for (auto const &f : sorted)
+			printf("%7lu  %6.2f  %7lu  %6.2f  %s\n",
+			       f.second.self,  100.0*f.second.self/n,
+			       f.second.total, 100.0*f.second.total/n, f.first.c_str());
+	}
+
+	void print_folded()
+	{
+		for (auto const &s : stacks)
+			printf("%s %lu\n", s.first.c_str(), s.second);
+	}
+};
+
+
+int main(int argc, char **argv)
+{
+	Profile profile;
+
+	char const *log_file    = nullptr;
+	char const *sample_file = nullptr;
+	bool        folded      = false;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+			profile.bin_dirs.push_back(argv[++i]);
+		else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+			log_file = argv[++i];
+		else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+			folded = strcmp(argv[++i], "folded") == 0;
+		else if (!sample_file && argv[i][0] != '-')
+			sample_file = argv[i];
+		else
+			sample_file = nullptr, i = argc;
+	}
+
+	if (!sample_file) {
+		fprintf(stderr, "usage: %s [-b <bin dir>]... [-l <log file>] "
+		                "[-f flat|folded] <sample file>\n", argv[0]);
+		return 1;
+	}
+
+	if (profile.bin_dirs.empty())
+		profile.bin_dirs.push_back(".");
+
+	if (log_file)
+		profile.parse_log(log_file);
+
+	profile.parse_samples(sample_file);
+
+	if (folded)
+		profile.print_folded();
+	else
+		profile.print_flat();
+
+	return 0;
+}